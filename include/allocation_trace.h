@@ -0,0 +1,256 @@
+#ifndef MCR_ALLOCATION_TRACE_H_
+
+#define MCR_ALLOCATION_TRACE_H_
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace mcr
+{
+    /**
+     * @brief Kind of a recorded event.
+     */
+    enum class TraceOp : std::uint8_t
+    {
+        kAllocate = 0,
+        kFree = 1,
+    };
+
+    /**
+     * @brief One recorded `Allocate()` or `Free()` call; 16 bytes in memory and on disk.
+     */
+    struct TraceEvent
+    {
+        /**
+         * @brief Address returned by the allocation; pairs a free with its allocation.
+         */
+        std::uint64_t address;
+
+        /**
+         * @brief Requested size in bytes; saturated at `UINT32_MAX`.
+         */
+        std::uint32_t size;
+
+        /**
+         * @brief `log2` of the requested alignment.
+         */
+        std::uint8_t alignment_log2;
+
+        TraceOp op;
+
+        /**
+         * @brief Recording thread, numbered in order of first use (truncated to 16 bits).
+         */
+        std::uint16_t thread;
+    };
+
+    static_assert(sizeof(TraceEvent) == 16, "Trace events are stored as 16-byte records.");
+
+    /**
+     * @brief Bounded lock-free ring buffer that collects `TraceEvent`s from any number of threads.
+     *
+     * Producers claim a slot with one compare-and-swap and publish it with a per-slot sequence number;
+     * a single consumer drains published events in claim order.
+     *
+     * Notes:
+     *
+     * - `Record()` never blocks and never allocates; when the ring is full the event is dropped and counted.
+     *
+     * - `Drain()` must not be called from more than one thread at a time.
+     */
+    class TraceRecorder
+    {
+    public:
+        /**
+         * @brief Default ring capacity in events; 1.5 MiB of ring, since each slot holds a 16-byte event and its 8-byte sequence.
+         */
+        static constexpr std::size_t kDefaultCapacity = std::size_t{1} << 16;
+
+        /**
+         * @brief Construct the ring.
+         *
+         * @param capacity Number of events the ring holds; rounded up to a power of 2.
+         * @throws std::invalid_argument If `capacity` is zero or too large to round up.
+         * @throws std::bad_alloc If the ring cannot be allocated.
+         */
+        explicit TraceRecorder(std::size_t capacity = kDefaultCapacity);
+
+        ~TraceRecorder();
+
+        /**
+         * @brief Record one event.
+         *
+         * @return false if the ring was full and the event was dropped.
+         */
+        bool Record(TraceOp op, const void *address, std::size_t size, std::size_t alignment);
+
+        /**
+         * @brief Append every published event to `out` and free their slots.
+         *
+         * @return Number of events appended.
+         */
+        std::size_t Drain(std::vector<TraceEvent> &out);
+
+        /**
+         * @brief Number of events dropped because the ring was full.
+         */
+        std::uint64_t Dropped() const;
+
+        /**
+         * @brief Ring capacity in events.
+         */
+        std::size_t Capacity() const;
+
+        // Disable copy semantics for the owning recorder.
+        TraceRecorder(const TraceRecorder &) = delete;
+        TraceRecorder &operator=(const TraceRecorder &) = delete;
+
+    private:
+        struct Slot;
+
+        std::unique_ptr<Slot[]> slots_;
+        std::size_t mask_;
+
+        /**
+         * @brief Next position to claim; on its own cache line, away from the consumer.
+         */
+        alignas(64) std::atomic<std::uint64_t> head_;
+
+        /**
+         * @brief Next position to drain; touched by the consumer only.
+         */
+        alignas(64) std::uint64_t tail_;
+
+        std::atomic<std::uint64_t> dropped_;
+    };
+
+    /**
+     * @brief Forwards `Allocate()` and `Free()` to a manager and records every call.
+     *
+     * Works with any manager that has `Allocate(size, alignment)` and `Free(ptr, size, alignment)`.
+     * Only successful allocations are recorded. A free is recorded before the block is released, so the
+     * address cannot be handed out and recorded again by another thread ahead of it.
+     */
+    template <typename Manager>
+    class RecordingManager
+    {
+    public:
+        RecordingManager(Manager &manager, TraceRecorder &recorder) : manager_(manager), recorder_(recorder) {}
+
+        void *Allocate(std::size_t size, std::size_t alignment = sizeof(void *))
+        {
+            void *ptr = manager_.Allocate(size, alignment);
+            if (ptr)
+            {
+                recorder_.Record(TraceOp::kAllocate, ptr, size, alignment);
+            }
+            return ptr;
+        }
+
+        void Free(void *ptr, std::size_t size, std::size_t alignment)
+        {
+            if (ptr)
+            {
+                recorder_.Record(TraceOp::kFree, ptr, size, alignment);
+            }
+            manager_.Free(ptr, size, alignment);
+        }
+
+    private:
+        Manager &manager_;
+        TraceRecorder &recorder_;
+    };
+
+    /**
+     * @brief Write events to a trace file: a 24-byte header (`"MCRTRACE"`, version, record size, count)
+     *        followed by the raw records in host byte order.
+     *
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void WriteTraceFile(const std::string &path, const std::vector<TraceEvent> &events);
+
+    /**
+     * @brief Read a file written by `WriteTraceFile()`.
+     *
+     * @throws std::runtime_error If the file cannot be read or is not a trace of this version.
+     */
+    std::vector<TraceEvent> ReadTraceFile(const std::string &path);
+
+    /**
+     * @brief One step of a replay, with addresses replaced by dense slot indices.
+     */
+    struct ReplayOp
+    {
+        /**
+         * @brief Index of the live object in the replay's pointer table.
+         */
+        std::uint32_t slot;
+
+        std::uint32_t size;
+        std::uint32_t alignment;
+        TraceOp op;
+    };
+
+    /**
+     * @brief A trace prepared for replay; built once so the timed loop does no address lookups.
+     */
+    struct ReplayPlan
+    {
+        std::vector<ReplayOp> ops;
+
+        /**
+         * @brief Size of the pointer table; the peak number of live objects.
+         */
+        std::size_t slot_count = 0;
+
+        /**
+         * @brief Highest sum of requested bytes alive at once.
+         */
+        std::size_t peak_live_bytes = 0;
+    };
+
+    /**
+     * @brief Pair frees with their allocations and assign pointer-table slots.
+     *
+     * Frees of addresses that were never allocated in the trace (allocated before recording started) are dropped.
+     * An address allocated again without a free in between (the free was lost) gets a free of the older object first.
+     * Objects still alive at the end of the trace get a free appended, so every replay ends with nothing allocated.
+     */
+    ReplayPlan BuildReplayPlan(const std::vector<TraceEvent> &events);
+
+    /**
+     * @brief Run a plan once through `allocate(size, alignment)` and `release(ptr, size, alignment)`.
+     *
+     * Failed allocations (nullptr) are counted and their frees skipped.
+     *
+     * @param table Scratch pointer table; resized to `plan.slot_count` and left all null.
+     * @return Number of failed allocations.
+     */
+    template <typename AllocateFn, typename FreeFn>
+    std::size_t ReplayTrace(const ReplayPlan &plan, std::vector<void *> &table, AllocateFn allocate, FreeFn release)
+    {
+        table.assign(plan.slot_count, nullptr);
+
+        std::size_t failures = 0;
+        for (const ReplayOp &op : plan.ops)
+        {
+            if (op.op == TraceOp::kAllocate)
+            {
+                void *ptr = allocate(op.size, op.alignment);
+                failures += ptr ? 0 : 1;
+                table[op.slot] = ptr;
+            }
+            else if (table[op.slot])
+            {
+                release(table[op.slot], op.size, op.alignment);
+                table[op.slot] = nullptr;
+            }
+        }
+        return failures;
+    }
+}
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef MCR_BITMAP_SLAB_ALLOCATOR_H_
+
+#define MCR_BITMAP_SLAB_ALLOCATOR_H_
+#include "pool_memory.h"
+#include "size_class.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mcr
+{
+    /**
+     * @brief A fixed-size block allocator that tracks free blocks in out-of-band bitmaps.
+     *
+     * Same pool layout as `SlabAllocator`, but no metadata lives inside the blocks: one bit per block marks
+     * it free, and a summary bitmap marks which 64-block words still have a free block.
+     *
+     * Notes:
+     *
+     * - `Free()` writes only to the bitmap, so freeing never dirties the block's cache line or page.
+     *
+     * - `Allocate()` returns the lowest free block. A lowest-word hint and a count-trailing-zeros scan make this O(1)
+     *   when the hint word has a free bit; after a word empties, the next one is found by scanning the summary
+     *   (one bit per 64 blocks).
+     *
+     * - Address-ordered reuse keeps live blocks packed at the start of the pool, which keeps the touched page set small.
+     *
+     * - Double frees and pointers that are not blocks of this allocator are detected with a bit test and rejected.
+     *
+     * - `AllocateAligned()` serves alignments above the block size from the same pool: blocks that start on an
+     *   alignment boundary are found by masking every word with the boundary pattern, and the blocks in between stay
+     *   free for other requests.
+     *
+     * - Fixed capacity; not thread-safe; concurrent use must be synchronized by the caller.
+     */
+    class BitmapSlabAllocator
+    {
+    public:
+        /**
+         * @brief The pool is aligned to at least this many bytes; the largest alignment `AllocateAligned()` accepts.
+         */
+        static constexpr std::size_t kMaxSpanAlignment = 4096;
+
+        /**
+         * @brief Construct the allocator, its backing pool and its bitmaps with every block free.
+         *
+         * The effective alignment and block size are computed like `SlabAllocator`'s.
+         *
+         * @param block_size The requested payload size for each block.
+         * @param pool_size The requested backing pool size.
+         * @param alignment The requested alignment. Must be non-zero and a power of 2.
+         * @param backing Where the pool comes from (see `PoolBacking`).
+         * @throws std::invalid_argument If alignment is zero, not a power of 2, or if the pool cannot hold at least one effective block.
+         * @throws std::bad_alloc If the backing-pool allocation fails.
+         */
+        BitmapSlabAllocator(std::size_t block_size, std::size_t pool_size, std::size_t alignment = sizeof(void *), PoolBacking backing = PoolBacking::kHeap);
+
+        /**
+         * @brief Release the backing pool; outstanding pointers become invalid.
+         */
+        ~BitmapSlabAllocator();
+
+        /**
+         * @brief Allocate the lowest-addressed free block.
+         *
+         * @return Pointer to the block, or nullptr if every block is in use.
+         */
+        void *Allocate();
+
+        /**
+         * @brief Allocate the lowest-addressed free block that starts on an `alignment` boundary.
+         *
+         * Alignments the block size already guarantees take the `Allocate()` path. Larger ones scan the bitmap words
+         * for a free boundary block, so the cost grows with the number of words before the first fit.
+         *
+         * @param alignment The requested alignment; a power of 2 no larger than `kMaxSpanAlignment`.
+         * @return Pointer to the block, or nullptr if no free block is suitably aligned.
+         * @throws std::invalid_argument If `alignment` is zero, not a power of 2, or larger than `kMaxSpanAlignment`.
+         */
+        void *AllocateAligned(std::size_t alignment);
+
+        /**
+         * @brief Return a block to the pool by setting its free bit.
+         *
+         * Contract:
+         *
+         * - `ptr == nullptr` is allowed and is a no-op.
+         *
+         * @throws std::invalid_argument If `ptr` is not the start of a block of this allocator, or if the block is already free (double free).
+         */
+        void Free(void *ptr);
+
+        /**
+         * @brief Check whether `ptr` is the start of a block that is currently allocated.
+         */
+        bool IsAllocated(const void *ptr) const;
+
+        /**
+         * @brief Check whether `ptr` points into the backing pool.
+         */
+        bool Owns(const void *ptr) const;
+
+        /**
+         * @brief Number of blocks currently allocated.
+         */
+        std::size_t InUse() const;
+
+        /**
+         * @brief Number of blocks in the pool.
+         */
+        std::size_t Capacity() const;
+
+        // Disable copy semantics for the owning allocator.
+        BitmapSlabAllocator(const BitmapSlabAllocator &) = delete;
+        BitmapSlabAllocator &operator=(const BitmapSlabAllocator &) = delete;
+
+    private:
+        static constexpr std::size_t kWordBits = 64;
+
+        std::size_t block_size_;
+        std::size_t block_count_;
+        PoolRegion pool_;
+        std::uintptr_t base_;
+
+        /**
+         * @brief `log2(block_size_)` if the block size is a power of 2, otherwise 0 and indices are divided out.
+         */
+        unsigned block_shift_;
+
+        /**
+         * @brief Bit `i` of word `w` is set while block `w * 64 + i` is free; bits past the last block stay clear.
+         */
+        std::vector<std::uint64_t> free_bits_;
+
+        /**
+         * @brief Bit `w` is set while `free_bits_[w]` is non-zero.
+         */
+        std::vector<std::uint64_t> summary_;
+
+        /**
+         * @brief Lowest word that may hold a free bit; `free_bits_.size()` once every block is in use.
+         */
+        std::size_t first_free_word_;
+
+        std::size_t in_use_;
+
+        /**
+         * @brief Per `log2(stride)`: no word below it has a free boundary block of that stride. Only lowered by `Free()`.
+         */
+        std::array<std::size_t, FloorLog2(kMaxSpanAlignment) + 1> boundary_hints_;
+
+        /**
+         * @brief Set once `AllocateAligned()` has raised a hint, so `Free()` skips lowering them until then.
+         */
+        bool boundary_hints_used_;
+
+        /**
+         * @brief Block index of a pointer, or `block_count_` if it is not the start of a block in the pool.
+         */
+        std::size_t BlockIndex(const void *ptr) const;
+
+        /**
+         * @brief Clear the free bit of block `word * 64 + bit` and return the block.
+         */
+        void *TakeBlock(std::size_t word, unsigned bit);
+
+        /**
+         * @brief Lowest non-empty word at or after `word`, or `free_bits_.size()` if there is none.
+         */
+        std::size_t NextFreeWord(std::size_t word) const;
+    };
+}
+
+#endif
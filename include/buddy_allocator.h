@@ -0,0 +1,205 @@
+#ifndef MCR_BUDDY_ALLOCATOR_H_
+
+#define MCR_BUDDY_ALLOCATOR_H_
+#include "pool_memory.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mcr
+{
+    /**
+     * @brief Usage counters of a `BuddyAllocator`.
+     */
+    struct BuddyStats
+    {
+        /**
+         * @brief Size of the managed region in bytes.
+         */
+        std::size_t region_size = 0;
+
+        /**
+         * @brief Bytes currently handed out, counted in whole buddy blocks.
+         */
+        std::size_t bytes_in_use = 0;
+
+        /**
+         * @brief Highest value `bytes_in_use` has reached.
+         */
+        std::size_t peak_bytes_in_use = 0;
+
+        /**
+         * @brief Number of blocks currently handed out.
+         */
+        std::size_t live_allocations = 0;
+
+        /**
+         * @brief Total number of successful `Allocate()` calls.
+         */
+        std::size_t total_allocations = 0;
+
+        /**
+         * @brief Number of `Allocate()` calls that returned nullptr for an in-range request.
+         */
+        std::size_t failed_allocations = 0;
+    };
+
+    /**
+     * @brief A binary buddy allocator over one reserved region for mid-size requests.
+     *
+     * Serves power-of-2 blocks between `min_block_size` and `max_block_size`. Freed blocks are
+     * merged with their buddy as long as the buddy is free as well.
+     *
+     * Notes:
+     *
+     * - No per-allocation header: like `SlabManager`, `Free()` takes the `(size, alignment)` pair
+     *   used at the allocation site and derives the block order from it. `Free(ptr)` reads the order
+     *   from a side table instead.
+     *
+     * - Free-list nodes are embedded in free blocks; one bit per block and order tracks which blocks are free.
+     *
+     * - `Allocate()` and `Free()` are O(log(max_block_size / min_block_size)).
+     *
+     * - The region is aligned to `max_block_size`, so every block is aligned to its own size.
+     *
+     * - Not thread-safe; concurrent use must be synchronized by the caller.
+     */
+    class BuddyAllocator
+    {
+    public:
+        /**
+         * @brief Reserve the region and put it on the free lists as top-order blocks.
+         *
+         * @param min_block_size Smallest block; a power of 2 of at least `2 * sizeof(void*)`.
+         * @param max_block_size Largest block; a power of 2 of at least `min_block_size`.
+         * @param region_size Region size; rounded up to a multiple of `max_block_size`.
+         * @param backing Where the region comes from (see `PoolBacking`).
+         * @throws std::invalid_argument If a block size is not a power of 2, if the bounds are inverted or too small, or if `region_size` is zero or overflows.
+         * @throws std::bad_alloc If reserving the region fails.
+         */
+        BuddyAllocator(std::size_t min_block_size, std::size_t max_block_size, std::size_t region_size, PoolBacking backing = PoolBacking::kHeap);
+
+        /**
+         * @brief Release the region; outstanding pointers become invalid.
+         */
+        ~BuddyAllocator();
+
+        /**
+         * @brief Allocate the smallest block that holds `max(size, alignment)`.
+         *
+         * @param size The requested memory size; must be non-zero.
+         * @param alignment The requested alignment; a non-zero power of 2.
+         * @return Pointer to the block, or nullptr if no block of the required order is free or if the request exceeds `max_block_size`.
+         */
+        void *Allocate(std::size_t size, std::size_t alignment);
+
+        /**
+         * @brief Return a block and merge it with free buddies.
+         *
+         * Contract:
+         *
+         * - `ptr == nullptr` is allowed and is a no-op.
+         *
+         * - `size` and `alignment` must match the values used at the allocation site.
+         *
+         * - Double free or passing a pointer not returned by this allocator is a contract violation (undefined behavior).
+         */
+        void Free(void *ptr, std::size_t size, std::size_t alignment);
+
+        /**
+         * @brief Return a block without its request size; the order comes from a side table of one byte per minimum block.
+         *
+         * Same contract as `Free(ptr, size, alignment)` otherwise.
+         */
+        void Free(void *ptr);
+
+        /**
+         * @brief Change the order of an allocated block without moving it.
+         *
+         * Shrinking splits the block and frees its upper halves. Growing succeeds when the block is the lower buddy
+         * at every order up to the new one and each of those upper buddies is free; they are absorbed into the block.
+         *
+         * Contract:
+         *
+         * - `ptr` must be non-null and `(old_size, alignment)` must match the values used at the allocation site.
+         *
+         * - On success the block must be freed with `(new_size, alignment)` from then on.
+         *
+         * @return true if the block now holds `max(new_size, alignment)` bytes in place; false if it is unchanged and the caller must move it.
+         */
+        bool Resize(void *ptr, std::size_t old_size, std::size_t new_size, std::size_t alignment);
+
+        /**
+         * @brief Check whether `ptr` points into the managed region.
+         */
+        bool Owns(const void *ptr) const;
+
+        /**
+         * @brief Block size that serves a request of `max(size, alignment)` bytes, or 0 if it exceeds `max_block_size`.
+         */
+        std::size_t BlockSizeFor(std::size_t size, std::size_t alignment) const;
+
+        /**
+         * @brief Snapshot of the usage counters.
+         */
+        BuddyStats GetStats() const;
+
+        // Disable copy semantics for the owning allocator.
+        BuddyAllocator(const BuddyAllocator &) = delete;
+        BuddyAllocator &operator=(const BuddyAllocator &) = delete;
+
+    private:
+        /**
+         * @brief Embedded node of a per-order doubly-linked free list.
+         */
+        struct FreeBlock
+        {
+            FreeBlock *prev;
+            FreeBlock *next;
+        };
+
+        unsigned min_order_log2_;
+
+        /**
+         * @brief Number of orders; order 0 is `min_block_size`, the last one is `max_block_size`.
+         */
+        unsigned num_orders_;
+
+        std::size_t region_size_;
+        PoolRegion region_;
+        void *region_start_;
+
+        /**
+         * @brief Free-list head per order.
+         */
+        std::vector<FreeBlock *> free_lists_;
+
+        /**
+         * @brief Per-order bitmaps; bit `i` of order `k` is set while block `i` of that order is free.
+         */
+        std::vector<std::vector<std::uint64_t>> free_bits_;
+
+        /**
+         * @brief Order of each allocated block, indexed by its offset in minimum blocks.
+         */
+        std::vector<std::uint8_t> block_orders_;
+
+        BuddyStats stats_;
+
+        /**
+         * @brief Order serving a request, or `num_orders_` if it is too large.
+         */
+        unsigned OrderFor(std::size_t size, std::size_t alignment) const;
+
+        /**
+         * @brief Return the block at `offset` of `order` and merge it with free buddies.
+         */
+        void FreeAt(std::uintptr_t offset, unsigned order);
+
+        void PushFree(unsigned order, std::uintptr_t offset);
+        void RemoveFree(unsigned order, std::uintptr_t offset);
+        bool IsFree(unsigned order, std::uintptr_t offset) const;
+    };
+}
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef MCR_CONCURRENT_SLAB_ALLOCATOR_H_
+
+#define MCR_CONCURRENT_SLAB_ALLOCATOR_H_
+#include "slab_allocator.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace mcr
+{
+    /**
+     * @brief A lock-free fixed-size block allocator for concurrent use.
+     *
+     * Same pool layout and contract as `SlabAllocator`, but `Allocate()` and `Free()` may be called
+     * from any number of threads without external synchronization.
+     *
+     * Notes:
+     *
+     * - No per-allocation header is prepended to each block.
+     *
+     * - The free list is an embedded Treiber stack. Links are stored as block indices, which lets the
+     *   head pack a 32-bit index and a 32-bit version tag into one 64-bit word. Every successful
+     *   push or pop bumps the tag, so a stale compare-and-swap fails instead of corrupting the list (ABA).
+     *
+     * - `Allocate()` and `Free()` are lock-free and O(1) apart from compare-and-swap retries under contention.
+     *
+     * - The pool is limited to `2^32 - 1` blocks.
+     *
+     * - Destroying the allocator invalidates any outstanding pointers and must not race with other calls.
+     */
+    class ConcurrentSlabAllocator
+    {
+    public:
+        /**
+         * @brief Construct the allocator and its backing pool.
+         *
+         * The effective alignment is `max(requested_alignment, sizeof(void*))`.
+         * The final block size is rounded up to that alignment.
+         *
+         * @param block_size The requested payload size for each block.
+         * @param pool_size The requested backing pool size.
+         * @param alignment The requested alignment. Must be non-zero and a power of 2.
+         * @throws std::invalid_argument If alignment is zero, not a power of 2, if the pool cannot hold at least one effective block, or if it holds more blocks than an index link can address.
+         * @throws std::bad_alloc If the backing-pool allocation fails.
+         */
+        ConcurrentSlabAllocator(std::size_t block_size, std::size_t pool_size, std::size_t alignment = sizeof(void *));
+
+        /**
+         * @brief Destroy the allocator and release its backing pool.
+         */
+        ~ConcurrentSlabAllocator();
+
+        /**
+         * @brief Allocate a memory block from the backing pool.
+         *
+         * @return pointer to the allocated memory, or nullptr if the pool is exhausted.
+         */
+        void *Allocate();
+
+        /**
+         * @brief Return an allocated block to the backing pool.
+         *
+         * Contract:
+         *
+         * - `ptr == nullptr` is allowed and is a no-op.
+         *
+         * - `ptr` must be a block previously returned by `Allocate()` from this allocator.
+         *
+         * - Double free, cross-pool free, or passing a non-block pointer is a contract violation (undefined behavior).
+         *
+         * @param ptr Pointer to the block to be freed.
+         */
+        void Free(void *ptr);
+
+        /**
+         * @brief Snapshot of the usage counters (see `SlabStats`).
+         *
+         * Counters are relaxed atomics updated next to the free-list head, so a snapshot taken while other threads
+         * allocate may lag them by the operations in flight. They stay zero unless built with `MCR_ENABLE_STATS`.
+         */
+        SlabStats GetStats() const;
+
+        // ---------------------------------------------------------------
+        // Disable copy semantics for the owning allocator.
+        ConcurrentSlabAllocator(const ConcurrentSlabAllocator &) = delete;
+        ConcurrentSlabAllocator &operator=(const ConcurrentSlabAllocator &) = delete;
+        // ---------------------------------------------------------------
+
+    private:
+        /**
+         * @brief Embedded free list node.
+         *
+         * `next` holds `index + 1` of the next free block; 0 terminates the list.
+         */
+        struct FreeBlock
+        {
+            std::atomic<std::uint32_t> next;
+        };
+
+        /**
+         * @brief Low half of the head word: `index + 1` of the top block, or 0 if the list is empty.
+         */
+        static constexpr std::uint64_t kLinkMask = 0xFFFFFFFFu;
+
+        /**
+         * @brief High half of the head word: version tag, incremented by every successful update.
+         */
+        static constexpr std::uint64_t kTagIncrement = std::uint64_t{1} << 32;
+
+        std::size_t block_size_;
+        std::size_t pool_size_;
+        std::size_t alignment_;
+
+        /**
+         * @brief Start address of the backing pool allocated by the underlying allocator/system.
+         */
+        void *pool_start_;
+
+        /**
+         * @brief Tagged head of the free list, kept on its own cache line.
+         */
+        alignas(64) std::atomic<std::uint64_t> head_;
+
+#if MCR_ENABLE_STATS
+        /**
+         * @brief Relaxed counters; `in_use` is kept directly so each allocation can fold it into the high-water mark.
+         */
+        alignas(64) std::atomic<std::size_t> stats_in_use_{0};
+        std::atomic<std::size_t> stats_peak_in_use_{0};
+        std::atomic<std::size_t> stats_allocations_{0};
+        std::atomic<std::size_t> stats_failed_allocations_{0};
+#endif
+
+        FreeBlock *BlockAt(std::uint32_t link) const;
+        std::uint32_t LinkOf(const void *ptr) const;
+    };
+}
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef MCR_COROUTINE_FRAME_H_
+
+#define MCR_COROUTINE_FRAME_H_
+#if !defined(__cpp_impl_coroutine)
+#error "coroutine_frame.h requires C++20 coroutines; link the mcr_coroutines target (MCR_BUILD_COROUTINES)."
+#endif
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace mcr
+{
+    /**
+     * @brief Makes `manager` the frame allocator of coroutines created on this thread while the scope is alive.
+     *
+     * Scopes nest; the destructor restores the previous manager.
+     */
+    template <typename Manager>
+    class CoroutineFrameScope
+    {
+    public:
+        explicit CoroutineFrameScope(Manager &manager) : previous_(current_)
+        {
+            current_ = &manager;
+        }
+
+        ~CoroutineFrameScope()
+        {
+            current_ = previous_;
+        }
+
+        /**
+         * @brief Manager of the innermost live scope on this thread, or nullptr.
+         */
+        static Manager *Current()
+        {
+            return current_;
+        }
+
+        // Disable copy semantics for the scope.
+        CoroutineFrameScope(const CoroutineFrameScope &) = delete;
+        CoroutineFrameScope &operator=(const CoroutineFrameScope &) = delete;
+
+    private:
+        Manager *previous_;
+        static thread_local Manager *current_;
+    };
+
+    template <typename Manager>
+    thread_local Manager *CoroutineFrameScope<Manager>::current_ = nullptr;
+
+    /**
+     * @brief Promise-type mixin that allocates coroutine frames from a slab manager.
+     *
+     * Derive a promise type from `CoroutineFramePromise<Manager>` and its coroutine frames are served by the
+     * manager's size classes instead of global `operator new`. The manager is picked when the frame is created:
+     *
+     * - a coroutine whose first two parameters are `(std::allocator_arg_t, Manager &)` uses that manager;
+     *
+     * - otherwise the manager of the innermost `CoroutineFrameScope<Manager>` on the creating thread;
+     *
+     * - otherwise, or if the manager is exhausted, global `operator new`.
+     *
+     * Notes:
+     *
+     * - Works with any manager that has `Allocate(size, alignment)` and `Free(ptr, size, alignment)`.
+     *
+     * - The frame ends with a pointer to its manager, so the frame may be destroyed on any thread and after the scope
+     *   is gone. The release uses the sized `operator delete` the compiler calls with the frame size, so the
+     *   `(size, alignment)` pair is rebuilt without any lookup.
+     *
+     * - The manager must outlive every frame it served, and must be thread-safe if frames are created or destroyed
+     *   on several threads (e.g. `ThreadCachedSlabManager`).
+     */
+    template <typename Manager>
+    class CoroutineFramePromise
+    {
+    public:
+        static void *operator new(std::size_t size)
+        {
+            return AllocateFrame(size, CoroutineFrameScope<Manager>::Current());
+        }
+
+        template <typename... Args>
+        static void *operator new(std::size_t size, std::allocator_arg_t, Manager &manager, Args &...)
+        {
+            return AllocateFrame(size, &manager);
+        }
+
+        /**
+         * @brief Member functions taking the manager first pass `*this` ahead of it.
+         */
+        template <typename Self, typename... Args>
+        static void *operator new(std::size_t size, Self &, std::allocator_arg_t, Manager &manager, Args &...)
+        {
+            return AllocateFrame(size, &manager);
+        }
+
+        static void operator delete(void *frame, std::size_t size) noexcept
+        {
+            Manager *manager;
+            std::memcpy(&manager, static_cast<char *>(frame) + TrailerOffset(size), sizeof(manager));
+            if (manager)
+            {
+                manager->Free(frame, TrailerOffset(size) + sizeof(Manager *), kFrameAlignment);
+            }
+            else
+            {
+                ::operator delete(frame, TrailerOffset(size) + sizeof(Manager *));
+            }
+        }
+
+    private:
+        /**
+         * @brief Frames get the alignment global `operator new` guarantees.
+         */
+        static constexpr std::size_t kFrameAlignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+        /**
+         * @brief Offset of the manager pointer behind a frame of `size` bytes.
+         */
+        static constexpr std::size_t TrailerOffset(std::size_t size)
+        {
+            return (size + alignof(Manager *) - 1) & ~(alignof(Manager *) - 1);
+        }
+
+        static void *AllocateFrame(std::size_t size, Manager *manager)
+        {
+            const std::size_t total = TrailerOffset(size) + sizeof(Manager *);
+            void *frame = manager ? manager->Allocate(total, kFrameAlignment) : nullptr;
+            if (!frame)
+            {
+                manager = nullptr;
+                frame = ::operator new(total); // Throws std::bad_alloc like an unmanaged frame would.
+            }
+            std::memcpy(static_cast<char *>(frame) + TrailerOffset(size), &manager, sizeof(manager));
+            return frame;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,169 @@
+#ifndef MCR_FRAME_ALLOCATOR_H_
+
+#define MCR_FRAME_ALLOCATOR_H_
+#include "pool_memory.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace mcr
+{
+    /**
+     * @brief A linear (bump-pointer) allocator over one fixed backing pool.
+     *
+     * Meant for scratch data with a common lifetime, such as everything allocated during one frame.
+     * Individual allocations are never freed; `Reset()` releases all of them at once.
+     *
+     * Notes:
+     *
+     * - `Allocate()` is an align-up and a bounds check; `Reset()` is O(1) and touches no memory.
+     *
+     * - No per-allocation header and no free-list metadata.
+     *
+     * - Destructors of objects placed in the pool are not run; keep trivially destructible data here.
+     *
+     * - Not thread-safe; concurrent use must be synchronized by the caller.
+     */
+    class LinearAllocator
+    {
+    public:
+        /**
+         * @brief Alignment of the pool start; requests up to this alignment never waste leading padding.
+         */
+        static constexpr std::size_t kPoolAlignment = 64;
+
+        /**
+         * @brief Construct the allocator and its backing pool.
+         *
+         * @param capacity Size of the backing pool in bytes; must be non-zero.
+         * @param backing Where the pool comes from (see `PoolBacking`).
+         * @throws std::invalid_argument If `capacity` is zero.
+         * @throws std::bad_alloc If the backing-pool allocation fails.
+         */
+        explicit LinearAllocator(std::size_t capacity, PoolBacking backing = PoolBacking::kHeap);
+
+        /**
+         * @brief Release the backing pool; outstanding pointers become invalid.
+         */
+        ~LinearAllocator();
+
+        /**
+         * @brief Bump-allocate `size` bytes aligned to `alignment`.
+         *
+         * @param size The requested memory size; must be non-zero.
+         * @param alignment The requested alignment. Must be non-zero and a power of 2.
+         * @return Pointer to the memory, or nullptr if the rest of the pool cannot hold the request.
+         * @throws std::invalid_argument If `size` is zero, or if `alignment` is zero or not a power of 2.
+         */
+        void *Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * @brief Release every allocation at once by rewinding the bump pointer to the pool start.
+         *
+         * Contract:
+         *
+         * - Every pointer returned since the last `Reset()` becomes invalid.
+         */
+        void Reset();
+
+        /**
+         * @brief Bytes consumed since the last `Reset()`, including alignment padding.
+         */
+        std::size_t Used() const;
+
+        /**
+         * @brief Size of the backing pool in bytes.
+         */
+        std::size_t Capacity() const;
+
+        /**
+         * @brief Check whether `ptr` points into the backing pool.
+         */
+        bool Owns(const void *ptr) const;
+
+        // Disable copy semantics for the owning allocator.
+        LinearAllocator(const LinearAllocator &) = delete;
+        LinearAllocator &operator=(const LinearAllocator &) = delete;
+
+    private:
+        PoolRegion pool_;
+
+        /**
+         * @brief Start and end of the usable pool.
+         */
+        std::uintptr_t begin_;
+        std::uintptr_t end_;
+
+        /**
+         * @brief Next free byte.
+         */
+        std::uintptr_t cursor_;
+    };
+
+    /**
+     * @brief Two `LinearAllocator`s that alternate frame by frame.
+     *
+     * Allocations go to the current frame's buffer. `NextFrame()` flips buffers and resets only the one
+     * that becomes current, so data allocated during frame N stays valid throughout frame N + 1 (e.g. last
+     * frame's transforms for interpolation, or command lists consumed one frame late) and is released when
+     * frame N + 2 begins.
+     *
+     * Notes:
+     *
+     * - `NextFrame()` is O(1); the two buffers have the same capacity and backing.
+     *
+     * - Not thread-safe; concurrent use must be synchronized by the caller.
+     */
+    class DoubleBufferedFrameAllocator
+    {
+    public:
+        /**
+         * @brief Construct both frame buffers.
+         *
+         * @param frame_capacity Size of each frame buffer in bytes; must be non-zero.
+         * @param backing Where both buffers come from (see `PoolBacking`).
+         * @throws std::invalid_argument If `frame_capacity` is zero.
+         * @throws std::bad_alloc If a backing-pool allocation fails.
+         */
+        explicit DoubleBufferedFrameAllocator(std::size_t frame_capacity, PoolBacking backing = PoolBacking::kHeap);
+
+        /**
+         * @brief Allocate from the current frame's buffer (see `LinearAllocator::Allocate()`).
+         */
+        void *Allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t));
+
+        /**
+         * @brief Begin the next frame.
+         *
+         * Contract:
+         *
+         * - Pointers allocated during the current frame stay valid until the following `NextFrame()` call.
+         *
+         * - Pointers allocated during the previous frame become invalid.
+         */
+        void NextFrame();
+
+        /**
+         * @brief Buffer serving the current frame.
+         */
+        const LinearAllocator &CurrentFrame() const;
+
+        /**
+         * @brief Buffer holding the previous frame's data.
+         */
+        const LinearAllocator &PreviousFrame() const;
+
+        // Disable copy semantics for the owning allocator.
+        DoubleBufferedFrameAllocator(const DoubleBufferedFrameAllocator &) = delete;
+        DoubleBufferedFrameAllocator &operator=(const DoubleBufferedFrameAllocator &) = delete;
+
+    private:
+        LinearAllocator frames_[2];
+
+        /**
+         * @brief Index of the current frame's buffer in `frames_`.
+         */
+        std::size_t current_;
+    };
+}
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef MCR_OBJECT_POOL_H_
+
+#define MCR_OBJECT_POOL_H_
+#include "slab_allocator.h"
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace mcr
+{
+    /**
+     * @brief Typed pool of `T` objects over one `SlabAllocator`.
+     *
+     * Block size and alignment come from `sizeof(T)` and `alignof(T)` at compile time, so `Create()` and
+     * `Destroy()` are a free-list pop/push plus the constructor or destructor, with no routing or request validation.
+     *
+     * Notes:
+     *
+     * - `Create()` returns nullptr when the pool is exhausted and cannot grow, like `SlabAllocator::Allocate()`.
+     *
+     * - Objects still alive when the pool is destroyed are not destructed; their memory is released.
+     *
+     * - Not thread-safe; concurrent use must be synchronized by the caller.
+     *
+     * @tparam T Object type; over-aligned types are supported.
+     */
+    template <typename T>
+    class ObjectPool
+    {
+    public:
+        /**
+         * @brief Effective block size of one object, as `SlabAllocator` rounds it.
+         */
+        static constexpr std::size_t kBlockSize = [] {
+            constexpr std::size_t alignment = (alignof(T) > sizeof(void *)) ? alignof(T) : sizeof(void *);
+            constexpr std::size_t size = (sizeof(T) > sizeof(void *)) ? sizeof(T) : sizeof(void *);
+            return (size + alignment - 1) & ~(alignment - 1);
+        }();
+
+        /**
+         * @brief Construct the pool with room for `capacity` objects.
+         *
+         * @param capacity Objects pre-allocated at construction; must be non-zero.
+         * @param growth How to add slabs once the pool is exhausted. The default keeps a fixed capacity.
+         * @param max_capacity Upper bound on the objects of all slabs; only used when growth is enabled.
+         * @param backing Where the pool and grown slabs come from.
+         * @throws std::invalid_argument If `capacity` is zero or overflows, or if growth is enabled and `max_capacity < capacity`.
+         * @throws std::bad_alloc If the backing-pool allocation fails.
+         */
+        explicit ObjectPool(std::size_t capacity, SlabGrowth growth = SlabGrowth::kNone, std::size_t max_capacity = 0, PoolBacking backing = PoolBacking::kHeap)
+            : allocator_(sizeof(T), PoolBytes(capacity), alignof(T), GrowthPolicy(capacity, growth, max_capacity), backing)
+        {
+        }
+
+        /**
+         * @brief Allocate a block and construct a `T` in it from `args`.
+         *
+         * @return The new object, or nullptr if the pool is exhausted and cannot grow.
+         * @throws Anything thrown by the constructor of `T`; the block is returned to the pool first.
+         */
+        template <typename... Args>
+        T *Create(Args &&...args)
+        {
+            void *block = allocator_.Allocate();
+            if (!block)
+            {
+                return nullptr;
+            }
+            try
+            {
+                return ::new (block) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                allocator_.Free(block);
+                throw;
+            }
+        }
+
+        /**
+         * @brief Destruct an object and return its block to the pool.
+         *
+         * Contract:
+         *
+         * - `object == nullptr` is allowed and is a no-op.
+         *
+         * - `object` must come from `Create()` of this pool; double destroy is a contract violation (undefined behavior).
+         */
+        void Destroy(T *object)
+        {
+            if (!object)
+            {
+                return;
+            }
+            object->~T();
+            allocator_.Free(object);
+        }
+
+        /**
+         * @brief Return fully free pages to the OS (see `SlabAllocator::Scavenge()`).
+         */
+        std::size_t Scavenge(ReleaseAdvice advice = ReleaseAdvice::kDontNeed)
+        {
+            return allocator_.Scavenge(advice);
+        }
+
+        // Disable copy semantics for the owning pool.
+        ObjectPool(const ObjectPool &) = delete;
+        ObjectPool &operator=(const ObjectPool &) = delete;
+
+    private:
+        SlabAllocator allocator_;
+
+        static std::size_t PoolBytes(std::size_t capacity)
+        {
+            if (capacity == 0 || capacity > std::numeric_limits<std::size_t>::max() / kBlockSize)
+            {
+                throw std::invalid_argument("Object pool capacity must be non-zero and must not overflow.");
+            }
+            return capacity * kBlockSize;
+        }
+
+        static SlabGrowthPolicy GrowthPolicy(std::size_t capacity, SlabGrowth growth, std::size_t max_capacity)
+        {
+            SlabGrowthPolicy policy;
+            policy.growth = growth;
+            if (growth != SlabGrowth::kNone)
+            {
+                if (max_capacity < capacity)
+                {
+                    throw std::invalid_argument("Max capacity must not be below capacity.");
+                }
+                // Saturate instead of overflowing; the bound is only compared against the grown size.
+                policy.max_pool_size = (max_capacity > std::numeric_limits<std::size_t>::max() / kBlockSize) ? std::numeric_limits<std::size_t>::max() : max_capacity * kBlockSize;
+            }
+            return policy;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef MCR_PAGE_HEAP_H_
+
+#define MCR_PAGE_HEAP_H_
+#include "pool_memory.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mcr
+{
+    /**
+     * @brief Usage counters of a `PageHeap`.
+     */
+    struct PageHeapStats
+    {
+        std::size_t span_size = 0;
+
+        /**
+         * @brief Spans in the heap; the memory budget in spans.
+         */
+        std::size_t span_count = 0;
+
+        /**
+         * @brief Spans currently handed out.
+         */
+        std::size_t spans_in_use = 0;
+
+        /**
+         * @brief Highest value `spans_in_use` has reached.
+         */
+        std::size_t peak_spans_in_use = 0;
+
+        /**
+         * @brief Free spans whose pages were handed back to the OS by `Release()` and have not been handed out again.
+         */
+        std::size_t released_spans = 0;
+    };
+
+    /**
+     * @brief A fixed budget of memory handed out as equally sized, naturally aligned spans.
+     *
+     * One region of `heap_size` bytes is reserved up front and cut into spans of `span_size` bytes (a power of 2).
+     * Spans are handed out from a bump frontier while never-used spans remain, and from a LIFO stack of returned
+     * spans afterwards, so the most recently returned (cache-hot) span is reused first.
+     *
+     * Notes:
+     *
+     * - `AllocateSpan()` and `FreeSpan()` are O(1); `SpanIndex()` of any address inside the heap is a subtract and a shift.
+     *
+     * - Pages are committed only when a span is first touched; `Release()` hands the pages of returned spans back to the OS.
+     *
+     * - Fixed capacity; not thread-safe; concurrent use must be synchronized by the caller.
+     */
+    class PageHeap
+    {
+    public:
+        static constexpr std::size_t kDefaultSpanSize = std::size_t{64} << 10;
+
+        /**
+         * @brief Smallest span size accepted; one base page on common platforms.
+         */
+        static constexpr std::size_t kMinSpanSize = 4096;
+
+        /**
+         * @brief Reserve the heap; `heap_size` is trimmed to whole spans.
+         *
+         * @param heap_size Memory budget in bytes.
+         * @param span_size Size and alignment of every span; a power of 2 of at least `kMinSpanSize`.
+         * @param backing Where the region comes from (see `PoolBacking`).
+         * @throws std::invalid_argument If `span_size` is not a power of 2 or below `kMinSpanSize`, or if `heap_size` cannot hold one span.
+         * @throws std::bad_alloc If the reservation fails.
+         */
+        PageHeap(std::size_t heap_size, std::size_t span_size = kDefaultSpanSize, PoolBacking backing = PoolBacking::kHeap);
+
+        /**
+         * @brief Release the region; outstanding spans become invalid.
+         */
+        ~PageHeap();
+
+        /**
+         * @brief Hand out one span.
+         *
+         * @return Start of the span, aligned to `SpanSize()`; nullptr if every span is in use.
+         */
+        void *AllocateSpan();
+
+        /**
+         * @brief Return a span to the heap.
+         *
+         * Contract:
+         *
+         * - `span` must be a start address returned by `AllocateSpan()` that has not been returned yet.
+         */
+        void FreeSpan(void *span);
+
+        /**
+         * @brief Check whether `ptr` lies inside the heap region.
+         */
+        bool Owns(const void *ptr) const
+        {
+            return reinterpret_cast<std::uintptr_t>(ptr) - base_ < span_count_ << span_shift_;
+        }
+
+        /**
+         * @brief Index of the span containing `ptr`, which must lie inside the heap.
+         */
+        std::size_t SpanIndex(const void *ptr) const
+        {
+            return (reinterpret_cast<std::uintptr_t>(ptr) - base_) >> span_shift_;
+        }
+
+        /**
+         * @brief Start address of the span with index `index`.
+         */
+        void *SpanAddress(std::size_t index) const
+        {
+            return reinterpret_cast<void *>(base_ + (index << span_shift_));
+        }
+
+        std::size_t SpanSize() const
+        {
+            return std::size_t{1} << span_shift_;
+        }
+
+        std::size_t SpanCount() const
+        {
+            return span_count_;
+        }
+
+        /**
+         * @brief Hand the pages of every returned span back to the OS; they re-fault when the span is used again.
+         *
+         * O(returned spans); meant for idle time.
+         *
+         * @return Number of bytes handed back to the OS by this call.
+         */
+        std::size_t Release(ReleaseAdvice advice = ReleaseAdvice::kDontNeed);
+
+        PageHeapStats GetStats() const;
+
+        // Disable copy semantics for the heap.
+        PageHeap(const PageHeap &) = delete;
+        PageHeap &operator=(const PageHeap &) = delete;
+
+    private:
+        PoolRegion region_;
+        std::uintptr_t base_;
+        unsigned span_shift_;
+        std::size_t span_count_;
+
+        /**
+         * @brief Index of the first never-used span.
+         */
+        std::size_t next_unused_ = 0;
+
+        /**
+         * @brief Returned spans; the top is the most recently returned one.
+         */
+        std::vector<std::uint32_t> free_spans_;
+
+        /**
+         * @brief Per-span flag: its pages were released and it has not been handed out since.
+         */
+        std::vector<bool> released_;
+
+        std::size_t released_spans_ = 0;
+        std::size_t spans_in_use_ = 0;
+        std::size_t peak_spans_in_use_ = 0;
+    };
+}
+
+#endif
@@ -0,0 +1,210 @@
+#ifndef MCR_PER_CPU_SLAB_MANAGER_H_
+
+#define MCR_PER_CPU_SLAB_MANAGER_H_
+#include "slab_allocator.h"
+#include "slab_manager.h"
+#include "size_class.h"
+#include <cstddef>
+#include <array>
+#include <memory>
+#include <mutex>
+
+namespace mcr
+{
+    /**
+     * @brief Thread-safe slab manager with one block cache per CPU in front of shared per-class pools.
+     *
+     * Works like `ThreadCachedSlabManager`, but caches belong to CPUs instead of threads: `Allocate()`
+     * and `Free()` work on the cache of the CPU the caller is running on. Cached memory therefore scales
+     * with the core count, not with the thread count, which matters when many more threads than cores
+     * are running.
+     *
+     * Notes:
+     *
+     * - The CPU comes from `sched_getcpu()`, which glibc 2.35+ answers from the registered `rseq` area
+     *   (one load, no syscall). Where it is unavailable, each thread is pinned to a shard picked round-robin
+     *   on first use.
+     *
+     * - Each shard has its own lock. A thread is only ever contended by another thread running on (or just
+     *   migrated from) the same CPU, so the lock line stays in the local core's cache. A true `rseq` critical
+     *   section would drop the lock, but needs per-architecture assembly plus `membarrier` fencing for the
+     *   cross-shard walks of `FlushCpuCaches()` and `GetStats()`, and is not used. The uncontended lock makes a
+     *   call several times slower than a `ThreadCachedSlabManager` hit (see `BM_OversubscribedPerCpu`); choose
+     *   this manager for its memory bound, not for raw fast-path speed.
+     *
+     * - Uses the same routing policy and `(size, alignment)` deallocation contract as `SlabManager`; a block
+     *   may be freed on a different CPU than the one that allocated it.
+     *
+     * - `Allocate()` may return nullptr while blocks of the same class are still parked in other CPUs' caches.
+     *
+     * - Destroying the manager invalidates any outstanding pointers; it must not race with calls on the manager.
+     */
+    class PerCpuSlabManager
+    {
+    public:
+        /**
+         * @brief Maximum number of blocks one CPU caches per size class.
+         */
+        static constexpr std::size_t kCpuCacheCapacity = 64;
+
+        /**
+         * @brief Number of blocks moved between a CPU cache and a shared pool per refill or flush.
+         */
+        static constexpr std::size_t kTransferBatchSize = kCpuCacheCapacity / 2;
+
+        /**
+         * @brief Construct the manager, its shared per-class pools and one cache per shard.
+         *
+         * @param config Per-class capacity, growth and large-object settings (see `SlabManagerConfig`).
+         * @param num_shards Number of CPU caches; 0 uses the number of configured CPUs. CPU ids are mapped onto shards modulo this count.
+         * @throws std::invalid_argument If the configuration is invalid (see `MakeSizeClassAllocator()`).
+         * @throws std::bad_alloc If a backing-pool allocation fails.
+         */
+        explicit PerCpuSlabManager(const SlabManagerConfig &config = SlabManagerConfig{}, std::size_t num_shards = 0);
+
+        /**
+         * @brief Release the shared pools and the CPU caches.
+         */
+        ~PerCpuSlabManager();
+
+        /**
+         * @brief Allocate memory from the current CPU's cache for the smallest satisfying size class.
+         *
+         * @param size The requested memory size.
+         * @param alignment The requested alignment. Must be non-zero and a power of 2.
+         * @return Pointer to the allocated memory, or nullptr if the CPU cache and the shared pool of the target class are both empty and the pool cannot grow, if the large-object region is exhausted, or if the request exceeds every configured tier.
+         * @throws std::invalid_argument If `size` is zero, or if `alignment` is zero or not a power of 2.
+         */
+        void *Allocate(std::size_t size, std::size_t alignment = sizeof(void *));
+
+        /**
+         * @brief Return memory to the current CPU's cache for its size class.
+         *
+         * Contract:
+         *
+         * - `ptr == nullptr` is allowed and is a no-op.
+         *
+         * - `size` and `alignment` must match the values used at the allocation site.
+         *
+         * - Passing a mismatched `(size, alignment)` pair, a non-owned pointer, or double-freeing a block is a contract violation (undefined behavior).
+         */
+        void Free(void *ptr, std::size_t size, std::size_t alignment);
+
+        /**
+         * @brief Return memory without its request size (see `SlabManager::Free(void *)`).
+         *
+         * @throws std::invalid_argument If `ptr` is not owned by the class arena or the large-object region.
+         */
+        void Free(void *ptr);
+
+        /**
+         * @brief Check whether `ptr` lies in memory that `Free(ptr)` can route (see `SlabManager::Owns()`).
+         */
+        bool Owns(const void *ptr) const;
+
+        /**
+         * @brief Return every block cached by every CPU to the shared pools.
+         */
+        void FlushCpuCaches();
+
+        /**
+         * @brief Return fully free pages of the shared pools to the OS (see `ThreadCachedSlabManager::Scavenge()`).
+         *
+         * Blocks parked in CPU caches are not free from the pool's point of view and are not scavenged.
+         */
+        std::size_t Scavenge(ReleaseAdvice advice = ReleaseAdvice::kDontNeed);
+
+        /**
+         * @brief Usage counters of the large-object region; all zero if it is disabled.
+         */
+        BuddyStats GetLargeObjectStats();
+
+        /**
+         * @brief Snapshot of the per-class and large-object counters, aggregated over every CPU cache.
+         *
+         * Class counters are only collected when built with `MCR_ENABLE_STATS`; otherwise only `block_size` and
+         * `capacity` are filled in. Each shard counts under the lock its fast path already holds, and the shards are
+         * summed here one at a time.
+         *
+         * Notes:
+         *
+         * - `in_use` counts blocks held by callers; blocks parked in CPU caches are not in use.
+         *
+         * - `peak_in_use` is the high-water mark of blocks taken from the shared pool, cached blocks included, so it
+         *   bounds the true peak from above.
+         */
+        SlabManagerStats GetStats();
+
+        /**
+         * @brief Number of CPU caches.
+         */
+        std::size_t ShardCount() const;
+
+        /**
+         * @brief CPU the calling thread is running on, or its fallback slot if the CPU cannot be queried.
+         */
+        static std::size_t CurrentCpu();
+
+        // Disable copy semantics for the manager.
+        PerCpuSlabManager(const PerCpuSlabManager &) = delete;
+        PerCpuSlabManager &operator=(const PerCpuSlabManager &) = delete;
+
+    private:
+        static constexpr std::size_t kNumClasses = SizeClassPolicy::kNumClasses;
+
+        /**
+         * @brief A shared size-class pool and the lock that guards it.
+         */
+        struct CentralClass
+        {
+            std::mutex mutex;
+            std::unique_ptr<SlabAllocator> allocator;
+        };
+
+        struct CpuCache;
+
+        /**
+         * @brief Region the shared pools are carved from; null unless `contiguous_arena` is set. Declared first so it outlives them.
+         */
+        std::unique_ptr<ClassArena> arena_;
+
+        std::array<CentralClass, kNumClasses> central_;
+
+        /**
+         * @brief Guards `large_`.
+         */
+        std::mutex large_mutex_;
+
+        /**
+         * @brief Serves requests above `SizeClassPolicy::kMaxClassSize`; null if the large-object path is disabled.
+         */
+        std::unique_ptr<BuddyAllocator> large_;
+
+        std::size_t num_shards_;
+        std::unique_ptr<CpuCache[]> caches_;
+
+        /**
+         * @brief Cache of the CPU the caller is running on.
+         */
+        CpuCache &LocalCache();
+
+        /**
+         * @brief Move up to `kTransferBatchSize` blocks from the shared pool into the cache bin; the cache must be locked.
+         *
+         * @return false if the shared pool had no block to give.
+         */
+        bool Refill(CpuCache &cache, std::size_t class_idx);
+
+        /**
+         * @brief Move the `count` oldest blocks of the cache bin back to the shared pool; the cache must be locked.
+         */
+        void Flush(CpuCache &cache, std::size_t class_idx, std::size_t count);
+
+        /**
+         * @brief Push a block onto the current CPU's bin of `class_idx`, flushing first if the bin is full.
+         */
+        void FreeToCache(void *ptr, std::size_t class_idx);
+    };
+}
+
+#endif
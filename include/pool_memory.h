@@ -0,0 +1,156 @@
+#ifndef MCR_POOL_MEMORY_H_
+
+#define MCR_POOL_MEMORY_H_
+#include <cstddef>
+
+namespace mcr
+{
+    /**
+     * @brief Effective geometry of a fixed-size block pool.
+     */
+    struct PoolLayout
+    {
+        /**
+         * @brief Effective block size; a multiple of `alignment`.
+         */
+        std::size_t block_size;
+
+        /**
+         * @brief Number of whole blocks in the pool.
+         */
+        std::size_t block_count;
+
+        /**
+         * @brief Effective alignment; `max(requested alignment, sizeof(void*))`.
+         */
+        std::size_t alignment;
+
+        /**
+         * @brief Backing-pool size trimmed to a whole-block multiple.
+         */
+        std::size_t PoolSize() const
+        {
+            return block_size * block_count;
+        }
+    };
+
+    /**
+     * @brief Validate the requested pool geometry and derive the effective layout.
+     *
+     * The effective alignment is `max(requested_alignment, sizeof(void*))`.
+     * The block size is first raised to `min_block_size`, then rounded up to the effective alignment.
+     *
+     * @param block_size The requested payload size for each block.
+     * @param pool_size The requested backing pool size.
+     * @param alignment The requested alignment. Must be non-zero and a power of 2.
+     * @param min_block_size The smallest block that can hold the pool's embedded metadata.
+     * @throws std::invalid_argument If alignment is zero, not a power of 2, if rounding overflows, or if the pool cannot hold at least one effective block.
+     */
+    PoolLayout ComputePoolLayout(std::size_t block_size, std::size_t pool_size, std::size_t alignment, std::size_t min_block_size);
+
+    /**
+     * @brief Allocate an aligned backing pool from the system allocator.
+     *
+     * @throws std::bad_alloc If the allocation fails.
+     */
+    void *AllocateAlignedPool(std::size_t size, std::size_t alignment);
+
+    /**
+     * @brief Release a pool returned by `AllocateAlignedPool()`.
+     */
+    void FreeAlignedPool(void *pool);
+
+    /**
+     * @brief Where the memory of a pool comes from.
+     *
+     * Page-mapped backings fall back towards `kHeap` when the platform cannot provide them:
+     * `kExplicitHugePages` -> `kTransparentHugePages` -> `kMmap` -> `kHeap`.
+     */
+    enum class PoolBacking
+    {
+        /**
+         * @brief Aligned system heap (`posix_memalign` / `_aligned_malloc`).
+         */
+        kHeap,
+
+        /**
+         * @brief Private anonymous mapping on base pages.
+         */
+        kMmap,
+
+        /**
+         * @brief Anonymous mapping aligned to `kHugePageSize` and advised with `MADV_HUGEPAGE`.
+         */
+        kTransparentHugePages,
+
+        /**
+         * @brief `MAP_HUGETLB` mapping from the reserved huge-page pool.
+         */
+        kExplicitHugePages,
+    };
+
+    /**
+     * @brief Huge-page size assumed for alignment and `MAP_HUGETLB` rounding (2 MiB, the x86-64 and arm64 PMD size).
+     */
+    constexpr std::size_t kHugePageSize = std::size_t{2} << 20;
+
+    /**
+     * @brief A backing pool and the backing it was actually obtained from.
+     */
+    struct PoolRegion
+    {
+        void *start = nullptr;
+
+        /**
+         * @brief Size to release; may exceed the requested size after page rounding.
+         */
+        std::size_t size = 0;
+
+        PoolBacking backing = PoolBacking::kHeap;
+    };
+
+    /**
+     * @brief Allocate an aligned backing pool from the requested backing, falling back as needed.
+     *
+     * @return The pool; `backing` reports the backing that was actually used.
+     * @throws std::bad_alloc If even the heap fallback fails.
+     */
+    PoolRegion AllocatePool(std::size_t size, std::size_t alignment, PoolBacking backing);
+
+    /**
+     * @brief Release a pool returned by `AllocatePool()`.
+     */
+    void FreePool(const PoolRegion &region);
+
+    /**
+     * @brief How released pages are handed back to the OS.
+     */
+    enum class ReleaseAdvice
+    {
+        /**
+         * @brief `MADV_DONTNEED`: RSS drops immediately; the next touch faults in a zero page.
+         */
+        kDontNeed,
+
+        /**
+         * @brief `MADV_FREE`: the kernel reclaims the pages only under memory pressure; cheaper to reuse. Falls back to `kDontNeed` where unsupported.
+         */
+        kFree,
+    };
+
+    /**
+     * @brief Size of a base page of the system.
+     */
+    std::size_t SystemPageSize();
+
+    /**
+     * @brief Let the OS reclaim the physical pages of a page-aligned range; the range stays mapped and re-faults on access.
+     *
+     * The contents of the range are lost.
+     *
+     * @return false if the platform does not support releasing pages or the advice was rejected.
+     */
+    bool ReleasePages(void *start, std::size_t size, ReleaseAdvice advice);
+}
+
+#endif
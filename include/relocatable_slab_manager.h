@@ -0,0 +1,206 @@
+#ifndef MCR_RELOCATABLE_SLAB_MANAGER_H_
+
+#define MCR_RELOCATABLE_SLAB_MANAGER_H_
+#include "size_class.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace mcr
+{
+    /**
+     * @brief Placement and capacity of a `RelocatableSlabManager` heap.
+     */
+    struct RelocatableHeapConfig
+    {
+        /**
+         * @brief Default base address: 32 TiB, clear of the usual heap, stack and library areas of 47-bit and 48-bit address spaces.
+         */
+        static constexpr std::uintptr_t kDefaultBase = std::uintptr_t{1} << 45;
+
+        /**
+         * @brief Address the heap is mapped at; page-aligned. 0 lets the system choose.
+         *
+         * A restored image is mapped at the same address, so pointers stored inside the heap stay valid.
+         */
+        std::uintptr_t base = kDefaultBase;
+
+        /**
+         * @brief Blocks of each size class. Address space for all of them is reserved up front; pages are committed on first use.
+         */
+        std::size_t blocks_per_class = std::size_t{1} << 16;
+    };
+
+    /**
+     * @brief Slab manager whose whole state lives in one mapped region, so the heap can be saved to a file and mapped back.
+     *
+     * The region starts with a header holding every class's free-list head and frontier, followed by one fixed span
+     * per size class. Free-list links are stored as offsets from the base rather than as pointers, so the allocator
+     * state means the same thing wherever the region is mapped.
+     *
+     * `WriteImage()` stores the header and every carved block; `Restore()` maps such a file back with one private
+     * `mmap` and continues allocating from the saved state. Restoring does no work proportional to the heap:
+     * pages are read from the file when they are first touched, and writes stay private to the process.
+     *
+     * Notes:
+     *
+     * - Uses the same routing policy as `SlabManager`; requests above `SizeClassPolicy::kMaxClassSize` are not served.
+     *
+     * - `Allocate()` and `Free()` are O(1); `Free(ptr)` finds the class from the offset without a size.
+     *
+     * - Pointers stored in heap objects are only valid when the image is restored at the base it was written from.
+     *   Object graphs that store `ToOffset()` values instead can be restored anywhere (see `Restore()`).
+     *
+     * - POSIX only (`mmap`); not thread-safe; concurrent use must be synchronized by the caller.
+     */
+    class RelocatableSlabManager
+    {
+    public:
+        /**
+         * @brief Map an empty heap.
+         *
+         * @throws std::invalid_argument If `base` is not page-aligned or `blocks_per_class` is zero or too large.
+         * @throws std::bad_alloc If the region cannot be mapped at `base`.
+         */
+        explicit RelocatableSlabManager(const RelocatableHeapConfig &config = RelocatableHeapConfig{});
+
+        /**
+         * @brief Map a heap image written by `WriteImage()` and continue from its saved state.
+         *
+         * Runs in O(1): the header is validated and the file is mapped copy-on-write; nothing is copied or rebuilt.
+         *
+         * @param path Image file.
+         * @param allow_relocation Map the image elsewhere if its recorded base is taken, instead of failing.
+         * @throws std::runtime_error If the file cannot be read, is not a heap image of this version, or cannot be mapped at its recorded base and `allow_relocation` is false.
+         */
+        static std::unique_ptr<RelocatableSlabManager> Restore(const std::string &path, bool allow_relocation = false);
+
+        /**
+         * @brief Unmap the heap; outstanding pointers become invalid.
+         */
+        ~RelocatableSlabManager();
+
+        /**
+         * @brief Allocate memory from the smallest satisfying size class.
+         *
+         * @param size The requested memory size.
+         * @param alignment The requested alignment. Must be non-zero and a power of 2.
+         * @return Pointer to the allocated memory, or nullptr if the class is exhausted or the request exceeds the largest size class.
+         * @throws std::invalid_argument If `size` is zero, or if `alignment` is zero or not a power of 2.
+         */
+        void *Allocate(std::size_t size, std::size_t alignment = sizeof(void *));
+
+        /**
+         * @brief Free memory back to its size class.
+         *
+         * The class is found from the address, so `(size, alignment)` are only taken for API parity with `SlabManager`.
+         *
+         * Contract:
+         *
+         * - `ptr == nullptr` is allowed and is a no-op.
+         *
+         * - Passing a non-owned pointer or double-freeing a block is a contract violation (undefined behavior).
+         */
+        void Free(void *ptr, std::size_t size, std::size_t alignment);
+
+        /**
+         * @brief Free memory without its request size.
+         *
+         * Contract:
+         *
+         * - `ptr == nullptr` is allowed and is a no-op.
+         *
+         * - Double-freeing a block or passing an interior pointer is a contract violation (undefined behavior).
+         *
+         * @throws std::invalid_argument If `ptr` does not lie in a size-class span (see `Owns()`).
+         */
+        void Free(void *ptr);
+
+        /**
+         * @brief Check whether `ptr` lies in one of the size-class spans of the heap.
+         */
+        bool Owns(const void *ptr) const;
+
+        /**
+         * @brief Record the entry point of the object graph; stored in the image header.
+         *
+         * @param root A pointer into the heap, or nullptr.
+         */
+        void SetRoot(void *root);
+
+        /**
+         * @brief The recorded entry point, translated to the current base; nullptr if none was set.
+         */
+        void *Root() const;
+
+        /**
+         * @brief Write the heap to an image file for `Restore()`.
+         *
+         * Only the header and carved blocks are written; never-used parts of each class span are left as holes of a
+         * sparse file. The image is written next to `path` and renamed over it, so a process that has `path` mapped
+         * keeps its own view.
+         *
+         * @throws std::runtime_error If the file cannot be written.
+         */
+        void WriteImage(const std::string &path) const;
+
+        /**
+         * @brief Offset of a heap address from the base; stays meaningful across relocation.
+         */
+        std::uint64_t ToOffset(const void *ptr) const
+        {
+            return reinterpret_cast<std::uintptr_t>(ptr) - base_;
+        }
+
+        /**
+         * @brief Heap address of an offset returned by `ToOffset()`.
+         */
+        void *FromOffset(std::uint64_t offset) const
+        {
+            return reinterpret_cast<void *>(base_ + offset);
+        }
+
+        void *Base() const
+        {
+            return reinterpret_cast<void *>(base_);
+        }
+
+        /**
+         * @brief Size of the mapped region and of an image file.
+         */
+        std::size_t ImageSize() const
+        {
+            return image_size_;
+        }
+
+        // Disable copy semantics for the manager.
+        RelocatableSlabManager(const RelocatableSlabManager &) = delete;
+        RelocatableSlabManager &operator=(const RelocatableSlabManager &) = delete;
+
+    private:
+        static constexpr std::size_t kNumClasses = SizeClassPolicy::kNumClasses;
+
+        struct ImageHeader;
+
+        /**
+         * @brief Adopt a mapped region whose header is already initialized.
+         */
+        RelocatableSlabManager(void *base, std::size_t image_size);
+
+        std::uintptr_t base_;
+        std::size_t image_size_;
+
+        /**
+         * @brief Header at the start of the region; all allocator state lives here.
+         */
+        ImageHeader *header_;
+
+        /**
+         * @brief `log2` of the span each size class occupies.
+         */
+        unsigned span_shift_;
+    };
+}
+
+#endif
@@ -0,0 +1,158 @@
+#ifndef MCR_REMOTE_FREE_SLAB_MANAGER_H_
+
+#define MCR_REMOTE_FREE_SLAB_MANAGER_H_
+#include "slab_manager.h"
+#include "size_class.h"
+#include <atomic>
+#include <cstddef>
+#include <array>
+#include <thread>
+
+namespace mcr
+{
+    /**
+     * @brief A `SlabManager` owned by one thread that any thread may free into.
+     *
+     * The owner allocates and frees directly from the manager with no synchronization. A `Free()` from any other
+     * thread pushes the block onto a lock-free per-class remote-free stack with one compare-and-swap; the link is
+     * stored in the freed block itself. The owner takes a whole stack with one exchange the next time it allocates
+     * from that class and returns it to the manager in batches.
+     *
+     * Notes:
+     *
+     * - Built for producer/consumer pipelines: the producer owns the manager and consumers free what it produced.
+     *   Blocks never sit in the consumers' caches and no lock is taken on either side.
+     *
+     * - `Allocate()`, `CollectRemoteFrees()` and `Scavenge()` may only be called by the owner. `Free()` may be called by any thread.
+     *
+     * - Remotely freed blocks stay unavailable until the owner allocates from their class or calls `CollectRemoteFrees()`,
+     *   so `Allocate()` can return nullptr while freed blocks of another class are still queued.
+     *
+     * - Uses the same routing policy and `(size, alignment)` deallocation contract as `SlabManager`.
+     */
+    class RemoteFreeSlabManager
+    {
+    public:
+        /**
+         * @brief Construct the manager; the calling thread becomes its owner.
+         *
+         * @throws std::invalid_argument If the configuration is invalid (see `MakeSizeClassAllocator()`).
+         * @throws std::bad_alloc If a backing-pool allocation fails.
+         */
+        explicit RemoteFreeSlabManager(const SlabManagerConfig &config = SlabManagerConfig{});
+
+        /**
+         * @brief Release the manager; queued remote frees are released with it.
+         */
+        ~RemoteFreeSlabManager() = default;
+
+        /**
+         * @brief Allocate from the owner's manager after taking back the remote frees of the target class.
+         *
+         * Must be called by the owner.
+         *
+         * @return Pointer to the allocated memory, or nullptr under the same conditions as `SlabManager::Allocate()`.
+         * @throws std::invalid_argument If `size` is zero, or if `alignment` is zero or not a power of 2.
+         */
+        void *Allocate(std::size_t size, std::size_t alignment = sizeof(void *));
+
+        /**
+         * @brief Free memory; directly into the manager on the owner thread, onto the remote-free stack of its class elsewhere.
+         *
+         * Contract:
+         *
+         * - `ptr == nullptr` is allowed and is a no-op.
+         *
+         * - `size` and `alignment` must match the values used at the allocation site.
+         *
+         * - Passing a mismatched `(size, alignment)` pair, a non-owned pointer, or double-freeing a block is a contract violation (undefined behavior).
+         */
+        void Free(void *ptr, std::size_t size, std::size_t alignment);
+
+        /**
+         * @brief Return every queued remote free of every class to the manager.
+         *
+         * Must be called by the owner.
+         *
+         * @return Number of blocks returned.
+         */
+        std::size_t CollectRemoteFrees();
+
+        /**
+         * @brief Make the calling thread the owner.
+         *
+         * Hands the manager to another thread, e.g. one created after the manager. Must not race with any other call.
+         */
+        void TakeOwnership();
+
+        /**
+         * @brief Check whether the calling thread is the owner.
+         */
+        bool IsOwner() const;
+
+        /**
+         * @brief Collect the remote frees, then return fully free pages to the OS (see `SlabManager::Scavenge()`).
+         *
+         * Must be called by the owner.
+         */
+        std::size_t Scavenge(ReleaseAdvice advice = ReleaseAdvice::kDontNeed);
+
+        /**
+         * @brief Snapshot of the manager's counters (see `SlabManager::GetStats()`); queued remote frees still count as in use.
+         */
+        SlabManagerStats GetStats() const;
+
+        // Disable copy semantics for the manager.
+        RemoteFreeSlabManager(const RemoteFreeSlabManager &) = delete;
+        RemoteFreeSlabManager &operator=(const RemoteFreeSlabManager &) = delete;
+
+    private:
+        /**
+         * @brief Queues cover the largest class table, so every `ClassSpacing` fits.
+         */
+        static constexpr std::size_t kNumClasses = SlabManager::kMaxNumClasses;
+
+        /**
+         * @brief Blocks returned to the manager per `FreeBatch()` call while draining a stack.
+         */
+        static constexpr std::size_t kDrainBatchSize = 64;
+
+        /**
+         * @brief Link stored in the first word of a remotely freed block.
+         */
+        struct RemoteBlock
+        {
+            RemoteBlock *next;
+        };
+
+        SlabManager manager_;
+        std::thread::id owner_;
+
+        /**
+         * @brief Whether the manager has an over-aligned tier; its blocks share the sizeless queue with large blocks.
+         */
+        const bool over_aligned_;
+
+        /**
+         * @brief Remote-free stack of each size class, plus one at index `kNumClasses` for blocks freed without a size:
+         *        large-object and over-aligned blocks.
+         *
+         * On their own cache lines, away from the owner-only members above.
+         */
+        alignas(64) std::array<std::atomic<RemoteBlock *>, kNumClasses + 1> remote_{};
+
+        /**
+         * @brief Remote-free stack of a request; uses the same routing as `SlabManager`.
+         */
+        std::size_t QueueFor(std::size_t size, std::size_t alignment) const;
+
+        /**
+         * @brief Take the whole remote-free stack at `queue` and return its blocks to the manager.
+         *
+         * @return Number of blocks returned.
+         */
+        std::size_t Drain(std::size_t queue);
+    };
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef MCR_SCAVENGER_H_
+
+#define MCR_SCAVENGER_H_
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace mcr
+{
+    /**
+     * @brief Background thread that periodically runs a scavenge pass.
+     *
+     * Typically wraps `ThreadCachedSlabManager::Scavenge()`, which is safe to call concurrently with
+     * allocation. Single-threaded allocators must not be scavenged from here.
+     *
+     * Notes:
+     *
+     * - The first pass runs one `interval` after construction.
+     *
+     * - Destruction wakes the thread and joins it; a pass in progress finishes first.
+     */
+    class Scavenger
+    {
+    public:
+        /**
+         * @brief Start the background thread.
+         *
+         * @param scavenge One scavenge pass; returns the number of bytes handed back to the OS.
+         * @param interval Delay between passes; must be positive.
+         * @throws std::invalid_argument If `scavenge` is empty or `interval` is not positive.
+         * @throws std::system_error If the thread cannot be started.
+         */
+        Scavenger(std::function<std::size_t()> scavenge, std::chrono::milliseconds interval);
+
+        /**
+         * @brief Stop and join the background thread.
+         */
+        ~Scavenger();
+
+        /**
+         * @brief Total bytes handed back to the OS by all completed passes.
+         */
+        std::size_t ReleasedBytes() const;
+
+        /**
+         * @brief Number of completed passes.
+         */
+        std::size_t Passes() const;
+
+        // Disable copy semantics for the owning thread.
+        Scavenger(const Scavenger &) = delete;
+        Scavenger &operator=(const Scavenger &) = delete;
+
+    private:
+        std::function<std::size_t()> scavenge_;
+        const std::chrono::milliseconds interval_;
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        bool stopping_ = false;
+
+        std::atomic<std::size_t> released_bytes_{0};
+        std::atomic<std::size_t> passes_{0};
+
+        /**
+         * @brief Started last, so every member it reads is already initialized.
+         */
+        std::thread thread_;
+
+        void Run();
+    };
+}
+
+#endif
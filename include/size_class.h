@@ -0,0 +1,314 @@
+#ifndef MCR_SIZE_CLASS_H_
+
+#define MCR_SIZE_CLASS_H_
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+#include <array>
+
+namespace mcr
+{
+    /**
+     * @brief Compute `floor(log2(value))` for a non-zero value.
+     *
+     * Usable in constant expressions, so compile-time class tables and runtime routing share one implementation.
+     */
+    constexpr unsigned FloorLog2(std::size_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63u - static_cast<unsigned>(__builtin_clzll(static_cast<unsigned long long>(value)));
+#else
+        // MSVC's bit-scan intrinsics are not constexpr in C++17; the optimizer reduces this loop to a bit scan.
+        unsigned log2 = 0;
+        while (value >>= 1)
+        {
+            log2++;
+        }
+        return log2;
+#endif
+    }
+
+    /**
+     * @brief Index of the lowest set bit of a non-zero word.
+     */
+    constexpr unsigned CountTrailingZeros(std::uint64_t value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(static_cast<unsigned long long>(value)));
+#else
+        unsigned zeros = 0;
+        while ((value & 1u) == 0)
+        {
+            value >>= 1;
+            zeros++;
+        }
+        return zeros;
+#endif
+    }
+
+    /**
+     * @brief Compile-time table of power-of-2 size classes `MinClassSize, 2 * MinClassSize, ..., MaxClassSize`.
+     *
+     * Each class is aligned to its own size, so a class satisfies any alignment up to its size.
+     *
+     * @tparam MinClassSize Smallest class; requests below it are rounded up to it.
+     * @tparam MaxClassSize Largest class; requests above it fall outside the table.
+     */
+    template <std::size_t MinClassSize, std::size_t MaxClassSize>
+    struct PowerOfTwoClasses
+    {
+        static_assert(MinClassSize >= sizeof(void *) && (MinClassSize & (MinClassSize - 1)) == 0, "MinClassSize must be a power of 2 no smaller than a pointer.");
+        static_assert(MaxClassSize >= MinClassSize && (MaxClassSize & (MaxClassSize - 1)) == 0, "MaxClassSize must be a power of 2 no smaller than MinClassSize.");
+
+        /**
+         * @brief Smallest managed size class.
+         *
+         * Requests below this size are rounded up to the minimum class size.
+         */
+        static constexpr std::size_t kMinClassSize = MinClassSize;
+
+        /**
+         * @brief Largest managed size class.
+         *
+         * Requests above this size fall outside the range handled by the table.
+         */
+        static constexpr std::size_t kMaxClassSize = MaxClassSize;
+
+        /**
+         * @brief Number of managed size classes.
+         */
+        static constexpr std::size_t kNumClasses = FloorLog2(MaxClassSize) - FloorLog2(MinClassSize) + 1;
+
+        /**
+         * @brief Block size of the class at `index`.
+         */
+        static constexpr std::size_t ClassSize(std::size_t index)
+        {
+            return kMinClassSize << index;
+        }
+
+        /**
+         * @brief Alignment guaranteed by the class at `index`.
+         */
+        static constexpr std::size_t ClassAlignment(std::size_t index)
+        {
+            return ClassSize(index);
+        }
+
+        /**
+         * @brief Routing key of a valid request: `max(size, alignment)` (see ADR 0002).
+         */
+        static constexpr std::size_t RoutingKey(std::size_t size, std::size_t alignment)
+        {
+            return size > alignment ? size : alignment;
+        }
+
+        /**
+         * @brief Compute the size class index for a routing key in `[1, kMaxClassSize]`.
+         *
+         * `floor(log2(key - 1)) + 1` is `ceil(log2(key))`, so exact powers of 2 stay in their own class.
+         * OR-ing in `kMinClassSize - 1` folds every key up to the minimum class into class 0 without a branch.
+         */
+        static constexpr std::size_t ClassIndex(std::size_t key)
+        {
+            return FloorLog2((key - 1) | (kMinClassSize - 1)) + 1 - FloorLog2(kMinClassSize);
+        }
+    };
+
+    /**
+     * @brief Compile-time table of geometrically spaced size classes with table-driven routing.
+     *
+     * Every doubling `(2^k, 2^(k+1)]` between `MinClassSize` and `MaxClassSize` is split into
+     * `StepsPerDoubling` classes, with a floor of 16 bytes between neighbours. With 4 steps the
+     * classes are 16, 32, 48, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, ... so a 260-byte
+     * request takes a 320-byte block instead of a 512-byte one.
+     *
+     * Notes:
+     *
+     * - Every class size is a multiple of 16, so a lookup table indexed by `(key + 15) >> 4` maps a
+     *   routing key to its class exactly. The table has `MaxClassSize / 16 + 1` one-byte entries.
+     *
+     * - A class is aligned to the largest power of 2 dividing its size (its natural alignment).
+     *
+     * - The routing key is `size` rounded up to `alignment`. Each doubling contains every multiple of
+     *   its step, so that key always selects a class whose natural alignment covers the request.
+     *   For power-of-2 classes this selects the same class as `max(size, alignment)`.
+     *
+     * @tparam MinClassSize Smallest class; a power of 2 no smaller than 16.
+     * @tparam MaxClassSize Largest class; a power of 2.
+     * @tparam StepsPerDoubling Classes per doubling; a power of 2.
+     */
+    template <std::size_t MinClassSize, std::size_t MaxClassSize, std::size_t StepsPerDoubling = 4>
+    struct GeometricClasses
+    {
+        static_assert(MinClassSize >= 16 && (MinClassSize & (MinClassSize - 1)) == 0, "MinClassSize must be a power of 2 no smaller than 16.");
+        static_assert(MaxClassSize >= MinClassSize && (MaxClassSize & (MaxClassSize - 1)) == 0, "MaxClassSize must be a power of 2 no smaller than MinClassSize.");
+        static_assert(StepsPerDoubling > 0 && (StepsPerDoubling & (StepsPerDoubling - 1)) == 0, "StepsPerDoubling must be a power of 2.");
+
+        /**
+         * @brief Granularity of the routing lookup table.
+         */
+        static constexpr std::size_t kLookupGranule = 16;
+
+        static constexpr std::size_t kMinClassSize = MinClassSize;
+        static constexpr std::size_t kMaxClassSize = MaxClassSize;
+
+    private:
+        /**
+         * @brief Distance between neighbouring classes in the doubling that starts at `base`.
+         */
+        static constexpr std::size_t StepFor(std::size_t base)
+        {
+            return (base / StepsPerDoubling > kLookupGranule) ? base / StepsPerDoubling : kLookupGranule;
+        }
+
+        static constexpr std::size_t CountClasses()
+        {
+            std::size_t count = 1; // MinClassSize itself.
+            for (std::size_t base = MinClassSize; base < MaxClassSize; base *= 2)
+            {
+                count += base / StepFor(base);
+            }
+            return count;
+        }
+
+    public:
+        /**
+         * @brief Number of managed size classes.
+         */
+        static constexpr std::size_t kNumClasses = CountClasses();
+        static_assert(kNumClasses <= 256, "Class indices must fit the one-byte lookup entries.");
+
+    private:
+        static constexpr std::array<std::size_t, kNumClasses> BuildClassSizes()
+        {
+            std::array<std::size_t, kNumClasses> sizes{};
+            std::size_t index = 0;
+            sizes[index++] = MinClassSize;
+            for (std::size_t base = MinClassSize; base < MaxClassSize; base *= 2)
+            {
+                for (std::size_t size = base + StepFor(base); size <= base * 2; size += StepFor(base))
+                {
+                    sizes[index++] = size;
+                }
+            }
+            return sizes;
+        }
+
+        static constexpr std::array<std::size_t, kNumClasses> kClassSizes = BuildClassSizes();
+
+        static constexpr std::array<std::uint8_t, MaxClassSize / kLookupGranule + 1> BuildLookup()
+        {
+            std::array<std::uint8_t, MaxClassSize / kLookupGranule + 1> lookup{};
+            std::size_t class_idx = 0;
+            for (std::size_t slot = 0; slot < lookup.size(); slot++)
+            {
+                // Slot `n` covers keys `(16 * (n - 1), 16 * n]`; all of them fit the first class of size >= 16 * n.
+                while (kClassSizes[class_idx] < slot * kLookupGranule)
+                {
+                    class_idx++;
+                }
+                lookup[slot] = static_cast<std::uint8_t>(class_idx);
+            }
+            return lookup;
+        }
+
+        static constexpr std::array<std::uint8_t, MaxClassSize / kLookupGranule + 1> kLookup = BuildLookup();
+
+    public:
+        /**
+         * @brief Block size of the class at `index`.
+         */
+        static constexpr std::size_t ClassSize(std::size_t index)
+        {
+            return kClassSizes[index];
+        }
+
+        /**
+         * @brief Alignment guaranteed by the class at `index`: the largest power of 2 dividing its size.
+         */
+        static constexpr std::size_t ClassAlignment(std::size_t index)
+        {
+            return kClassSizes[index] & (~kClassSizes[index] + 1);
+        }
+
+        /**
+         * @brief Routing key of a valid request: `size` rounded up to a multiple of `alignment`.
+         *
+         * Requires `size <= kMaxClassSize`, so the round-up cannot overflow.
+         */
+        static constexpr std::size_t RoutingKey(std::size_t size, std::size_t alignment)
+        {
+            return (size + alignment - 1) & ~(alignment - 1);
+        }
+
+        /**
+         * @brief Compute the size class index for a routing key in `[1, kMaxClassSize]` with one table load.
+         */
+        static constexpr std::size_t ClassIndex(std::size_t key)
+        {
+            return kLookup[(key + kLookupGranule - 1) >> 4];
+        }
+    };
+
+    /**
+     * @brief Power-of-2 small-object size-class policy shared by the runtime slab managers.
+     *
+     * Notes:
+     *
+     * - Managed classes are 16, 32, 64, 128, 256, 512 and 1024 bytes.
+     *
+     * - The routing key of a request is `max(size, alignment)` (see ADR 0002).
+     *
+     * - Routing is kept inline because it sits on every manager fast path.
+     */
+    struct SizeClassPolicy : PowerOfTwoClasses<16, 1024>
+    {
+        /**
+         * @brief Validate a request and compute its routing key.
+         *
+         * @return `max(size, alignment)`.
+         * @throws std::invalid_argument If `size` is zero, or if `alignment` is zero or not a power of 2.
+         */
+        static std::size_t RoutingKey(std::size_t size, std::size_t alignment)
+        {
+            if (size == 0)
+            {
+                throw std::invalid_argument("Size must be non-zero.");
+            }
+
+            if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+            {
+                throw std::invalid_argument("Alignment must be non-zero and a power of 2.");
+            }
+
+            return std::max(size, alignment); // Ensure the target block size could satisfy both size and alignment.
+        }
+
+        /**
+         * @brief Compute the size class index for a routing key.
+         *
+         * Maps size classes to indices: 16 -> 0, 32 -> 1, 64 -> 2, 128 -> 3, 256 -> 4, 512 -> 5, 1024 -> 6.
+         *
+         * @throws std::invalid_argument If `size` exceeds `kMaxClassSize`.
+         */
+        static std::size_t ClassIndex(std::size_t size)
+        {
+            if (size > kMaxClassSize)
+            {
+                throw std::invalid_argument("Size exceeds maximum managed class size.");
+            }
+            return PowerOfTwoClasses::ClassIndex(size);
+        }
+    };
+
+    /**
+     * @brief Geometric small-object class table selectable in `SlabManager` (see `ClassSpacing::kGeometric`).
+     *
+     * Same range as `SizeClassPolicy` with four classes per doubling: 20 classes from 16 to 1024 bytes.
+     */
+    using GeometricClassPolicy = GeometricClasses<16, 1024, 4>;
+}
+
+#endif
@@ -1,10 +1,98 @@
 #ifndef MCR_SLAB_ALLOCATOR_H_
 
 #define MCR_SLAB_ALLOCATOR_H_
+#include "pool_memory.h"
 #include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Per-class allocation counters; set through the `MCR_ENABLE_STATS` CMake option so the library and its users agree.
+#ifndef MCR_ENABLE_STATS
+#define MCR_ENABLE_STATS 0
+#endif
 
 namespace mcr
 {
+    /**
+     * @brief Whether allocation counters are compiled in (`MCR_ENABLE_STATS`).
+     */
+    inline constexpr bool kStatsEnabled = MCR_ENABLE_STATS != 0;
+
+    /**
+     * @brief Usage counters of one `SlabAllocator` (one size class of a manager).
+     *
+     * `block_size` and `capacity` are always reported; the counters stay zero unless `kStatsEnabled`.
+     */
+    struct SlabStats
+    {
+        /**
+         * @brief Effective block size in bytes.
+         */
+        std::size_t block_size = 0;
+
+        /**
+         * @brief Blocks in the initial pool and all grown slabs.
+         */
+        std::size_t capacity = 0;
+
+        /**
+         * @brief Blocks currently handed out.
+         */
+        std::size_t in_use = 0;
+
+        /**
+         * @brief Highest value `in_use` has reached; the capacity the class actually needed.
+         */
+        std::size_t peak_in_use = 0;
+
+        /**
+         * @brief Total number of blocks handed out.
+         */
+        std::size_t total_allocations = 0;
+
+        /**
+         * @brief Number of `Allocate()` calls that returned nullptr, plus short `AllocateBatch()` calls.
+         */
+        std::size_t failed_allocations = 0;
+    };
+
+    /**
+     * @brief How a `SlabAllocator` adds slabs once its blocks run out.
+     */
+    enum class SlabGrowth
+    {
+        /**
+         * @brief Fixed capacity; `Allocate()` returns nullptr once the initial pool is exhausted.
+         */
+        kNone,
+
+        /**
+         * @brief Each new slab has the size of the initial pool.
+         */
+        kLinear,
+
+        /**
+         * @brief Each new slab is twice the size of the previous one.
+         */
+        kGeometric,
+    };
+
+    /**
+     * @brief Growth policy and upper bound of a `SlabAllocator`.
+     */
+    struct SlabGrowthPolicy
+    {
+        SlabGrowth growth = SlabGrowth::kNone;
+
+        /**
+         * @brief Upper bound on the total size of all slabs in bytes.
+         *
+         * A slab that would cross the bound is trimmed to the remaining whole blocks.
+         * Values below the initial pool size leave the allocator at its initial capacity.
+         */
+        std::size_t max_pool_size = 0;
+    };
+
     /**
      * @brief A memory allocator consisting of fixed-size blocks.
      *
@@ -17,9 +105,13 @@ namespace mcr
      *
      * - No per-allocation header is prepended to each block.
      *
-     * - Free-list metadata is maintained via an embedded singly-linked free list.
+     * - Free-list metadata is maintained via an embedded singly-linked free list. Never-used blocks are handed
+     *   out from a bump-pointer frontier instead, so construction is O(1) and a page is first touched when one
+     *   of its blocks is allocated.
      *
-     * - `Allocate()` and `Free()` operate in O(1) time.
+     * - `Allocate()` and `Free()` operate in O(1) time. With a growth policy, `Allocate()` is amortized O(1):
+     *   an exhausted allocator chains one more slab and moves the frontier into it. Blocks of every slab are recycled
+     *   through the same free list, so `Free()` never needs to find the owning slab.
      *
      * - Not thread-safe; concurrent use must be synchronized by the caller.
      *
@@ -37,20 +129,36 @@ namespace mcr
          * @param block_size The requested payload size for each block.
          * @param pool_size The requested backing pool size.
          * @param alignment The requested alignment. Must be non-zero and a power of 2.
+         * @param growth How to add slabs after the initial pool is exhausted. The default keeps a fixed capacity.
+         * @param backing Where the pool and grown slabs come from. Page-mapped backings fall back as described in `PoolBacking`.
          * @throws std::invalid_argument If alignment is zero, not a power of 2, or if the pool cannot hold at least one effective block.
          * @throws std::bad_alloc If the backing-pool allocation fails.
          */
-        SlabAllocator(std::size_t block_size, std::size_t pool_size, std::size_t alignment = sizeof(void *));
+        SlabAllocator(std::size_t block_size, std::size_t pool_size, std::size_t alignment = sizeof(void *), const SlabGrowthPolicy &growth = SlabGrowthPolicy{}, PoolBacking backing = PoolBacking::kHeap);
+
+        /**
+         * @brief Construct a fixed-capacity allocator over caller-owned memory.
+         *
+         * The allocator never grows and does not release `pool`; the memory must outlive the allocator.
+         * Because blocks are carved lazily, pages of `pool` are touched only when their blocks are first allocated.
+         *
+         * @param block_size The requested payload size for each block.
+         * @param pool Start of the memory; must be aligned to the effective alignment.
+         * @param pool_size Size of the memory at `pool`.
+         * @param alignment The requested alignment. Must be non-zero and a power of 2.
+         * @throws std::invalid_argument If `pool` is null or misaligned, if alignment is zero or not a power of 2, or if the memory cannot hold at least one effective block.
+         */
+        SlabAllocator(std::size_t block_size, void *pool, std::size_t pool_size, std::size_t alignment);
 
         /**
-         * @brief Destroy the allocator and release its backing pool.
+         * @brief Destroy the allocator and release its backing pool and every grown slab.
          */
         ~SlabAllocator();
 
         /**
          * @brief Allocate a memory block from the backing pool.
          *
-         * @return pointer to the allocated memory, or nullptr if the pool is exhausted.
+         * @return pointer to the allocated memory, or nullptr if the pool is exhausted and cannot grow any further.
          */
         void *Allocate();
 
@@ -69,6 +177,75 @@ namespace mcr
          */
         void Free(void *ptr);
 
+        /**
+         * @brief Allocate up to `count` blocks in one call.
+         *
+         * Detaches a prefix of the free list instead of popping block by block through `Allocate()`;
+         * grows the allocator as needed under its growth policy.
+         *
+         * @param count Number of blocks requested.
+         * @param out Array of at least `count` entries receiving the blocks.
+         * @return Number of blocks written to `out`; less than `count` only if the pool is exhausted and cannot grow any further.
+         */
+        std::size_t AllocateBatch(std::size_t count, void **out);
+
+        /**
+         * @brief Return `count` blocks to the backing pool in one call.
+         *
+         * Links the blocks into one segment and splices it onto the free list with a single head update.
+         * `ptrs[0]` becomes the next block handed out.
+         *
+         * Contract:
+         *
+         * - Same as `Free()` for every entry; null entries are skipped.
+         *
+         * @param ptrs Array of `count` blocks to be freed.
+         * @param count Number of entries in `ptrs`.
+         */
+        void FreeBatch(void *const *ptrs, std::size_t count);
+
+        /**
+         * @brief Backing actually used for the initial pool, after any fallback.
+         */
+        PoolBacking Backing() const;
+
+        /**
+         * @brief Return the physical pages of fully free memory to the OS.
+         *
+         * Memory is scanned in page-aligned units of `lcm(page size, block size)`. A unit whose blocks are
+         * all on the free list is unlinked from it, released with `advice`, and queued for reuse. Once the
+         * free list and the frontier run dry, `Allocate()` carves queued units before growing, and their pages
+         * re-fault on first touch.
+         *
+         * Notes:
+         *
+         * - O(free blocks * log(slabs)); meant for idle time, never runs on the `Allocate()`/`Free()` fast path.
+         *
+         * - Units larger than `kMaxScavengeUnitPages` pages (block sizes sharing few factors with the page size) are not scavenged.
+         *
+         * @param advice How the pages are handed back (see `ReleaseAdvice`).
+         * @return Number of bytes handed back to the OS by this call.
+         * @throws std::bad_alloc If the temporary bookkeeping cannot be allocated; the allocator is left unchanged.
+         */
+        std::size_t Scavenge(ReleaseAdvice advice = ReleaseAdvice::kDontNeed);
+
+        /**
+         * @brief Bytes released by `Scavenge()` that have not been handed out again.
+         *
+         * Units whose release failed (e.g. locked pages) are not counted, like `Scavenge()`'s return value.
+         */
+        std::size_t ReleasedBytes() const;
+
+        /**
+         * @brief Largest scavenging unit, in pages.
+         */
+        static constexpr std::size_t kMaxScavengeUnitPages = 64;
+
+        /**
+         * @brief Snapshot of the usage counters (see `SlabStats`).
+         */
+        SlabStats GetStats() const;
+
         // ---------------------------------------------------------------
         // Disable copy semantics for the owning allocator.
         SlabAllocator(const SlabAllocator &) = delete;
@@ -85,18 +262,132 @@ namespace mcr
         };
 
         std::size_t block_size_;
+
+        /**
+         * @brief Total size of the initial pool and all grown slabs.
+         */
         std::size_t pool_size_;
         std::size_t alignment_;
 
         /**
-         * @brief Start address of the backing pool allocated by the underlying allocator/system.
+         * @brief Backing pool allocated by the underlying allocator/system.
          */
-        void *pool_start_;
+        PoolRegion pool_;
 
         /**
-         * @brief Head of the free list; the block to be allocated next.
+         * @brief Requested backing of the pool and of every grown slab.
+         */
+        PoolBacking backing_;
+
+        /**
+         * @brief false if the pool is caller-owned memory.
+         */
+        bool owns_pool_;
+
+        /**
+         * @brief Head of the free list of recycled blocks; preferred over the frontier because it is cache-hot.
          */
         FreeBlock *free_list_head_;
+
+        /**
+         * @brief Next never-used block of the newest slab.
+         */
+        std::uintptr_t frontier_;
+
+        /**
+         * @brief End of the newest slab; the frontier is exhausted once it reaches this address.
+         */
+        std::uintptr_t frontier_end_;
+
+        SlabGrowthPolicy growth_;
+
+        /**
+         * @brief Size of the initial pool; the slab size for linear growth.
+         */
+        std::size_t initial_slab_size_;
+
+        /**
+         * @brief Size of the most recent slab; doubled for geometric growth.
+         */
+        std::size_t last_slab_size_;
+
+        /**
+         * @brief Slabs chained after the initial pool.
+         */
+        std::vector<PoolRegion> grown_slabs_;
+
+        /**
+         * @brief Page-aligned units released by `Scavenge()`, waiting to be carved through the frontier again.
+         */
+        std::vector<std::uintptr_t> released_units_;
+
+        /**
+         * @brief Fully free units `Scavenge()` unlinked but could not release; their pages are still committed.
+         */
+        std::vector<std::uintptr_t> retained_units_;
+
+#if MCR_ENABLE_STATS
+        /**
+         * @brief Plain counters; the allocator is single-threaded, so callers that share it already serialize updates.
+         *
+         * `in_use` is derived as allocations minus frees. It peaks right before a free, so the high-water mark is
+         * folded in there and in `GetStats()`, keeping `Allocate()` at a single increment.
+         */
+        std::size_t stats_allocations_ = 0;
+        std::size_t stats_frees_ = 0;
+        std::size_t stats_peak_in_use_ = 0;
+        std::size_t stats_failed_allocations_ = 0;
+#endif
+
+        /**
+         * @brief Count `count` handed-out blocks; compiles to nothing unless `MCR_ENABLE_STATS`.
+         */
+        void CountAllocations([[maybe_unused]] std::size_t count)
+        {
+#if MCR_ENABLE_STATS
+            stats_allocations_ += count;
+#endif
+        }
+
+        void CountFrees([[maybe_unused]] std::size_t count)
+        {
+#if MCR_ENABLE_STATS
+            const std::size_t in_use = stats_allocations_ - stats_frees_;
+            stats_peak_in_use_ = (in_use > stats_peak_in_use_) ? in_use : stats_peak_in_use_;
+            stats_frees_ += count;
+#endif
+        }
+
+        void CountFailure()
+        {
+#if MCR_ENABLE_STATS
+            stats_failed_allocations_++;
+#endif
+        }
+
+        /**
+         * @brief Hand out the blocks of a new slab through the frontier.
+         */
+        void SetFrontier(void *slab, std::size_t slab_size);
+
+        /**
+         * @brief Point the exhausted frontier at a released unit, or at a new slab if none is queued.
+         *
+         * @return false if no unit is queued and the allocator cannot grow.
+         */
+        bool RefillFrontier();
+
+        /**
+         * @brief `lcm(page size, block size)`, or 0 if it exceeds `kMaxScavengeUnitPages` pages.
+         */
+        std::size_t ScavengeUnitSize() const;
+
+        /**
+         * @brief Chain one more slab according to the growth policy.
+         *
+         * @return false if the policy or the upper bound does not allow another block, or if the system allocation fails.
+         */
+        bool Grow();
     };
 }
 
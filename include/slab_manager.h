@@ -2,24 +2,254 @@
 
 #define MCR_SLAB_MANAGER_H_
 #include "slab_allocator.h"
+#include "bitmap_slab_allocator.h"
+#include "buddy_allocator.h"
+#include "size_class.h"
 #include <cstddef>
+#include <cstdint>
+#include <algorithm>
 #include <array>
 #include <memory>
+#include <stdexcept>
+#include <vector>
 
 namespace mcr
 {
     /**
-     * @brief Manages multiple `SlabAllocator` for power-of-2 size classes.
+     * @brief Spacing of the small-object size classes of a `SlabManager`.
+     */
+    enum class ClassSpacing
+    {
+        /**
+         * @brief 16, 32, ..., 1024 bytes (`SizeClassPolicy`); the routing key is `max(size, alignment)`.
+         */
+        kPowerOfTwo,
+
+        /**
+         * @brief Four classes per doubling from 16 to 1024 bytes (`GeometricClassPolicy`), routed by one table load.
+         *
+         * Bounds internal waste to 25% instead of 50%, e.g. a 260-byte request takes 320 bytes instead of 512.
+         */
+        kGeometric,
+    };
+
+    /**
+     * @brief Per-class capacity and growth configuration of a slab manager.
+     */
+    struct SlabManagerConfig
+    {
+        /**
+         * @brief Default number of blocks pre-allocated for each size class.
+         */
+        static constexpr std::size_t kDefaultBlocksPerClass = 100;
+
+        /**
+         * @brief Blocks pre-allocated for each size class at construction.
+         */
+        std::size_t blocks_per_class = kDefaultBlocksPerClass;
+
+        /**
+         * @brief How an exhausted size class grows. The default keeps every class at `blocks_per_class`.
+         */
+        SlabGrowth growth = SlabGrowth::kNone;
+
+        /**
+         * @brief Upper bound on the blocks of one size class, including grown slabs. Only used when growth is enabled.
+         */
+        std::size_t max_blocks_per_class = kDefaultBlocksPerClass;
+
+        /**
+         * @brief Default largest request served by the large-object region.
+         */
+        static constexpr std::size_t kDefaultMaxLargeBlockSize = std::size_t{1} << 20;
+
+        /**
+         * @brief Bytes reserved for the buddy region serving requests above the largest size class. 0 disables the large-object path.
+         */
+        std::size_t large_region_size = 0;
+
+        /**
+         * @brief Largest request served by the large-object region; a power of 2 above the largest size class.
+         */
+        std::size_t max_large_block_size = kDefaultMaxLargeBlockSize;
+
+        /**
+         * @brief Blocks of each size class reserved for over-aligned requests. 0 routes them by alignment instead.
+         *
+         * A request is over-aligned when its alignment exceeds the class of its size (up to
+         * `BitmapSlabAllocator::kMaxSpanAlignment`), e.g. 64 bytes aligned to 512. It then takes a block of its own
+         * size class that starts on an alignment boundary, instead of a block of the alignment's class. One
+         * aligned block may strand up to `alignment / block_size - 1` blocks in front of it until smaller alignments
+         * fill them, so size this for the alignments in use. Only `SlabManager` and `RemoteFreeSlabManager` use it.
+         */
+        std::size_t over_aligned_blocks_per_class = 0;
+
+        /**
+         * @brief Size-class table of the small-object tier.
+         *
+         * `ClassSpacing::kGeometric` needs `over_aligned_blocks_per_class == 0`, since over-aligned pools need
+         * power-of-2 block sizes. Only `SlabManager` and `RemoteFreeSlabManager` use it.
+         */
+        ClassSpacing class_spacing = ClassSpacing::kPowerOfTwo;
+
+        /**
+         * @brief Where the class pools and the large-object region come from (see `PoolBacking`).
+         */
+        PoolBacking backing = PoolBacking::kHeap;
+
+        /**
+         * @brief Carve every size class out of one reserved region so `Free(ptr)` and `Owns(ptr)` work without a size.
+         *
+         * Each class gets a fixed power-of-2 span holding its full capacity (`max_blocks_per_class` with growth,
+         * `blocks_per_class` otherwise); classes never chain slabs in this mode. The region is page-mapped even
+         * with `PoolBacking::kHeap`, and pages are committed only as blocks are first handed out.
+         */
+        bool contiguous_arena = false;
+    };
+
+    /**
+     * @brief One reserved region holding every size class at a fixed power-of-2 stride.
+     *
+     * Class `i` starts at `base + i * span`; the class of an address is `(address - base) >> log2(span)`.
+     */
+    class ClassArena
+    {
+    public:
+        /**
+         * @brief Reserve `num_classes * class_span` bytes aligned to `class_span`.
+         *
+         * @param class_span Bytes per class; a power of 2.
+         * @throws std::invalid_argument If `class_span` is not a power of 2 or the region size overflows.
+         * @throws std::bad_alloc If the reservation fails.
+         */
+        ClassArena(std::size_t class_span, std::size_t num_classes, PoolBacking backing);
+
+        /**
+         * @brief Release the region; the class allocators carved from it must already be destroyed.
+         */
+        ~ClassArena();
+
+        void *ClassStart(std::size_t class_idx) const
+        {
+            return static_cast<char *>(region_.start) + (class_idx << span_log2_);
+        }
+
+        std::size_t ClassSpan() const
+        {
+            return std::size_t{1} << span_log2_;
+        }
+
+        /**
+         * @brief Check whether `ptr` lies inside the arena.
+         */
+        bool Owns(const void *ptr) const
+        {
+            // Addresses below the base wrap around to large offsets.
+            return reinterpret_cast<std::uintptr_t>(ptr) - reinterpret_cast<std::uintptr_t>(region_.start) < size_;
+        }
+
+        /**
+         * @brief Size class of a pointer owned by the arena.
+         */
+        std::size_t ClassOf(const void *ptr) const
+        {
+            return (reinterpret_cast<std::uintptr_t>(ptr) - reinterpret_cast<std::uintptr_t>(region_.start)) >> span_log2_;
+        }
+
+        // Disable copy semantics for the owning arena.
+        ClassArena(const ClassArena &) = delete;
+        ClassArena &operator=(const ClassArena &) = delete;
+
+    private:
+        PoolRegion region_;
+        unsigned span_log2_;
+
+        /**
+         * @brief Bytes covered by the classes; `region_.size` may be larger after page rounding.
+         */
+        std::size_t size_;
+    };
+
+    /**
+     * @brief Create the class arena of a manager configuration, or nullptr if `contiguous_arena` is off.
+     *
+     * The span is the smallest power of 2 that holds the full capacity of the largest class.
+     *
+     * @throws std::invalid_argument If the configuration is invalid (see `MakeSizeClassAllocator()`) or the arena size overflows.
+     * @throws std::bad_alloc If the reservation fails.
+     */
+    std::unique_ptr<ClassArena> MakeClassArena(std::size_t max_class_size, std::size_t num_classes, const SlabManagerConfig &config);
+
+    /**
+     * @brief Create the allocator of one size class inside its arena span.
+     *
+     * @throws std::invalid_argument If the configuration is invalid (see `MakeSizeClassAllocator()`).
+     */
+    std::unique_ptr<SlabAllocator> MakeArenaClassAllocator(std::size_t block_size, const ClassArena &arena, std::size_t class_idx, const SlabManagerConfig &config);
+
+    /**
+     * @brief Create the large-object allocator of a manager configuration, or nullptr if `large_region_size` is 0.
+     *
+     * Blocks start at twice the largest size class and go up to `max_large_block_size`.
+     *
+     * @throws std::invalid_argument If `max_large_block_size` is not a power of 2 above `max_class_size`.
+     * @throws std::bad_alloc If reserving the region fails.
+     */
+    std::unique_ptr<BuddyAllocator> MakeLargeObjectAllocator(std::size_t max_class_size, const SlabManagerConfig &config);
+
+    /**
+     * @brief Create the allocator of one size class under a manager configuration.
+     *
+     * Blocks are aligned to the largest power of 2 dividing the block size (the block size itself for power-of-2
+     * classes). The allocator grows by whole initial pools (linear) or doubling slabs (geometric) up to
+     * `max_blocks_per_class` blocks.
+     *
+     * @throws std::invalid_argument If `blocks_per_class` is zero or overflows the pool size, or if growth is enabled and `max_blocks_per_class < blocks_per_class`.
+     * @throws std::bad_alloc If the backing-pool allocation fails.
+     */
+    std::unique_ptr<SlabAllocator> MakeSizeClassAllocator(std::size_t block_size, const SlabManagerConfig &config);
+
+    /**
+     * @brief Usage counters of a slab manager: one entry per size class plus the large-object region.
+     */
+    struct SlabManagerStats
+    {
+        /**
+         * @brief Counters of each size class, indexed like the manager's class table (see `SlabManager::ClassSize()`).
+         */
+        std::vector<SlabStats> classes;
+
+        /**
+         * @brief Block size, capacity and blocks in use of each over-aligned tier pool, indexed like `classes`; empty if the tier is disabled.
+         *
+         * The pools track their blocks in a bitmap, so `in_use` is exact even without `MCR_ENABLE_STATS`; the other counters stay zero.
+         */
+        std::vector<SlabStats> over_aligned;
+
+        /**
+         * @brief Counters of the large-object region; all zero if it is disabled.
+         */
+        BuddyStats large{};
+    };
+
+    /**
+     * @brief Manages multiple `SlabAllocator` for power-of-2 or geometric size classes.
      *
      * Routes variable-sized allocation requests to segregated size classes.
      *
      * Notes:
      *
-     * - Requests are routed to the smallest managed size class that satisfies `max(size, alignment)`.
+     * - Requests are routed to the smallest managed size class that satisfies `max(size, alignment)`; with
+     *   `ClassSpacing::kGeometric`, to the smallest class that holds `size` rounded up to `alignment`.
      * 
      * - `Allocate()` and `Free()` must use the same `(size, alignment)` pair so that deallocation routes back to the same size class.
      * 
      * - Size-class routing is O(1).
+     *
+     * - Size classes can grow on demand by chaining slabs (see `SlabManagerConfig`); otherwise each class holds a fixed number of blocks.
+     *
+     * - With `SlabManagerConfig::over_aligned_blocks_per_class`, requests whose alignment exceeds their size class take
+     *   an aligned block of their own class instead (see `IsOverAligned()`).
      */
     class SlabManager
     {
@@ -31,6 +261,14 @@ namespace mcr
          */
         SlabManager();
 
+        /**
+         * @brief Construct the manager with explicit per-class capacity and growth.
+         *
+         * @throws std::invalid_argument If the configuration is invalid (see `MakeSizeClassAllocator()`), or combines `ClassSpacing::kGeometric` with the over-aligned tier.
+         * @throws std::bad_alloc If a backing-pool allocation fails.
+         */
+        explicit SlabManager(const SlabManagerConfig &config);
+
         /**
          * @brief Destroy the manager and release its managed allocators.
          */
@@ -41,7 +279,7 @@ namespace mcr
          *
          * @param size The requested memory size.
          * @param alignment The requested alignment. Must be non-zero and a power of 2. The same alignment must be supplied to `Free()` for symmetric routing.
-         * @return Pointer to the allocated memory, or nullptr if the target size class is exhausted or if `max(size, alignment)` exceeds the maximum managed class size.
+         * @return Pointer to the allocated memory, or nullptr if the target size class or the large-object region is exhausted, or if the request exceeds every configured tier.
          * @throws std::invalid_argument If `size` is zero, or if `alignment` is zero or not a power of 2.
          */
         void *Allocate(std::size_t size, std::size_t alignment = sizeof(void *));
@@ -67,46 +305,189 @@ namespace mcr
          */
         void Free(void *ptr, std::size_t size, std::size_t alignment);
 
+        /**
+         * @brief Resize an allocation, moving it only when its size class or large block no longer fits.
+         *
+         * Returns `ptr` unchanged when `max(new_size, alignment)` routes to the same size class as the old request.
+         * Blocks of the large-object region are resized in place when their buddies allow it (see `BuddyAllocator::Resize()`).
+         * Otherwise a new block is allocated, the first `min(old_size, new_size)` bytes are copied and the old block is freed.
+         *
+         * Contract:
+         *
+         * - `ptr == nullptr` behaves like `Allocate(new_size, alignment)`.
+         *
+         * - `old_size` and `alignment` must match the values used at the allocation site; afterwards the result is freed with `(new_size, alignment)`.
+         *
+         * @return Pointer to the resized memory, or nullptr if a move was needed and the new tier is exhausted; `ptr` then stays valid with its old size.
+         * @throws std::invalid_argument If `new_size` is zero, or if `alignment` is zero or not a power of 2.
+         */
+        void *Reallocate(void *ptr, std::size_t old_size, std::size_t new_size, std::size_t alignment = sizeof(void *));
+
+        /**
+         * @brief Free memory without its request size, finding the owner from the address alone.
+         *
+         * Small blocks need `SlabManagerConfig::contiguous_arena`: the class is `(ptr - base) >> log2(span)`.
+         * Large blocks are found in the large-object region and over-aligned blocks by a range check per class.
+         * Runs in O(1) with no per-allocation header.
+         *
+         * Contract:
+         *
+         * - `ptr == nullptr` is allowed and is a no-op.
+         *
+         * - Double-freeing a block or passing an interior pointer is a contract violation (undefined behavior).
+         *
+         * @throws std::invalid_argument If `ptr` is not owned by the arena, the large-object region or the over-aligned tier (see `Owns()`).
+         */
+        void Free(void *ptr);
+
+        /**
+         * @brief Check whether `ptr` lies in memory that `Free(ptr)` can route: the class arena, the large-object region or the over-aligned tier.
+         *
+         * Always false for small blocks without `SlabManagerConfig::contiguous_arena`.
+         */
+        bool Owns(const void *ptr) const;
+
+        /**
+         * @brief Allocate up to `count` blocks of one `(size, alignment)` request, routing once for the whole batch.
+         *
+         * @param count Number of blocks requested.
+         * @param out Array of at least `count` entries receiving the blocks.
+         * @param size The requested memory size of every block.
+         * @param alignment The requested alignment of every block. Must be non-zero and a power of 2.
+         * @return Number of blocks written to `out`; less than `count` if the target tier is exhausted, 0 if the request exceeds every configured tier.
+         * @throws std::invalid_argument If `size` is zero, or if `alignment` is zero or not a power of 2.
+         */
+        std::size_t AllocateBatch(std::size_t count, void **out, std::size_t size, std::size_t alignment = sizeof(void *));
+
+        /**
+         * @brief Free `count` blocks of one `(size, alignment)` request, routing once for the whole batch.
+         *
+         * Same contract as `Free()` for every entry; null entries are skipped.
+         */
+        void FreeBatch(void *const *ptrs, std::size_t count, std::size_t size, std::size_t alignment);
+
+        /**
+         * @brief Return fully free pages of every size class to the OS (see `SlabAllocator::Scavenge()`).
+         *
+         * The large-object region is not scavenged.
+         *
+         * @return Number of bytes handed back to the OS.
+         */
+        std::size_t Scavenge(ReleaseAdvice advice = ReleaseAdvice::kDontNeed);
+
+        /**
+         * @brief Usage counters of the large-object region; all zero if it is disabled.
+         */
+        BuddyStats GetLargeObjectStats() const;
+
+        /**
+         * @brief Snapshot of the per-class and large-object counters.
+         *
+         * Class counters are only collected when built with `MCR_ENABLE_STATS`; otherwise only `block_size` and
+         * `capacity` are filled in and the hot paths carry no counting code at all. The over-aligned tier is
+         * reported with its capacity and blocks in use either way.
+         */
+        SlabManagerStats GetStats() const;
+
+        /**
+         * @brief Check whether a request is served by the over-aligned tier when it is enabled.
+         *
+         * True when `alignment` exceeds the size class of `size` and is at most `BitmapSlabAllocator::kMaxSpanAlignment`.
+         */
+        static bool IsOverAligned(std::size_t size, std::size_t alignment)
+        {
+            return size != 0 && alignment > size && size <= SizeClassPolicy::kMaxClassSize && alignment <= BitmapSlabAllocator::kMaxSpanAlignment &&
+                   alignment > SizeClassPolicy::ClassSize(SizeClassPolicy::ClassIndex(size));
+        }
+
+        /**
+         * @brief Most size classes any `ClassSpacing` yields.
+         */
+        static constexpr std::size_t kMaxNumClasses = std::max(SizeClassPolicy::kNumClasses, GeometricClassPolicy::kNumClasses);
+
+        /**
+         * @brief Number of size classes of this manager.
+         */
+        std::size_t ClassCount() const
+        {
+            return num_classes_;
+        }
+
+        /**
+         * @brief Block size of the class at `class_idx`.
+         */
+        std::size_t ClassSize(std::size_t class_idx) const
+        {
+            return geometric_ ? GeometricClassPolicy::ClassSize(class_idx) : SizeClassPolicy::ClassSize(class_idx);
+        }
+
+        /**
+         * @brief Size class of a request that is not served by the over-aligned tier.
+         *
+         * @throws std::invalid_argument If `max(size, alignment)` exceeds `SizeClassPolicy::kMaxClassSize`.
+         */
+        std::size_t ClassIndex(std::size_t size, std::size_t alignment) const
+        {
+            if (!geometric_)
+            {
+                return SizeClassPolicy::ClassIndex(std::max(size, alignment));
+            }
+            if (std::max(size, alignment) > GeometricClassPolicy::kMaxClassSize)
+            {
+                throw std::invalid_argument("Size exceeds maximum managed class size.");
+            }
+            return GeometricClassPolicy::ClassIndex(GeometricClassPolicy::RoutingKey(size, alignment));
+        }
+
         // Disable copy semantics for the manager.
         SlabManager(const SlabManager &) = delete;
         SlabManager &operator=(const SlabManager &) = delete;
 
     private:
+        static_assert(SizeClassPolicy::kMaxClassSize == GeometricClassPolicy::kMaxClassSize, "Both spacings must share the large-object boundary.");
+
         /**
-         * @brief Number of managed size classes.
+         * @brief Route by `GeometricClassPolicy` instead of `SizeClassPolicy`.
          */
-        static constexpr std::size_t kNumClasses = 7;
+        bool geometric_;
 
         /**
-         * @brief Smallest managed size class under the current small-object policy.
-         * 
-         * Requests below this size are rounded up to the minimum class size.
+         * @brief Number of managed size classes; the tail of the class arrays is unused.
          */
-        static constexpr std::size_t kMinClassSize = 16;
+        std::size_t num_classes_;
 
         /**
-         * @brief Largest managed size class under the current small-object policy.
-         * 
-         * Requests above this size fall outside the range handled by `SlabManager`.
+         * @brief Region the class allocators are carved from; null unless `contiguous_arena` is set. Declared first so it outlives them.
          */
-        static constexpr std::size_t kMaxClassSize = 1024;
+        std::unique_ptr<ClassArena> arena_;
 
         /**
-         * @brief Pre-allocate 100 blocks for each allocator.
+         * @brief Owns the per-class allocators.
          */
-        static constexpr std::size_t kBlocksPerClass = 100;
+        std::array<std::unique_ptr<SlabAllocator>, kMaxNumClasses> allocators_;
 
         /**
-         * @brief Owns the per-class allocators.
+         * @brief Serves requests above `SizeClassPolicy::kMaxClassSize`; null if the large-object path is disabled.
          */
-        std::array<std::unique_ptr<SlabAllocator>, kNumClasses> allocators_;
+        std::unique_ptr<BuddyAllocator> large_;
 
         /**
-         * @brief Compute the size class index for a given size.
-         *
-         * Maps size classes to indices: 16 -> 0, 32 -> 1, 64 -> 2, 128 -> 3, 256 -> 4, 512 -> 5, 1024 -> 6.
+         * @brief Per-class pools of the over-aligned tier; all null if it is disabled.
+         */
+        std::array<std::unique_ptr<BitmapSlabAllocator>, kMaxNumClasses> over_aligned_;
+
+        /**
+         * @brief Over-aligned tier class serving a request, or `kMaxNumClasses` if the request routes through `ClassIndex()`.
+         */
+        std::size_t OverAlignedClass(std::size_t size, std::size_t alignment) const
+        {
+            return (over_aligned_[0] && IsOverAligned(size, alignment)) ? SizeClassPolicy::ClassIndex(size) : kMaxNumClasses;
+        }
+
+        /**
+         * @brief Over-aligned tier pool that owns `ptr`, or nullptr.
          */
-        std::size_t GetClassIndex(std::size_t size) const;
+        BitmapSlabAllocator *OverAlignedOwner(const void *ptr) const;
     };
 }
 
@@ -0,0 +1,74 @@
+#ifndef MCR_SLAB_MEMORY_RESOURCE_H_
+
+#define MCR_SLAB_MEMORY_RESOURCE_H_
+#include "slab_manager.h"
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+namespace mcr
+{
+    /**
+     * @brief `std::pmr::memory_resource` that serves allocations from a slab manager.
+     *
+     * `do_deallocate()` receives the same `(bytes, alignment)` pair as `do_allocate()`, which is exactly
+     * the deallocation contract of the managers, so no size bookkeeping is needed.
+     *
+     * Notes:
+     *
+     * - The manager must outlive the resource and every container using it.
+     *
+     * - Thread safety follows the manager: use `ThreadCachedSlabManager` for containers shared across threads.
+     *
+     * - There is no upstream fallback: a request the manager cannot serve throws `std::bad_alloc`, because
+     *   deallocation could not tell fallback blocks apart. Configure growth and a large-object region to cover the workload.
+     *
+     * @tparam Manager `SlabManager`, `ThreadCachedSlabManager` or any type with `Allocate(size, alignment)` and `Free(ptr, size, alignment)`.
+     */
+    template <typename Manager>
+    class SlabMemoryResource : public std::pmr::memory_resource
+    {
+    public:
+        explicit SlabMemoryResource(Manager &manager) : manager_(&manager) {}
+
+        Manager &GetManager() const
+        {
+            return *manager_;
+        }
+
+    private:
+        Manager *manager_;
+
+        /**
+         * @brief Zero-byte requests are served as one byte; the managers reject size 0.
+         */
+        static std::size_t RequestSize(std::size_t bytes)
+        {
+            return bytes ? bytes : 1;
+        }
+
+        void *do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            void *ptr = manager_->Allocate(RequestSize(bytes), alignment);
+            if (!ptr)
+            {
+                throw std::bad_alloc();
+            }
+            return ptr;
+        }
+
+        void do_deallocate(void *ptr, std::size_t bytes, std::size_t alignment) override
+        {
+            manager_->Free(ptr, RequestSize(bytes), alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            // Resources over the same manager can free each other's blocks.
+            const SlabMemoryResource *resource = dynamic_cast<const SlabMemoryResource *>(&other);
+            return resource && resource->manager_ == manager_;
+        }
+    };
+}
+
+#endif
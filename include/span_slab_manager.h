@@ -0,0 +1,262 @@
+#ifndef MCR_SPAN_SLAB_MANAGER_H_
+
+#define MCR_SPAN_SLAB_MANAGER_H_
+#include "page_heap.h"
+#include "pool_memory.h"
+#include "size_class.h"
+#include "slab_allocator.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace mcr
+{
+    /**
+     * @brief Memory budget and per-class limits of a `SpanSlabManager`.
+     */
+    struct SpanSlabManagerConfig
+    {
+        static constexpr std::size_t kDefaultHeapSize = std::size_t{16} << 20;
+
+        /**
+         * @brief Global memory budget: bytes of the page heap shared by every size class.
+         */
+        std::size_t heap_size = kDefaultHeapSize;
+
+        /**
+         * @brief Bytes a size class takes from the heap at a time; a power of 2 (see `PageHeap`).
+         */
+        std::size_t span_size = PageHeap::kDefaultSpanSize;
+
+        /**
+         * @brief Most spans one size class may hold at once. 0 limits classes only by the heap budget.
+         *
+         * Individual classes can be limited further with `SpanSlabManager::SetSpanLimit()`.
+         */
+        std::size_t max_spans_per_class = 0;
+
+        /**
+         * @brief Where the page heap comes from (see `PoolBacking`).
+         */
+        PoolBacking backing = PoolBacking::kHeap;
+    };
+
+    /**
+     * @brief Usage counters of a span slab manager: one entry per size class plus the page heap.
+     */
+    struct SpanSlabManagerStats
+    {
+        /**
+         * @brief Counters of each size class, indexed like `SizeClassPolicy::ClassSize()`. `capacity` counts the blocks of the spans the class holds now.
+         */
+        std::array<SlabStats, SizeClassPolicy::kNumClasses> classes{};
+
+        PageHeapStats heap{};
+    };
+
+    /**
+     * @brief Slab manager whose size classes share one `PageHeap` instead of owning private pools.
+     *
+     * A size class takes a span from the heap when all of its spans are full and hands a span back as soon as its
+     * last block is freed, so memory an idle class no longer uses serves whichever class needs it next. Each span
+     * carries its own embedded free list and bump frontier; a per-span table indexed by `PageHeap::SpanIndex()`
+     * records the owning class and the live block count.
+     *
+     * Notes:
+     *
+     * - Uses the same routing policy as `SlabManager`; requests above `SizeClassPolicy::kMaxClassSize` are not served.
+     *
+     * - `Allocate()` and `Free()` are O(1): a class allocates from the head of its list of spans with free blocks, and a
+     *   free finds its span with one subtract and shift. Taking or returning a span is O(1) as well.
+     *
+     * - `Free(ptr)` needs no size, and `Owns(ptr)` is a range check plus a span-table load.
+     *
+     * - A class keeps its last span even when it is empty, so alternating allocate/free at a span boundary does not
+     *   round-trip through the heap; `Scavenge()` returns those spans too.
+     *
+     * - Not thread-safe; concurrent use must be synchronized by the caller.
+     */
+    class SpanSlabManager
+    {
+    public:
+        /**
+         * @brief Reserve the page heap; no class holds a span yet.
+         *
+         * @throws std::invalid_argument If the heap geometry is invalid (see `PageHeap`).
+         * @throws std::bad_alloc If the reservation fails.
+         */
+        explicit SpanSlabManager(const SpanSlabManagerConfig &config = SpanSlabManagerConfig{});
+
+        /**
+         * @brief Release the page heap; outstanding pointers become invalid.
+         */
+        ~SpanSlabManager() = default;
+
+        /**
+         * @brief Allocate memory from the smallest satisfying size class, taking a span from the heap if the class is full.
+         *
+         * @param size The requested memory size.
+         * @param alignment The requested alignment. Must be non-zero and a power of 2.
+         * @return Pointer to the allocated memory, or nullptr if the class is full and has reached its span limit, if the heap has no span left, or if the request exceeds the largest size class.
+         * @throws std::invalid_argument If `size` is zero, or if `alignment` is zero or not a power of 2.
+         */
+        void *Allocate(std::size_t size, std::size_t alignment = sizeof(void *));
+
+        /**
+         * @brief Free memory back to its span; the span returns to the heap once it is empty.
+         *
+         * The span table routes the block, so `(size, alignment)` are only taken for API parity with `SlabManager`.
+         *
+         * Contract:
+         *
+         * - `ptr == nullptr` is allowed and is a no-op.
+         *
+         * - Passing a non-owned pointer or double-freeing a block is a contract violation (undefined behavior).
+         */
+        void Free(void *ptr, std::size_t size, std::size_t alignment);
+
+        /**
+         * @brief Free memory without its request size.
+         *
+         * Contract:
+         *
+         * - `ptr == nullptr` is allowed and is a no-op.
+         *
+         * - Double-freeing a block or passing an interior pointer is a contract violation (undefined behavior).
+         *
+         * @throws std::invalid_argument If `ptr` does not lie in a span held by a size class (see `Owns()`).
+         */
+        void Free(void *ptr);
+
+        /**
+         * @brief Check whether `ptr` lies in a span currently held by a size class.
+         */
+        bool Owns(const void *ptr) const;
+
+        /**
+         * @brief Limit the size class serving `size` to at most `max_spans` spans; 0 removes the limit.
+         *
+         * Spans the class already holds above the new limit stay until they empty.
+         *
+         * @throws std::invalid_argument If `size` is zero or exceeds `SizeClassPolicy::kMaxClassSize`.
+         */
+        void SetSpanLimit(std::size_t size, std::size_t max_spans);
+
+        /**
+         * @brief Return the empty spans classes keep, then hand the pages of every free span back to the OS (see `PageHeap::Release()`).
+         *
+         * @return Number of bytes handed back to the OS.
+         */
+        std::size_t Scavenge(ReleaseAdvice advice = ReleaseAdvice::kDontNeed);
+
+        /**
+         * @brief Snapshot of the per-class and heap counters.
+         *
+         * Class counters other than `block_size` and `capacity` are only collected when built with `MCR_ENABLE_STATS`.
+         */
+        SpanSlabManagerStats GetStats() const;
+
+        // Disable copy semantics for the manager.
+        SpanSlabManager(const SpanSlabManager &) = delete;
+        SpanSlabManager &operator=(const SpanSlabManager &) = delete;
+
+    private:
+        static constexpr std::size_t kNumClasses = SizeClassPolicy::kNumClasses;
+
+        /**
+         * @brief "No span" in the span lists and "no class" in the span table.
+         */
+        static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+
+        /**
+         * @brief Embedded free list node.
+         */
+        struct FreeBlock
+        {
+            FreeBlock *next;
+        };
+
+        /**
+         * @brief State of one span, indexed like `PageHeap::SpanIndex()`.
+         */
+        struct Span
+        {
+            FreeBlock *free_list = nullptr;
+
+            /**
+             * @brief Blocks carved through the span's bump frontier so far.
+             */
+            std::uint32_t carved = 0;
+
+            std::uint32_t in_use = 0;
+
+            /**
+             * @brief Links of the owning class's list of spans with free blocks.
+             */
+            std::uint32_t prev = kNone;
+            std::uint32_t next = kNone;
+
+            /**
+             * @brief Owning size class, or `kNone` while the span is in the heap.
+             */
+            std::uint32_t class_idx = kNone;
+        };
+
+        struct SizeClass
+        {
+            std::size_t block_size = 0;
+            std::uint32_t blocks_per_span = 0;
+
+            /**
+             * @brief Head of the list of spans with at least one free block.
+             */
+            std::uint32_t partial = kNone;
+
+            std::size_t spans = 0;
+
+            /**
+             * @brief Span limit; 0 means only the heap budget applies.
+             */
+            std::size_t max_spans = 0;
+
+#if MCR_ENABLE_STATS
+            std::size_t stats_allocations = 0;
+            std::size_t stats_frees = 0;
+            std::size_t stats_peak_in_use = 0;
+            std::size_t stats_failed_allocations = 0;
+#endif
+        };
+
+        PageHeap heap_;
+        std::vector<Span> spans_;
+        std::array<SizeClass, kNumClasses> classes_;
+
+        /**
+         * @brief Take a span from the heap for a full class.
+         *
+         * @return false if the class is at its span limit or the heap has no span left.
+         */
+        bool AddSpan(std::size_t class_idx);
+
+        /**
+         * @brief Return an empty span to the heap.
+         */
+        void RemoveSpan(std::size_t class_idx, std::uint32_t index);
+
+        /**
+         * @brief Push a span onto the front of its class's list of spans with free blocks.
+         */
+        void PushPartial(SizeClass &size_class, std::uint32_t index);
+
+        void UnlinkPartial(SizeClass &size_class, std::uint32_t index);
+
+        /**
+         * @brief Push a block onto its span's free list.
+         */
+        void FreeToSpan(void *ptr);
+    };
+}
+
+#endif
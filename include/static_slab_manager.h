@@ -0,0 +1,172 @@
+#ifndef MCR_STATIC_SLAB_MANAGER_H_
+
+#define MCR_STATIC_SLAB_MANAGER_H_
+#include "slab_allocator.h"
+#include "size_class.h"
+#include <cstddef>
+#include <array>
+#include <utility>
+
+namespace mcr
+{
+    /**
+     * @brief Slab manager specialized at compile time for one size-class table.
+     *
+     * Same routing policy and `(size, alignment)` deallocation contract as `SlabManager`, but the class
+     * table and pool depth are template parameters:
+     *
+     * - The per-class `SlabAllocator`s are stored inline, so routing reaches the allocator without a pointer hop.
+     *
+     * - Class count, class sizes and routing are constexpr; the templated `Allocate<Size, Alignment>()` and
+     *   `Free<Size, Alignment>()` overloads resolve the class at compile time and skip request validation.
+     *
+     * @tparam ClassTable Size-class table, e.g. `PowerOfTwoClasses<16, 1024>` or `GeometricClasses<16, 1024, 4>`.
+     *         It provides `kNumClasses`, `kMaxClassSize`, `ClassSize(i)`, `ClassAlignment(i)` and constexpr
+     *         `RoutingKey(size, alignment)` and `ClassIndex(key)`.
+     * @tparam BlocksPerClass Blocks pre-allocated for each size class.
+     */
+    template <typename ClassTable, std::size_t BlocksPerClass = 100>
+    class StaticSlabManager
+    {
+    public:
+        static_assert(BlocksPerClass > 0, "BlocksPerClass must be non-zero.");
+
+        /**
+         * @brief Number of managed size classes.
+         */
+        static constexpr std::size_t kNumClasses = ClassTable::kNumClasses;
+
+        /**
+         * @brief Largest routing key served by the manager.
+         */
+        static constexpr std::size_t kMaxClassSize = ClassTable::kMaxClassSize;
+
+        /**
+         * @brief Blocks pre-allocated for each size class.
+         */
+        static constexpr std::size_t kBlocksPerClass = BlocksPerClass;
+
+        /**
+         * @brief Compute the size class serving a valid, in-range `(size, alignment)` request.
+         */
+        static constexpr std::size_t ClassIndexFor(std::size_t size, std::size_t alignment = sizeof(void *))
+        {
+            return ClassTable::ClassIndex(ClassTable::RoutingKey(size, alignment));
+        }
+
+        /**
+         * @brief Construct the manager and all of its inline per-class allocators.
+         *
+         * @throws std::bad_alloc If a backing-pool allocation fails.
+         */
+        StaticSlabManager() : allocators_(MakeAllocators(std::make_index_sequence<kNumClasses>{}))
+        {
+        }
+
+        /**
+         * @brief Destroy the manager and release its managed allocators.
+         */
+        ~StaticSlabManager() = default;
+
+        /**
+         * @brief Allocate memory by routing to the smallest satisfying size class.
+         *
+         * @param size The requested memory size.
+         * @param alignment The requested alignment. Must be non-zero and a power of 2. The same alignment must be supplied to `Free()` for symmetric routing.
+         * @return Pointer to the allocated memory, or nullptr if the target size class is exhausted or if the routing key exceeds `kMaxClassSize`.
+         * @throws std::invalid_argument If `size` is zero, or if `alignment` is zero or not a power of 2.
+         */
+        void *Allocate(std::size_t size, std::size_t alignment = sizeof(void *))
+        {
+            // Validates the request; `max(size, alignment)` is a lower bound of every table's routing key.
+            if (SizeClassPolicy::RoutingKey(size, alignment) > kMaxClassSize)
+            {
+                return nullptr;
+            }
+            const std::size_t target_size = ClassTable::RoutingKey(size, alignment);
+            if (target_size > kMaxClassSize)
+            {
+                return nullptr;
+            }
+            return allocators_[ClassTable::ClassIndex(target_size)].Allocate();
+        }
+
+        /**
+         * @brief Allocate memory for a request whose size class is resolved at compile time.
+         *
+         * @return Pointer to the allocated memory, or nullptr if the target size class is exhausted.
+         */
+        template <std::size_t Size, std::size_t Alignment = sizeof(void *)>
+        void *Allocate()
+        {
+            return allocators_[CheckedClassIndex<Size, Alignment>()].Allocate();
+        }
+
+        /**
+         * @brief Free memory back to the correct size class.
+         *
+         * Same contract as `SlabManager::Free()`: `(size, alignment)` must match the allocation site,
+         * and `ptr == nullptr` is a no-op.
+         *
+         * @param ptr Pointer to the memory to be freed.
+         * @param size The requested size (same value used at the allocation site).
+         * @param alignment The requested alignment (same value used at the allocation site).
+         */
+        void Free(void *ptr, std::size_t size, std::size_t alignment)
+        {
+            if (!ptr)
+            {
+                return;
+            }
+            allocators_[ClassIndexFor(size, alignment)].Free(ptr); // Route back using the same policy as Allocate().
+        }
+
+        /**
+         * @brief Free memory allocated by `Allocate<Size, Alignment>()`.
+         */
+        template <std::size_t Size, std::size_t Alignment = sizeof(void *)>
+        void Free(void *ptr)
+        {
+            allocators_[CheckedClassIndex<Size, Alignment>()].Free(ptr);
+        }
+
+        // Disable copy semantics for the manager.
+        StaticSlabManager(const StaticSlabManager &) = delete;
+        StaticSlabManager &operator=(const StaticSlabManager &) = delete;
+
+    private:
+        /**
+         * @brief Owns the per-class allocators inline.
+         */
+        std::array<SlabAllocator, kNumClasses> allocators_;
+
+        template <std::size_t... Indices>
+        static std::array<SlabAllocator, kNumClasses> MakeAllocators(std::index_sequence<Indices...>)
+        {
+            // Guaranteed copy elision lets the non-movable allocators be built in place.
+            return {{SlabAllocator(ClassTable::ClassSize(Indices), ClassTable::ClassSize(Indices) * BlocksPerClass, ClassTable::ClassAlignment(Indices))...}};
+        }
+
+        template <std::size_t Size, std::size_t Alignment>
+        static constexpr std::size_t CheckedClassIndex()
+        {
+            static_assert(Size > 0, "Size must be non-zero.");
+            static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be non-zero and a power of 2.");
+            static_assert((Size > Alignment ? Size : Alignment) <= kMaxClassSize && ClassTable::RoutingKey(Size, Alignment) <= kMaxClassSize, "The request exceeds the maximum managed class size.");
+            constexpr std::size_t class_idx = ClassIndexFor(Size, Alignment);
+            return class_idx;
+        }
+    };
+
+    /**
+     * @brief Compile-time equivalent of the default `SlabManager` configuration.
+     */
+    using DefaultStaticSlabManager = StaticSlabManager<PowerOfTwoClasses<16, 1024>, 100>;
+
+    /**
+     * @brief Same range as `DefaultStaticSlabManager` with four geometric classes per doubling.
+     */
+    using GeometricStaticSlabManager = StaticSlabManager<GeometricClassPolicy, 100>;
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef MCR_STL_ALLOCATOR_H_
+
+#define MCR_STL_ALLOCATOR_H_
+#include "slab_manager.h"
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+namespace mcr
+{
+    /**
+     * @brief Standard `Allocator` adapter that serves container allocations from a slab manager.
+     *
+     * For node-based containers (`std::list`, `std::map`, `std::unordered_map`) every node becomes one block of
+     * the size class matching the node, and the container's `deallocate(p, n)` supplies the size the manager needs.
+     *
+     * Notes:
+     *
+     * - Copies and rebinds share the manager; the manager must outlive every container using it.
+     *
+     * - A request the manager cannot serve throws `std::bad_alloc`.
+     *
+     * @tparam T Value type.
+     * @tparam Manager `SlabManager`, `ThreadCachedSlabManager` or any type with `Allocate(size, alignment)` and `Free(ptr, size, alignment)`.
+     */
+    template <typename T, typename Manager = SlabManager>
+    class StlAllocator
+    {
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        template <typename U>
+        struct rebind
+        {
+            using other = StlAllocator<U, Manager>;
+        };
+
+        explicit StlAllocator(Manager &manager) noexcept : manager_(&manager) {}
+
+        template <typename U>
+        StlAllocator(const StlAllocator<U, Manager> &other) noexcept : manager_(&other.GetManager())
+        {
+        }
+
+        T *allocate(std::size_t n)
+        {
+            if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+            void *ptr = manager_->Allocate(RequestSize(n), alignof(T));
+            if (!ptr)
+            {
+                throw std::bad_alloc();
+            }
+            return static_cast<T *>(ptr);
+        }
+
+        void deallocate(T *ptr, std::size_t n) noexcept
+        {
+            manager_->Free(ptr, RequestSize(n), alignof(T));
+        }
+
+        Manager &GetManager() const noexcept
+        {
+            return *manager_;
+        }
+
+    private:
+        Manager *manager_;
+
+        /**
+         * @brief Request size of `n` elements; `n == 0` maps to one byte, as in `SlabMemoryResource`.
+         */
+        static std::size_t RequestSize(std::size_t n)
+        {
+            return n ? n * sizeof(T) : 1;
+        }
+    };
+
+    template <typename T, typename U, typename Manager>
+    bool operator==(const StlAllocator<T, Manager> &lhs, const StlAllocator<U, Manager> &rhs) noexcept
+    {
+        return &lhs.GetManager() == &rhs.GetManager();
+    }
+
+    template <typename T, typename U, typename Manager>
+    bool operator!=(const StlAllocator<T, Manager> &lhs, const StlAllocator<U, Manager> &rhs) noexcept
+    {
+        return !(lhs == rhs);
+    }
+}
+
+#endif
@@ -0,0 +1,277 @@
+#ifndef MCR_THREAD_CACHED_SLAB_MANAGER_H_
+
+#define MCR_THREAD_CACHED_SLAB_MANAGER_H_
+#include "slab_allocator.h"
+#include "slab_manager.h"
+#include "size_class.h"
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mcr
+{
+    /**
+     * @brief Thread-safe slab manager with per-thread block caches in front of shared per-class pools.
+     *
+     * Each thread owns a small LIFO cache per size class. `Allocate()` and `Free()` only touch the
+     * calling thread's cache; the shared `SlabAllocator` pools are locked only when a cache has to be
+     * refilled or flushed, and then a whole batch of blocks moves under one lock acquisition.
+     *
+     * Notes:
+     *
+     * - Uses the same routing policy and `(size, alignment)` deallocation contract as `SlabManager`.
+     *
+     * - `Allocate()` and `Free()` are O(1); refills and flushes move at most `kTransferBatchSize` blocks.
+     *
+     * - A block may be freed by a different thread than the one that allocated it.
+     *
+     * - `Allocate()` may return nullptr while blocks of the same class are still parked in other threads' caches.
+     *
+     * - A thread's caches are flushed back to the shared pools when the thread exits or calls `FlushThreadCache()`.
+     *
+     * - Calls made by destructors that run after the exiting thread's caches were flushed go straight to the shared pools.
+     *
+     * - Destroying the manager invalidates any outstanding pointers; it must not race with calls on the manager.
+     */
+    class ThreadCachedSlabManager
+    {
+    public:
+        /**
+         * @brief Default pool depth of each size class; matches `SlabManager`.
+         */
+        static constexpr std::size_t kDefaultBlocksPerClass = SlabManagerConfig::kDefaultBlocksPerClass;
+
+        /**
+         * @brief Maximum number of blocks one thread caches per size class.
+         */
+        static constexpr std::size_t kThreadCacheCapacity = 64;
+
+        /**
+         * @brief Number of blocks moved between a thread cache and a shared pool per refill or flush.
+         */
+        static constexpr std::size_t kTransferBatchSize = kThreadCacheCapacity / 2;
+
+        /**
+         * @brief Construct the manager and initialize all of the shared per-class pools.
+         *
+         * @param blocks_per_class Number of blocks in each size-class pool.
+         * @throws std::invalid_argument If `blocks_per_class` is zero.
+         * @throws std::bad_alloc If a backing-pool allocation fails.
+         */
+        explicit ThreadCachedSlabManager(std::size_t blocks_per_class = kDefaultBlocksPerClass);
+
+        /**
+         * @brief Construct the manager with explicit per-class capacity and growth.
+         *
+         * Shared pools grow under their class lock, so growth never runs on the thread-cache fast path.
+         *
+         * @throws std::invalid_argument If the configuration is invalid (see `MakeSizeClassAllocator()`).
+         * @throws std::bad_alloc If a backing-pool allocation fails.
+         */
+        explicit ThreadCachedSlabManager(const SlabManagerConfig &config);
+
+        /**
+         * @brief Detach every thread cache and release the shared pools.
+         */
+        ~ThreadCachedSlabManager();
+
+        /**
+         * @brief Allocate memory from the calling thread's cache for the smallest satisfying size class.
+         *
+         * @param size The requested memory size.
+         * @param alignment The requested alignment. Must be non-zero and a power of 2.
+         * @return Pointer to the allocated memory, or nullptr if the thread cache and the shared pool of the target class are both empty and the pool cannot grow, if the large-object region is exhausted, or if the request exceeds every configured tier.
+         * @throws std::invalid_argument If `size` is zero, or if `alignment` is zero or not a power of 2.
+         */
+        void *Allocate(std::size_t size, std::size_t alignment = sizeof(void *));
+
+        /**
+         * @brief Return memory to the calling thread's cache for its size class.
+         *
+         * Contract:
+         *
+         * - `ptr == nullptr` is allowed and is a no-op.
+         *
+         * - `size` and `alignment` must match the values used at the allocation site.
+         *
+         * - Passing a mismatched `(size, alignment)` pair, a non-owned pointer, or double-freeing a block is a contract violation (undefined behavior).
+         *
+         * @param ptr Pointer to the memory to be freed.
+         * @param size The requested size (same value used at the allocation site).
+         * @param alignment The requested alignment (same value used at the allocation site).
+         */
+        void Free(void *ptr, std::size_t size, std::size_t alignment);
+
+        /**
+         * @brief Return memory without its request size (see `SlabManager::Free(void *)`).
+         *
+         * @throws std::invalid_argument If `ptr` is not owned by the class arena or the large-object region.
+         */
+        void Free(void *ptr);
+
+        /**
+         * @brief Check whether `ptr` lies in memory that `Free(ptr)` can route (see `SlabManager::Owns()`).
+         */
+        bool Owns(const void *ptr) const;
+
+        /**
+         * @brief Block size of the size class that `ptr` lies in, or 0 if `ptr` is outside the class arena.
+         *
+         * Lets callers that only keep the pointer (e.g. `realloc()`) know how many bytes the block holds.
+         */
+        std::size_t ArenaBlockSize(const void *ptr) const;
+
+        /**
+         * @brief Return every block cached by the calling thread to the shared pools.
+         */
+        void FlushThreadCache();
+
+        /**
+         * @brief Take every lock of the manager in a fixed order: the cache registry, each shared pool, the large-object region.
+         *
+         * For a `pthread_atfork` prepare handler, so `fork()` never copies a lock held by another thread into the
+         * child. Until `UnlockAfterFork()`, the calling thread may only allocate and free from its own cache.
+         */
+        void LockForFork();
+
+        /**
+         * @brief Release the locks taken by `LockForFork()`; for the parent and child handlers of `pthread_atfork`.
+         */
+        void UnlockAfterFork();
+
+        /**
+         * @brief Return fully free pages of the shared pools to the OS (see `SlabAllocator::Scavenge()`).
+         *
+         * Locks one class at a time, so it is safe to call from a background thread (see `Scavenger`).
+         * Blocks parked in thread caches are not free from the pool's point of view and are not scavenged.
+         *
+         * @return Number of bytes handed back to the OS.
+         */
+        std::size_t Scavenge(ReleaseAdvice advice = ReleaseAdvice::kDontNeed);
+
+        /**
+         * @brief Usage counters of the large-object region; all zero if it is disabled.
+         */
+        BuddyStats GetLargeObjectStats();
+
+        /**
+         * @brief Snapshot of the per-class and large-object counters, aggregated over every thread.
+         *
+         * Class counters are only collected when built with `MCR_ENABLE_STATS`; otherwise only `block_size` and
+         * `capacity` are filled in. Each thread counts its own allocations and frees with relaxed, unshared counters
+         * that are summed here, so the fast path takes no atomic read-modify-write.
+         *
+         * Notes:
+         *
+         * - `in_use` counts blocks held by callers; blocks parked in thread caches are not in use.
+         *
+         * - `peak_in_use` is the high-water mark of blocks taken from the shared pool, cached blocks included, so it
+         *   bounds the true peak from above.
+         *
+         * - Counts of threads that are allocating while the snapshot is taken may lag by their operations in flight.
+         */
+        SlabManagerStats GetStats();
+
+        // Disable copy semantics for the manager.
+        ThreadCachedSlabManager(const ThreadCachedSlabManager &) = delete;
+        ThreadCachedSlabManager &operator=(const ThreadCachedSlabManager &) = delete;
+
+    private:
+        static constexpr std::size_t kNumClasses = SizeClassPolicy::kNumClasses;
+
+        /**
+         * @brief A shared size-class pool and the lock that guards it.
+         */
+        struct CentralClass
+        {
+            std::mutex mutex;
+            std::unique_ptr<SlabAllocator> allocator;
+
+#if MCR_ENABLE_STATS
+            /**
+             * @brief Counts of exited threads and of calls that bypassed the caches, guarded by `mutex`.
+             */
+            std::size_t stats_allocations = 0;
+            std::size_t stats_frees = 0;
+            std::size_t stats_failed_allocations = 0;
+#endif
+        };
+
+        struct ThreadCache;
+        struct ThreadCacheList;
+
+        /**
+         * @brief Process-unique identity used to find this manager's cache in thread-local storage.
+         *
+         * Unlike the manager address, an id is never reused after the manager is destroyed.
+         */
+        const std::uint64_t id_;
+
+        /**
+         * @brief Region the shared pools are carved from; null unless `contiguous_arena` is set. Declared first so it outlives them.
+         */
+        std::unique_ptr<ClassArena> arena_;
+
+        std::array<CentralClass, kNumClasses> central_;
+
+        /**
+         * @brief Guards `large_`.
+         */
+        std::mutex large_mutex_;
+
+        /**
+         * @brief Serves requests above `SizeClassPolicy::kMaxClassSize`; null if the large-object path is disabled.
+         */
+        std::unique_ptr<BuddyAllocator> large_;
+
+        /**
+         * @brief Guards `caches_`.
+         */
+        std::mutex caches_mutex_;
+
+        /**
+         * @brief Caches of all threads that currently use this manager.
+         */
+        std::vector<std::shared_ptr<ThreadCache>> caches_;
+
+        /**
+         * @brief Return the calling thread's cache, creating and registering it on first use.
+         *
+         * @return nullptr once the thread's caches have been released at thread exit.
+         */
+        ThreadCache *LocalCache();
+        ThreadCache *LocalCacheSlow(ThreadCacheList &list);
+
+        /**
+         * @brief The calling thread's list of caches, one per manager it has used.
+         */
+        static ThreadCacheList &ThreadCaches();
+
+        /**
+         * @brief Move up to `kTransferBatchSize` blocks from the shared pool into the cache bin.
+         *
+         * @return false if the shared pool had no block to give.
+         */
+        bool Refill(ThreadCache &cache, std::size_t class_idx);
+
+        /**
+         * @brief Push a block onto the calling thread's bin of `class_idx`, flushing first if the bin is full.
+         */
+        void FreeToCache(void *ptr, std::size_t class_idx);
+
+        /**
+         * @brief Move the `count` oldest blocks of the cache bin back to the shared pool.
+         */
+        void Flush(ThreadCache &cache, std::size_t class_idx, std::size_t count);
+
+        /**
+         * @brief Flush a cache whose thread is exiting and stop tracking it.
+         */
+        void ReleaseThreadCache(ThreadCache &cache);
+    };
+}
+
+#endif
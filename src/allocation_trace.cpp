@@ -0,0 +1,245 @@
+#include "allocation_trace.h"
+#include "size_class.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace mcr
+{
+    namespace
+    {
+        constexpr char kTraceMagic[8] = {'M', 'C', 'R', 'T', 'R', 'A', 'C', 'E'};
+        constexpr std::uint32_t kTraceVersion = 1;
+
+        /**
+         * @brief On-disk header preceding the event records.
+         */
+        struct TraceFileHeader
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t record_size;
+            std::uint64_t count;
+        };
+
+        static_assert(sizeof(TraceFileHeader) == 24, "The trace header is 24 bytes.");
+
+        /**
+         * @brief Source of recording-thread numbers.
+         */
+        std::atomic<std::uint16_t> g_next_thread{0};
+
+        std::uint16_t ThreadNumber()
+        {
+            static thread_local const std::uint16_t number = g_next_thread.fetch_add(1, std::memory_order_relaxed);
+            return number;
+        }
+    }
+
+    /**
+     * @brief Ring slot; `sequence` equals the claiming position once the slot is free for it,
+     *        and that position + 1 once its event is published.
+     */
+    struct TraceRecorder::Slot
+    {
+        std::atomic<std::uint64_t> sequence;
+        TraceEvent event;
+    };
+
+    TraceRecorder::TraceRecorder(std::size_t capacity) : head_(0), tail_(0), dropped_(0)
+    {
+        if (capacity == 0 || capacity > (std::numeric_limits<std::size_t>::max() >> 1) + 1)
+        {
+            throw std::invalid_argument("Trace capacity must be non-zero and must not overflow.");
+        }
+        const std::size_t rounded = (capacity == 1) ? 1 : std::size_t{1} << (FloorLog2(capacity - 1) + 1);
+        mask_ = rounded - 1;
+
+        slots_ = std::make_unique<Slot[]>(rounded);
+        for (std::size_t i = 0; i < rounded; i++)
+        {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    TraceRecorder::~TraceRecorder() = default;
+
+    bool TraceRecorder::Record(TraceOp op, const void *address, std::size_t size, std::size_t alignment)
+    {
+        std::uint64_t position = head_.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;)
+        {
+            slot = &slots_[position & mask_];
+            const std::uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const std::int64_t lag = static_cast<std::int64_t>(sequence - position);
+            if (lag == 0)
+            {
+                if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (lag < 0)
+            {
+                // The slot still holds an event from one lap ago: the ring is full.
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+            {
+                position = head_.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->event.address = reinterpret_cast<std::uintptr_t>(address);
+        slot->event.size = static_cast<std::uint32_t>(std::min<std::size_t>(size, std::numeric_limits<std::uint32_t>::max()));
+        slot->event.alignment_log2 = static_cast<std::uint8_t>(alignment ? FloorLog2(alignment) : 0);
+        slot->event.op = op;
+        slot->event.thread = ThreadNumber();
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t TraceRecorder::Drain(std::vector<TraceEvent> &out)
+    {
+        std::size_t drained = 0;
+        for (;;)
+        {
+            Slot &slot = slots_[tail_ & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != tail_ + 1)
+            {
+                break;
+            }
+            out.push_back(slot.event);
+            slot.sequence.store(tail_ + mask_ + 1, std::memory_order_release); // Free the slot for the next lap.
+            tail_++;
+            drained++;
+        }
+        return drained;
+    }
+
+    std::uint64_t TraceRecorder::Dropped() const
+    {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    std::size_t TraceRecorder::Capacity() const
+    {
+        return mask_ + 1;
+    }
+
+    void WriteTraceFile(const std::string &path, const std::vector<TraceEvent> &events)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        TraceFileHeader header{};
+        std::memcpy(header.magic, kTraceMagic, sizeof(kTraceMagic));
+        header.version = kTraceVersion;
+        header.record_size = sizeof(TraceEvent);
+        header.count = events.size();
+
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(events.data()), static_cast<std::streamsize>(events.size() * sizeof(TraceEvent)));
+        if (!file)
+        {
+            throw std::runtime_error("Cannot write trace file: " + path);
+        }
+    }
+
+    std::vector<TraceEvent> ReadTraceFile(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        TraceFileHeader header{};
+        if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)))
+        {
+            throw std::runtime_error("Cannot read trace header: " + path);
+        }
+        if (std::memcmp(header.magic, kTraceMagic, sizeof(kTraceMagic)) != 0 || header.version != kTraceVersion || header.record_size != sizeof(TraceEvent))
+        {
+            throw std::runtime_error("Not a version 1 trace file: " + path);
+        }
+
+        // Check the size before allocating so a corrupt count cannot request absurd memory.
+        const std::streamoff header_end = file.tellg();
+        file.seekg(0, std::ios::end);
+        const std::uint64_t payload = static_cast<std::uint64_t>(file.tellg() - header_end);
+        if (header.count > payload / sizeof(TraceEvent))
+        {
+            throw std::runtime_error("Truncated trace file: " + path);
+        }
+        file.seekg(header_end);
+
+        std::vector<TraceEvent> events(static_cast<std::size_t>(header.count));
+        if (!file.read(reinterpret_cast<char *>(events.data()), static_cast<std::streamsize>(events.size() * sizeof(TraceEvent))))
+        {
+            throw std::runtime_error("Cannot read trace records: " + path);
+        }
+        return events;
+    }
+
+    ReplayPlan BuildReplayPlan(const std::vector<TraceEvent> &events)
+    {
+        ReplayPlan plan;
+        plan.ops.reserve(events.size());
+
+        std::unordered_map<std::uint64_t, ReplayOp> live; // Address -> allocating op.
+        std::vector<std::uint32_t> free_slots;
+        std::size_t live_bytes = 0;
+
+        for (const TraceEvent &event : events)
+        {
+            const std::uint32_t alignment = std::uint32_t{1} << std::min<std::uint8_t>(event.alignment_log2, 31);
+            if (event.op == TraceOp::kAllocate)
+            {
+                // A repeated address without a free in between means a free was lost; release the older object first.
+                auto displaced = live.find(event.address);
+                if (displaced != live.end())
+                {
+                    const ReplayOp &older = displaced->second;
+                    plan.ops.push_back(ReplayOp{older.slot, older.size, older.alignment, TraceOp::kFree});
+                    free_slots.push_back(older.slot);
+                    live_bytes -= older.size;
+                    live.erase(displaced);
+                }
+
+                std::uint32_t slot;
+                if (free_slots.empty())
+                {
+                    slot = static_cast<std::uint32_t>(plan.slot_count++);
+                }
+                else
+                {
+                    slot = free_slots.back();
+                    free_slots.pop_back();
+                }
+                const ReplayOp op{slot, event.size, alignment, TraceOp::kAllocate};
+                live[event.address] = op;
+                plan.ops.push_back(op);
+
+                live_bytes += event.size;
+                plan.peak_live_bytes = std::max(plan.peak_live_bytes, live_bytes);
+                continue;
+            }
+
+            auto found = live.find(event.address);
+            if (found == live.end())
+            {
+                continue;
+            }
+            // Free with the allocation's request so routing stays symmetric even if the recorded free disagrees.
+            plan.ops.push_back(ReplayOp{found->second.slot, found->second.size, found->second.alignment, TraceOp::kFree});
+            free_slots.push_back(found->second.slot);
+            live_bytes -= found->second.size;
+            live.erase(found);
+        }
+
+        for (const auto &entry : live)
+        {
+            plan.ops.push_back(ReplayOp{entry.second.slot, entry.second.size, entry.second.alignment, TraceOp::kFree});
+        }
+        return plan;
+    }
+}
@@ -0,0 +1,206 @@
+#include "bitmap_slab_allocator.h"
+#include "pool_memory.h"
+#include "size_class.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace mcr
+{
+    BitmapSlabAllocator::BitmapSlabAllocator(std::size_t block_size, std::size_t pool_size, std::size_t alignment, PoolBacking backing) : first_free_word_(0), in_use_(0), boundary_hints_{}, boundary_hints_used_(false)
+    {
+        // No embedded node, so the block only has to be large enough for its alignment.
+        const PoolLayout layout = ComputePoolLayout(block_size, pool_size, alignment, 1);
+        block_size_ = layout.block_size;
+        block_count_ = layout.block_count;
+        block_shift_ = ((block_size_ & (block_size_ - 1)) == 0) ? FloorLog2(block_size_) : 0;
+
+        // Mark every block free; the last word only gets the bits of real blocks.
+        const std::size_t words = (block_count_ + kWordBits - 1) / kWordBits;
+        free_bits_.assign(words, ~std::uint64_t{0});
+        if (block_count_ % kWordBits != 0)
+        {
+            free_bits_.back() = (std::uint64_t{1} << (block_count_ % kWordBits)) - 1;
+        }
+        summary_.assign((words + kWordBits - 1) / kWordBits, ~std::uint64_t{0});
+        if (words % kWordBits != 0)
+        {
+            summary_.back() = (std::uint64_t{1} << (words % kWordBits)) - 1;
+        }
+
+        // Span-align the pool so block offsets alone decide which blocks sit on an alignment boundary.
+        pool_ = AllocatePool(layout.PoolSize(), std::max(layout.alignment, kMaxSpanAlignment), backing);
+        base_ = reinterpret_cast<std::uintptr_t>(pool_.start);
+    }
+
+    BitmapSlabAllocator::~BitmapSlabAllocator()
+    {
+        FreePool(pool_);
+    }
+
+    std::size_t BitmapSlabAllocator::NextFreeWord(std::size_t word) const
+    {
+        std::size_t summary_index = word / kWordBits;
+        if (summary_index >= summary_.size())
+        {
+            return free_bits_.size();
+        }
+
+        // Mask off the words below `word` in the first summary word, then scan whole summary words.
+        std::uint64_t bits = summary_[summary_index] & (~std::uint64_t{0} << (word % kWordBits));
+        while (bits == 0)
+        {
+            if (++summary_index == summary_.size())
+            {
+                return free_bits_.size();
+            }
+            bits = summary_[summary_index];
+        }
+        return summary_index * kWordBits + CountTrailingZeros(bits);
+    }
+
+    void *BitmapSlabAllocator::TakeBlock(std::size_t word, unsigned bit)
+    {
+        std::uint64_t &bits = free_bits_[word];
+        bits &= ~(std::uint64_t{1} << bit);
+        if (bits == 0)
+        {
+            summary_[word / kWordBits] &= ~(std::uint64_t{1} << (word % kWordBits));
+            if (word == first_free_word_)
+            {
+                first_free_word_ = NextFreeWord(word + 1);
+            }
+        }
+
+        in_use_++;
+        return reinterpret_cast<void *>(base_ + (word * kWordBits + bit) * block_size_);
+    }
+
+    void *BitmapSlabAllocator::Allocate()
+    {
+        if (first_free_word_ == free_bits_.size())
+        {
+            return nullptr;
+        }
+        return TakeBlock(first_free_word_, CountTrailingZeros(free_bits_[first_free_word_]));
+    }
+
+    void *BitmapSlabAllocator::AllocateAligned(std::size_t alignment)
+    {
+        if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > kMaxSpanAlignment)
+        {
+            throw std::invalid_argument("Alignment must be a power of 2 no larger than kMaxSpanAlignment.");
+        }
+
+        // Every block offset is a multiple of the lowest set bit of the block size.
+        const std::size_t natural = block_size_ & (~block_size_ + 1);
+        if (alignment <= natural)
+        {
+            return Allocate();
+        }
+
+        // Block `i` starts on a boundary exactly when `i` is a multiple of `stride`.
+        const std::size_t stride = alignment / natural;
+        std::size_t &hint = boundary_hints_[FloorLog2(stride)];
+        boundary_hints_used_ = true;
+        if (stride < kWordBits)
+        {
+            const std::uint64_t boundaries = ~std::uint64_t{0} / ((std::uint64_t{1} << stride) - 1); // Bit 0, bit `stride`, ...
+            for (std::size_t word = std::max(first_free_word_, hint); word < free_bits_.size(); word = NextFreeWord(word + 1))
+            {
+                const std::uint64_t candidates = free_bits_[word] & boundaries;
+                if (candidates)
+                {
+                    hint = word;
+                    return TakeBlock(word, CountTrailingZeros(candidates));
+                }
+            }
+            hint = free_bits_.size();
+            return nullptr;
+        }
+
+        // Boundaries are further apart than a word: only bit 0 of every `stride / 64`-th word qualifies.
+        const std::size_t word_stride = stride / kWordBits;
+        for (std::size_t word = (std::max(first_free_word_, hint) + word_stride - 1) / word_stride * word_stride; word < free_bits_.size(); word += word_stride)
+        {
+            if (free_bits_[word] & 1u)
+            {
+                hint = word;
+                return TakeBlock(word, 0);
+            }
+        }
+        hint = free_bits_.size();
+        return nullptr;
+    }
+
+    std::size_t BitmapSlabAllocator::BlockIndex(const void *ptr) const
+    {
+        // Addresses below the base wrap around to large offsets.
+        const std::uintptr_t offset = reinterpret_cast<std::uintptr_t>(ptr) - base_;
+        if (block_shift_ != 0)
+        {
+            const std::size_t index = offset >> block_shift_;
+            return (index < block_count_ && (offset & (block_size_ - 1)) == 0) ? index : block_count_;
+        }
+        const std::size_t index = offset / block_size_;
+        return (index < block_count_ && offset % block_size_ == 0) ? index : block_count_;
+    }
+
+    void BitmapSlabAllocator::Free(void *ptr)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        const std::size_t index = BlockIndex(ptr);
+        if (index == block_count_)
+        {
+            throw std::invalid_argument("Pointer is not a block of this allocator.");
+        }
+        const std::size_t word = index / kWordBits;
+        const std::uint64_t mask = std::uint64_t{1} << (index % kWordBits);
+        std::uint64_t &bits = free_bits_[word];
+        if (bits & mask)
+        {
+            throw std::invalid_argument("Double free of a block.");
+        }
+
+        if (bits == 0)
+        {
+            summary_[word / kWordBits] |= std::uint64_t{1} << (word % kWordBits);
+        }
+        bits |= mask;
+        first_free_word_ = std::min(first_free_word_, word);
+        if (boundary_hints_used_)
+        {
+            for (std::size_t &hint : boundary_hints_)
+            {
+                hint = std::min(hint, word);
+            }
+        }
+        in_use_--;
+    }
+
+    bool BitmapSlabAllocator::IsAllocated(const void *ptr) const
+    {
+        const std::size_t index = BlockIndex(ptr);
+        return index != block_count_ && (free_bits_[index / kWordBits] & (std::uint64_t{1} << (index % kWordBits))) == 0;
+    }
+
+    bool BitmapSlabAllocator::Owns(const void *ptr) const
+    {
+        return reinterpret_cast<std::uintptr_t>(ptr) - base_ < block_count_ * block_size_;
+    }
+
+    std::size_t BitmapSlabAllocator::InUse() const
+    {
+        return in_use_;
+    }
+
+    std::size_t BitmapSlabAllocator::Capacity() const
+    {
+        return block_count_;
+    }
+}
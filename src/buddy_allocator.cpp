@@ -0,0 +1,264 @@
+#include "buddy_allocator.h"
+#include "pool_memory.h"
+#include "size_class.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace mcr
+{
+    namespace
+    {
+        constexpr bool IsPowerOfTwo(std::size_t value)
+        {
+            return value != 0 && (value & (value - 1)) == 0;
+        }
+    }
+
+    BuddyAllocator::BuddyAllocator(std::size_t min_block_size, std::size_t max_block_size, std::size_t region_size, PoolBacking backing) : free_lists_(), free_bits_(), stats_()
+    {
+        if (!IsPowerOfTwo(min_block_size) || !IsPowerOfTwo(max_block_size))
+        {
+            throw std::invalid_argument("Buddy block sizes must be powers of 2.");
+        }
+        if (min_block_size < sizeof(FreeBlock) || max_block_size < min_block_size)
+        {
+            throw std::invalid_argument("Buddy block sizes must satisfy sizeof(FreeBlock) <= min <= max.");
+        }
+        if (region_size == 0 || region_size > std::numeric_limits<std::size_t>::max() - (max_block_size - 1))
+        {
+            throw std::invalid_argument("Buddy region size must be non-zero and must not overflow.");
+        }
+
+        min_order_log2_ = FloorLog2(min_block_size);
+        num_orders_ = FloorLog2(max_block_size) - min_order_log2_ + 1;
+
+        // Round the region up to whole top-order blocks.
+        region_size_ = (region_size + max_block_size - 1) & ~(max_block_size - 1);
+        stats_.region_size = region_size_;
+
+        block_orders_.assign(region_size_ >> min_order_log2_, 0);
+        free_lists_.assign(num_orders_, nullptr);
+        free_bits_.resize(num_orders_);
+        for (unsigned order = 0; order < num_orders_; order++)
+        {
+            const std::size_t blocks = region_size_ >> (min_order_log2_ + order);
+            free_bits_[order].assign((blocks + 63) / 64, 0);
+        }
+
+        // Align the region to the largest block so every block is aligned to its own size.
+        region_ = AllocatePool(region_size_, max_block_size, backing);
+        region_start_ = region_.start;
+
+        // Seed the top order in address order; pushing in reverse leaves the lowest block on top.
+        const unsigned top = num_orders_ - 1;
+        for (std::size_t offset = region_size_; offset > 0; offset -= max_block_size)
+        {
+            PushFree(top, offset - max_block_size);
+        }
+    }
+
+    BuddyAllocator::~BuddyAllocator()
+    {
+        FreePool(region_);
+    }
+
+    unsigned BuddyAllocator::OrderFor(std::size_t size, std::size_t alignment) const
+    {
+        const std::size_t key = std::max(std::max(size, alignment), std::size_t{1} << min_order_log2_);
+        const std::size_t max_block_size = std::size_t{1} << (min_order_log2_ + num_orders_ - 1);
+        if (key > max_block_size)
+        {
+            return num_orders_;
+        }
+        // `ceil(log2(key))` relative to the minimum order.
+        return FloorLog2(key - 1) + 1 - min_order_log2_;
+    }
+
+    std::size_t BuddyAllocator::BlockSizeFor(std::size_t size, std::size_t alignment) const
+    {
+        const unsigned order = OrderFor(size, alignment);
+        return (order < num_orders_) ? std::size_t{1} << (min_order_log2_ + order) : 0;
+    }
+
+    bool BuddyAllocator::IsFree(unsigned order, std::uintptr_t offset) const
+    {
+        const std::size_t index = offset >> (min_order_log2_ + order);
+        return (free_bits_[order][index / 64] >> (index % 64)) & 1u;
+    }
+
+    void BuddyAllocator::PushFree(unsigned order, std::uintptr_t offset)
+    {
+        FreeBlock *block = reinterpret_cast<FreeBlock *>(reinterpret_cast<std::uintptr_t>(region_start_) + offset);
+        block->prev = nullptr;
+        block->next = free_lists_[order];
+        if (block->next)
+        {
+            block->next->prev = block;
+        }
+        free_lists_[order] = block;
+
+        const std::size_t index = offset >> (min_order_log2_ + order);
+        free_bits_[order][index / 64] |= std::uint64_t{1} << (index % 64);
+    }
+
+    void BuddyAllocator::RemoveFree(unsigned order, std::uintptr_t offset)
+    {
+        FreeBlock *block = reinterpret_cast<FreeBlock *>(reinterpret_cast<std::uintptr_t>(region_start_) + offset);
+        if (block->prev)
+        {
+            block->prev->next = block->next;
+        }
+        else
+        {
+            free_lists_[order] = block->next;
+        }
+        if (block->next)
+        {
+            block->next->prev = block->prev;
+        }
+
+        const std::size_t index = offset >> (min_order_log2_ + order);
+        free_bits_[order][index / 64] &= ~(std::uint64_t{1} << (index % 64));
+    }
+
+    void *BuddyAllocator::Allocate(std::size_t size, std::size_t alignment)
+    {
+        const unsigned order = OrderFor(size, alignment);
+        if (order >= num_orders_)
+        {
+            return nullptr;
+        }
+
+        // Find the smallest order at or above the request that has a free block.
+        unsigned found = order;
+        while (found < num_orders_ && !free_lists_[found])
+        {
+            found++;
+        }
+        if (found == num_orders_)
+        {
+            stats_.failed_allocations++;
+            return nullptr;
+        }
+
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(region_start_);
+        const std::uintptr_t offset = reinterpret_cast<std::uintptr_t>(free_lists_[found]) - base;
+        RemoveFree(found, offset);
+
+        // Split down to the requested order; the upper half of each split goes back on the free list.
+        while (found > order)
+        {
+            found--;
+            PushFree(found, offset + (std::uintptr_t{1} << (min_order_log2_ + found)));
+        }
+
+        block_orders_[offset >> min_order_log2_] = static_cast<std::uint8_t>(order);
+
+        const std::size_t block_size = std::size_t{1} << (min_order_log2_ + order);
+        stats_.bytes_in_use += block_size;
+        stats_.peak_bytes_in_use = std::max(stats_.peak_bytes_in_use, stats_.bytes_in_use);
+        stats_.live_allocations++;
+        stats_.total_allocations++;
+        return reinterpret_cast<void *>(base + offset);
+    }
+
+    void BuddyAllocator::Free(void *ptr, std::size_t size, std::size_t alignment)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        FreeAt(reinterpret_cast<std::uintptr_t>(ptr) - reinterpret_cast<std::uintptr_t>(region_start_), OrderFor(size, alignment));
+    }
+
+    void BuddyAllocator::Free(void *ptr)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        const std::uintptr_t offset = reinterpret_cast<std::uintptr_t>(ptr) - reinterpret_cast<std::uintptr_t>(region_start_);
+        FreeAt(offset, block_orders_[offset >> min_order_log2_]);
+    }
+
+    void BuddyAllocator::FreeAt(std::uintptr_t offset, unsigned order)
+    {
+        stats_.bytes_in_use -= std::size_t{1} << (min_order_log2_ + order);
+        stats_.live_allocations--;
+
+        // Merge upwards while the buddy of the current block is free.
+        while (order + 1 < num_orders_)
+        {
+            const std::uintptr_t buddy = offset ^ (std::uintptr_t{1} << (min_order_log2_ + order));
+            if (!IsFree(order, buddy))
+            {
+                break;
+            }
+            RemoveFree(order, buddy);
+            offset = std::min(offset, buddy);
+            order++;
+        }
+        PushFree(order, offset);
+    }
+
+    bool BuddyAllocator::Resize(void *ptr, std::size_t old_size, std::size_t new_size, std::size_t alignment)
+    {
+        const unsigned old_order = OrderFor(old_size, alignment);
+        const unsigned new_order = OrderFor(new_size, alignment);
+        if (new_order >= num_orders_)
+        {
+            return false;
+        }
+
+        const std::uintptr_t offset = reinterpret_cast<std::uintptr_t>(ptr) - reinterpret_cast<std::uintptr_t>(region_start_);
+        if (new_order > old_order)
+        {
+            // The grown block must start here, and every upper buddy on the way up must be free as a whole.
+            if (offset & ((std::uintptr_t{1} << (min_order_log2_ + new_order)) - 1))
+            {
+                return false;
+            }
+            for (unsigned order = old_order; order < new_order; order++)
+            {
+                if (!IsFree(order, offset + (std::uintptr_t{1} << (min_order_log2_ + order))))
+                {
+                    return false;
+                }
+            }
+            for (unsigned order = old_order; order < new_order; order++)
+            {
+                RemoveFree(order, offset + (std::uintptr_t{1} << (min_order_log2_ + order)));
+            }
+        }
+        else
+        {
+            // The upper halves cannot merge: their buddies are the lower halves, which stay allocated.
+            for (unsigned order = old_order; order > new_order; order--)
+            {
+                PushFree(order - 1, offset + (std::uintptr_t{1} << (min_order_log2_ + order - 1)));
+            }
+        }
+
+        block_orders_[offset >> min_order_log2_] = static_cast<std::uint8_t>(new_order);
+        stats_.bytes_in_use = stats_.bytes_in_use - (std::size_t{1} << (min_order_log2_ + old_order)) + (std::size_t{1} << (min_order_log2_ + new_order));
+        stats_.peak_bytes_in_use = std::max(stats_.peak_bytes_in_use, stats_.bytes_in_use);
+        return true;
+    }
+
+    bool BuddyAllocator::Owns(const void *ptr) const
+    {
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(ptr);
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(region_start_);
+        return address >= base && address - base < region_size_;
+    }
+
+    BuddyStats BuddyAllocator::GetStats() const
+    {
+        return stats_;
+    }
+}
@@ -0,0 +1,129 @@
+#include "concurrent_slab_allocator.h"
+#include "pool_memory.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <new>
+
+namespace mcr
+{
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "ConcurrentSlabAllocator requires a lock-free 64-bit atomic.");
+
+    ConcurrentSlabAllocator::ConcurrentSlabAllocator(std::size_t block_size, std::size_t pool_size, std::size_t alignment)
+    {
+        // Every block must be large enough to hold an embedded free-list node.
+        const PoolLayout layout = ComputePoolLayout(block_size, pool_size, alignment, sizeof(FreeBlock));
+        if (layout.block_count > kLinkMask - 1)
+        {
+            throw std::invalid_argument("Pool holds more blocks than a 32-bit link can address.");
+        }
+        block_size_ = layout.block_size;
+        alignment_ = layout.alignment;
+        pool_size_ = layout.PoolSize();
+        const std::uint32_t block_count = static_cast<std::uint32_t>(layout.block_count);
+
+        // Allocate the backing pool.
+        pool_start_ = AllocateAlignedPool(pool_size_, alignment_);
+
+        // Link the free list across the pool blocks; block `i` links to `i + 1`, the last one terminates it.
+        for (std::uint32_t link = 1; link <= block_count; link++)
+        {
+            FreeBlock *block = new (BlockAt(link)) FreeBlock;
+            block->next.store(link < block_count ? link + 1 : 0, std::memory_order_relaxed);
+        }
+        head_.store(1, std::memory_order_release); // Tag 0, top block 0.
+    }
+
+    ConcurrentSlabAllocator::~ConcurrentSlabAllocator()
+    {
+        // Release the backing pool.
+        FreeAlignedPool(pool_start_);
+    }
+
+    ConcurrentSlabAllocator::FreeBlock *ConcurrentSlabAllocator::BlockAt(std::uint32_t link) const
+    {
+        const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(pool_start_);
+        return reinterpret_cast<FreeBlock *>(base + static_cast<std::size_t>(link - 1) * block_size_);
+    }
+
+    std::uint32_t ConcurrentSlabAllocator::LinkOf(const void *ptr) const
+    {
+        const std::uintptr_t offset = reinterpret_cast<std::uintptr_t>(ptr) - reinterpret_cast<std::uintptr_t>(pool_start_);
+        return static_cast<std::uint32_t>(offset / block_size_) + 1;
+    }
+
+    void *ConcurrentSlabAllocator::Allocate()
+    {
+        std::uint64_t head = head_.load(std::memory_order_acquire);
+        for (;;)
+        {
+            const std::uint32_t link = static_cast<std::uint32_t>(head & kLinkMask);
+            // If the allocator is exhausted, return nullptr.
+            if (link == 0)
+            {
+#if MCR_ENABLE_STATS
+                stats_failed_allocations_.fetch_add(1, std::memory_order_relaxed);
+#endif
+                return nullptr;
+            }
+
+            // The top block may be popped and rewritten by another thread before the CAS below.
+            // Its `next` value is then stale, but the tag has moved on as well, so the CAS fails and we retry.
+            FreeBlock *block = BlockAt(link);
+            const std::uint32_t next = block->next.load(std::memory_order_relaxed);
+            const std::uint64_t new_head = ((head & ~kLinkMask) + kTagIncrement) | next;
+            if (head_.compare_exchange_weak(head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+            {
+#if MCR_ENABLE_STATS
+                stats_allocations_.fetch_add(1, std::memory_order_relaxed);
+                const std::size_t in_use = stats_in_use_.fetch_add(1, std::memory_order_relaxed) + 1;
+                std::size_t peak = stats_peak_in_use_.load(std::memory_order_relaxed);
+                while (in_use > peak && !stats_peak_in_use_.compare_exchange_weak(peak, in_use, std::memory_order_relaxed))
+                {
+                }
+#endif
+                return block;
+            }
+        }
+    }
+
+    void ConcurrentSlabAllocator::Free(void *ptr)
+    {
+        // If ptr is nullptr, do nothing.
+        if (!ptr)
+        {
+            return;
+        }
+
+        // Push the block back to the free-list head.
+        const std::uint32_t link = LinkOf(ptr);
+        FreeBlock *block = new (ptr) FreeBlock;
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            block->next.store(static_cast<std::uint32_t>(head & kLinkMask), std::memory_order_relaxed);
+            const std::uint64_t new_head = ((head & ~kLinkMask) + kTagIncrement) | link;
+            if (head_.compare_exchange_weak(head, new_head, std::memory_order_release, std::memory_order_relaxed))
+            {
+#if MCR_ENABLE_STATS
+                stats_in_use_.fetch_sub(1, std::memory_order_relaxed);
+#endif
+                return;
+            }
+        }
+    }
+
+    SlabStats ConcurrentSlabAllocator::GetStats() const
+    {
+        SlabStats stats;
+        stats.block_size = block_size_;
+        stats.capacity = pool_size_ / block_size_;
+#if MCR_ENABLE_STATS
+        stats.in_use = stats_in_use_.load(std::memory_order_relaxed);
+        stats.peak_in_use = stats_peak_in_use_.load(std::memory_order_relaxed);
+        stats.total_allocations = stats_allocations_.load(std::memory_order_relaxed);
+        stats.failed_allocations = stats_failed_allocations_.load(std::memory_order_relaxed);
+#endif
+        return stats;
+    }
+}
@@ -0,0 +1,96 @@
+#include "frame_allocator.h"
+#include "pool_memory.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace mcr
+{
+    namespace
+    {
+        std::size_t ValidateCapacity(std::size_t capacity)
+        {
+            if (capacity == 0)
+            {
+                throw std::invalid_argument("Linear allocator capacity must be non-zero.");
+            }
+            return capacity;
+        }
+    }
+
+    LinearAllocator::LinearAllocator(std::size_t capacity, PoolBacking backing) : pool_(AllocatePool(ValidateCapacity(capacity), kPoolAlignment, backing))
+    {
+        begin_ = reinterpret_cast<std::uintptr_t>(pool_.start);
+        end_ = begin_ + capacity;
+        cursor_ = begin_;
+    }
+
+    LinearAllocator::~LinearAllocator()
+    {
+        FreePool(pool_);
+    }
+
+    void *LinearAllocator::Allocate(std::size_t size, std::size_t alignment)
+    {
+        if (size == 0 || alignment == 0 || (alignment & (alignment - 1)) != 0)
+        {
+            throw std::invalid_argument("Size must be non-zero and alignment must be a non-zero power of 2.");
+        }
+
+        // Compare against the remaining bytes instead of the end address so huge requests cannot wrap around.
+        const std::uintptr_t aligned = (cursor_ + (alignment - 1)) & ~static_cast<std::uintptr_t>(alignment - 1);
+        if (aligned < cursor_ || aligned > end_ || size > end_ - aligned)
+        {
+            return nullptr;
+        }
+        cursor_ = aligned + size;
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    void LinearAllocator::Reset()
+    {
+        cursor_ = begin_;
+    }
+
+    std::size_t LinearAllocator::Used() const
+    {
+        return cursor_ - begin_;
+    }
+
+    std::size_t LinearAllocator::Capacity() const
+    {
+        return end_ - begin_;
+    }
+
+    bool LinearAllocator::Owns(const void *ptr) const
+    {
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(ptr);
+        return address >= begin_ && address < end_;
+    }
+
+    DoubleBufferedFrameAllocator::DoubleBufferedFrameAllocator(std::size_t frame_capacity, PoolBacking backing) : frames_{LinearAllocator(frame_capacity, backing), LinearAllocator(frame_capacity, backing)}, current_(0)
+    {
+    }
+
+    void *DoubleBufferedFrameAllocator::Allocate(std::size_t size, std::size_t alignment)
+    {
+        return frames_[current_].Allocate(size, alignment);
+    }
+
+    void DoubleBufferedFrameAllocator::NextFrame()
+    {
+        // The buffer of two frames ago becomes current; the one just finished is kept intact.
+        current_ ^= 1;
+        frames_[current_].Reset();
+    }
+
+    const LinearAllocator &DoubleBufferedFrameAllocator::CurrentFrame() const
+    {
+        return frames_[current_];
+    }
+
+    const LinearAllocator &DoubleBufferedFrameAllocator::PreviousFrame() const
+    {
+        return frames_[current_ ^ 1];
+    }
+}
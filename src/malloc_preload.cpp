@@ -0,0 +1,506 @@
+// LD_PRELOAD-able malloc replacement: small requests come from a process-wide ThreadCachedSlabManager,
+// everything else from the system allocator.
+//
+// Usage:
+//   LD_PRELOAD=/path/to/libmcr_malloc.so ./program
+//
+// Notes:
+//
+// - The size classes share one contiguous arena (`SlabManagerConfig::contiguous_arena`), so `free(ptr)` tells a
+//   slab block from a system block with one range check and routes it without a size.
+//
+// - The system allocator is reached through glibc's `__libc_*` entry points, so nothing has to be looked up
+//   before the first allocation.
+//
+// - Allocations the manager makes for itself (thread-cache bookkeeping, thread-exit registration) run under a
+//   per-thread reentrancy flag and are served by the system allocator.
+//
+// - The manager is built on first use in static storage and never destroyed, so frees from exit handlers and
+//   late destructors still find it. A full size class falls back to the system allocator.
+//
+// - `fork()` takes every manager lock first and releases it on both sides, so the child never inherits a lock
+//   that a thread which does not exist there was holding.
+
+#include <thread_cached_slab_manager.h>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#include <dlfcn.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+extern "C"
+{
+    // glibc exports its allocator under these names next to the interposable ones.
+    void *__libc_malloc(std::size_t size);
+    void __libc_free(void *ptr);
+    void *__libc_calloc(std::size_t count, std::size_t size);
+    void *__libc_realloc(void *ptr, std::size_t size);
+    void *__libc_memalign(std::size_t alignment, std::size_t size);
+}
+
+namespace
+{
+    using Manager = mcr::ThreadCachedSlabManager;
+    using mcr::SizeClassPolicy;
+
+    /**
+     * @brief Blocks per size class. The arena reserves address space for all of them; pages are committed on first use.
+     */
+    constexpr std::size_t kBlocksPerClass = std::size_t{1} << 16;
+
+    /**
+     * @brief Alignment every `malloc()` result must have.
+     */
+    constexpr std::size_t kMallocAlignment = alignof(std::max_align_t);
+
+    /**
+     * @brief Set while the calling thread runs manager code; allocations made meanwhile go to the system allocator.
+     */
+    thread_local bool t_in_manager __attribute__((tls_model("initial-exec"))) = false;
+
+    class ReentrancyGuard
+    {
+    public:
+        ReentrancyGuard() : previous_(t_in_manager)
+        {
+            t_in_manager = true;
+        }
+
+        ~ReentrancyGuard()
+        {
+            t_in_manager = previous_;
+        }
+
+        // Disable copy semantics for the guard.
+        ReentrancyGuard(const ReentrancyGuard &) = delete;
+        ReentrancyGuard &operator=(const ReentrancyGuard &) = delete;
+
+    private:
+        bool previous_;
+    };
+
+    alignas(Manager) unsigned char g_manager_storage[sizeof(Manager)];
+    std::atomic<Manager *> g_manager{nullptr};
+    std::once_flag g_manager_once;
+
+    void PrepareFork()
+    {
+        g_manager.load(std::memory_order_acquire)->LockForFork();
+    }
+
+    void FinishFork()
+    {
+        g_manager.load(std::memory_order_acquire)->UnlockAfterFork();
+    }
+
+    void BuildManager()
+    {
+        mcr::SlabManagerConfig config;
+        config.blocks_per_class = kBlocksPerClass;
+        config.contiguous_arena = true;
+        try
+        {
+            g_manager.store(new (g_manager_storage) Manager(config), std::memory_order_release);
+        }
+        catch (...)
+        {
+            // Leave the manager unset; every request then goes to the system allocator.
+            return;
+        }
+        pthread_atfork(PrepareFork, FinishFork, FinishFork);
+    }
+
+    /**
+     * @brief The process-wide manager, built on first use; nullptr if it could not be built. Call under a `ReentrancyGuard`.
+     */
+    Manager *GetManager()
+    {
+        Manager *manager = g_manager.load(std::memory_order_acquire);
+        if (manager)
+        {
+            return manager;
+        }
+        std::call_once(g_manager_once, BuildManager);
+        return g_manager.load(std::memory_order_acquire);
+    }
+
+    bool IsPowerOfTwo(std::size_t value)
+    {
+        return value != 0 && (value & (value - 1)) == 0;
+    }
+
+    /**
+     * @brief Serve a request from the size classes.
+     *
+     * @return nullptr if the request is too large, the class is full, or the caller is the manager itself.
+     */
+    void *SlabAllocate(std::size_t size, std::size_t alignment)
+    {
+        if (t_in_manager || size > SizeClassPolicy::kMaxClassSize || alignment > SizeClassPolicy::kMaxClassSize)
+        {
+            return nullptr;
+        }
+
+        ReentrancyGuard guard;
+        Manager *manager = GetManager();
+        if (!manager)
+        {
+            return nullptr;
+        }
+        try
+        {
+            return manager->Allocate(size == 0 ? 1 : size, alignment);
+        }
+        catch (...)
+        {
+            return nullptr; // Only a failed thread-cache setup throws here.
+        }
+    }
+
+    /**
+     * @brief Release `ptr` if it is a slab block.
+     *
+     * @return false if `ptr` belongs to the system allocator.
+     */
+    bool SlabFree(void *ptr)
+    {
+        Manager *manager = g_manager.load(std::memory_order_acquire);
+        if (!manager || !manager->Owns(ptr))
+        {
+            return false;
+        }
+
+        ReentrancyGuard guard;
+        try
+        {
+            manager->Free(ptr);
+        }
+        catch (...)
+        {
+            // Only a failed thread-cache setup throws here; the block is leaked rather than handed to glibc.
+        }
+        return true;
+    }
+
+    /**
+     * @brief Block size of a slab block, or 0 for system memory.
+     */
+    std::size_t SlabBlockSize(const void *ptr)
+    {
+        Manager *manager = g_manager.load(std::memory_order_acquire);
+        return manager ? manager->ArenaBlockSize(ptr) : 0;
+    }
+
+    void *Malloc(std::size_t size)
+    {
+        void *ptr = SlabAllocate(size, kMallocAlignment);
+        return ptr ? ptr : __libc_malloc(size);
+    }
+
+    void Free(void *ptr)
+    {
+        if (ptr && !SlabFree(ptr))
+        {
+            __libc_free(ptr);
+        }
+    }
+
+    void *AlignedMalloc(std::size_t alignment, std::size_t size)
+    {
+        void *ptr = IsPowerOfTwo(alignment) ? SlabAllocate(size, alignment < kMallocAlignment ? kMallocAlignment : alignment) : nullptr;
+        return ptr ? ptr : __libc_memalign(alignment, size);
+    }
+
+    void *Calloc(std::size_t count, std::size_t size)
+    {
+        if (count != 0 && size > SIZE_MAX / count)
+        {
+            errno = ENOMEM;
+            return nullptr;
+        }
+
+        void *ptr = SlabAllocate(count * size, kMallocAlignment);
+        if (!ptr)
+        {
+            return __libc_calloc(count, size);
+        }
+        std::memset(ptr, 0, count * size); // Recycled blocks still hold their previous contents.
+        return ptr;
+    }
+
+    void *Realloc(void *ptr, std::size_t size)
+    {
+        if (!ptr)
+        {
+            return Malloc(size);
+        }
+
+        const std::size_t block_size = SlabBlockSize(ptr);
+        if (block_size == 0)
+        {
+            return __libc_realloc(ptr, size);
+        }
+        if (size == 0)
+        {
+            Free(ptr); // Matches glibc: the block is released and nullptr returned.
+            return nullptr;
+        }
+        if (size <= SizeClassPolicy::kMaxClassSize && SizeClassPolicy::ClassSize(SizeClassPolicy::ClassIndex(size)) == block_size)
+        {
+            return ptr;
+        }
+
+        void *moved = Malloc(size);
+        if (!moved)
+        {
+            return nullptr; // The old block stays valid, as realloc() requires.
+        }
+        std::memcpy(moved, ptr, size < block_size ? size : block_size);
+        Free(ptr);
+        return moved;
+    }
+
+    std::size_t UsableSize(void *ptr)
+    {
+        if (!ptr)
+        {
+            return 0;
+        }
+
+        const std::size_t block_size = SlabBlockSize(ptr);
+        if (block_size != 0)
+        {
+            return block_size;
+        }
+        using UsableSizeFn = std::size_t (*)(void *);
+        static const UsableSizeFn system_usable_size = reinterpret_cast<UsableSizeFn>(dlsym(RTLD_NEXT, "malloc_usable_size"));
+        return system_usable_size ? system_usable_size(ptr) : 0;
+    }
+
+    /**
+     * @brief Allocation loop of the throwing `operator new` forms.
+     *
+     * @throws std::bad_alloc If the allocation fails and no new-handler is installed.
+     */
+    void *NewOrThrow(std::size_t size, std::size_t alignment)
+    {
+        for (;;)
+        {
+            void *ptr = alignment > kMallocAlignment ? AlignedMalloc(alignment, size) : Malloc(size);
+            if (ptr)
+            {
+                return ptr;
+            }
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+            {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+    }
+
+    void *NewOrNull(std::size_t size, std::size_t alignment) noexcept
+    {
+        try
+        {
+            return NewOrThrow(size, alignment);
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+}
+
+// ------------------------------------------------------------
+// C allocation interface
+// ------------------------------------------------------------
+
+extern "C"
+{
+    /**
+     * @brief Whether `ptr` is a slab block of the preloaded allocator; lets programs check that the library is active.
+     */
+    __attribute__((visibility("default"))) int mcr_malloc_owns(const void *ptr)
+    {
+        return SlabBlockSize(ptr) != 0;
+    }
+
+    void *malloc(std::size_t size) noexcept
+    {
+        return Malloc(size);
+    }
+
+    void free(void *ptr) noexcept
+    {
+        Free(ptr);
+    }
+
+    void *calloc(std::size_t count, std::size_t size) noexcept
+    {
+        return Calloc(count, size);
+    }
+
+    void *realloc(void *ptr, std::size_t size) noexcept
+    {
+        return Realloc(ptr, size);
+    }
+
+    void *reallocarray(void *ptr, std::size_t count, std::size_t size) noexcept
+    {
+        if (count != 0 && size > SIZE_MAX / count)
+        {
+            errno = ENOMEM;
+            return nullptr;
+        }
+        return Realloc(ptr, count * size);
+    }
+
+    void *aligned_alloc(std::size_t alignment, std::size_t size) noexcept
+    {
+        if (!IsPowerOfTwo(alignment))
+        {
+            errno = EINVAL;
+            return nullptr;
+        }
+        return AlignedMalloc(alignment, size);
+    }
+
+    void *memalign(std::size_t alignment, std::size_t size) noexcept
+    {
+        return AlignedMalloc(alignment, size);
+    }
+
+    int posix_memalign(void **out, std::size_t alignment, std::size_t size) noexcept
+    {
+        if (alignment < sizeof(void *) || !IsPowerOfTwo(alignment))
+        {
+            return EINVAL;
+        }
+        void *ptr = AlignedMalloc(alignment, size);
+        if (!ptr)
+        {
+            return ENOMEM;
+        }
+        *out = ptr;
+        return 0;
+    }
+
+    std::size_t malloc_usable_size(void *ptr) noexcept
+    {
+        return UsableSize(ptr);
+    }
+}
+
+// ------------------------------------------------------------
+// C++ allocation interface
+// ------------------------------------------------------------
+
+void *operator new(std::size_t size)
+{
+    return NewOrThrow(size, kMallocAlignment);
+}
+
+void *operator new[](std::size_t size)
+{
+    return NewOrThrow(size, kMallocAlignment);
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    return NewOrNull(size, kMallocAlignment);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept
+{
+    return NewOrNull(size, kMallocAlignment);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    return NewOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return NewOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return NewOrNull(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return NewOrNull(size, static_cast<std::size_t>(alignment));
+}
+
+// Every delete form routes by address, so the size and alignment arguments are not needed.
+void operator delete(void *ptr) noexcept
+{
+    Free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    Free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    Free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    Free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept
+{
+    Free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept
+{
+    Free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+    Free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t) noexcept
+{
+    Free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept
+{
+    Free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept
+{
+    Free(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    Free(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    Free(ptr);
+}
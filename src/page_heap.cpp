@@ -0,0 +1,103 @@
+#include "page_heap.h"
+#include "pool_memory.h"
+#include "size_class.h"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace mcr
+{
+    PageHeap::PageHeap(std::size_t heap_size, std::size_t span_size, PoolBacking backing)
+    {
+        if (span_size < kMinSpanSize || (span_size & (span_size - 1)) != 0)
+        {
+            throw std::invalid_argument("Span size must be a power of 2 of at least kMinSpanSize.");
+        }
+        span_shift_ = FloorLog2(span_size);
+        span_count_ = heap_size >> span_shift_;
+        if (span_count_ == 0)
+        {
+            throw std::invalid_argument("Heap size must hold at least one span.");
+        }
+        if (span_count_ > std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::invalid_argument("Heap holds too many spans for 32-bit span indices.");
+        }
+
+        // Spans are naturally aligned, so the span of any address is a shift away from the base.
+        region_ = AllocatePool(span_count_ << span_shift_, span_size, backing);
+        base_ = reinterpret_cast<std::uintptr_t>(region_.start);
+        free_spans_.reserve(span_count_);
+        released_.assign(span_count_, false);
+    }
+
+    PageHeap::~PageHeap()
+    {
+        FreePool(region_);
+    }
+
+    void *PageHeap::AllocateSpan()
+    {
+        std::size_t index;
+        if (!free_spans_.empty())
+        {
+            index = free_spans_.back();
+            free_spans_.pop_back();
+            if (released_[index])
+            {
+                released_[index] = false; // Its pages re-fault on first touch.
+                released_spans_--;
+            }
+        }
+        else if (next_unused_ < span_count_)
+        {
+            index = next_unused_++;
+        }
+        else
+        {
+            return nullptr;
+        }
+
+        spans_in_use_++;
+        peak_spans_in_use_ = (spans_in_use_ > peak_spans_in_use_) ? spans_in_use_ : peak_spans_in_use_;
+        return SpanAddress(index);
+    }
+
+    void PageHeap::FreeSpan(void *span)
+    {
+        // `free_spans_` was reserved for every span, so this never reallocates.
+        free_spans_.push_back(static_cast<std::uint32_t>(SpanIndex(span)));
+        spans_in_use_--;
+    }
+
+    std::size_t PageHeap::Release(ReleaseAdvice advice)
+    {
+        std::size_t released_bytes = 0;
+        for (const std::uint32_t index : free_spans_)
+        {
+            if (released_[index])
+            {
+                continue;
+            }
+            if (ReleasePages(SpanAddress(index), SpanSize(), advice))
+            {
+                released_[index] = true;
+                released_spans_++;
+                released_bytes += SpanSize();
+            }
+        }
+        return released_bytes;
+    }
+
+    PageHeapStats PageHeap::GetStats() const
+    {
+        PageHeapStats stats;
+        stats.span_size = SpanSize();
+        stats.span_count = span_count_;
+        stats.spans_in_use = spans_in_use_;
+        stats.peak_spans_in_use = peak_spans_in_use_;
+        stats.released_spans = released_spans_;
+        return stats;
+    }
+}
@@ -0,0 +1,294 @@
+#include "per_cpu_slab_manager.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace mcr
+{
+    namespace
+    {
+        /**
+         * @brief Next fallback slot handed to a thread on platforms without `sched_getcpu()`.
+         */
+        std::atomic<std::size_t> g_next_fallback_slot{0};
+
+        std::size_t ConfiguredCpuCount()
+        {
+#if defined(__linux__)
+            // Count offline CPUs too; a CPU brought online later must not alias a busy shard.
+            const long configured = sysconf(_SC_NPROCESSORS_CONF);
+            if (configured > 0)
+            {
+                return static_cast<std::size_t>(configured);
+            }
+#endif
+            return std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+
+    /**
+     * @brief Cached blocks of one CPU; aligned so neighbouring shards never share a cache line.
+     */
+    struct alignas(64) PerCpuSlabManager::CpuCache
+    {
+        /**
+         * @brief LIFO stack of cached blocks of one size class; the top is the most recently freed block.
+         */
+        struct Bin
+        {
+            std::size_t count = 0;
+            std::array<void *, kCpuCacheCapacity> blocks;
+
+#if MCR_ENABLE_STATS
+            /**
+             * @brief Plain counters, guarded by the shard lock like the bin itself.
+             */
+            std::size_t stats_allocations = 0;
+            std::size_t stats_frees = 0;
+            std::size_t stats_failed_allocations = 0;
+#endif
+        };
+
+        std::mutex mutex;
+        std::array<Bin, kNumClasses> bins{};
+    };
+
+    PerCpuSlabManager::PerCpuSlabManager(const SlabManagerConfig &config, std::size_t num_shards) : arena_(MakeClassArena(SizeClassPolicy::kMaxClassSize, kNumClasses, config))
+    {
+        for (std::size_t i = 0; i < kNumClasses; i++)
+        {
+            const std::size_t block_size = SizeClassPolicy::ClassSize(i);
+            central_[i].allocator = arena_ ? MakeArenaClassAllocator(block_size, *arena_, i, config) : MakeSizeClassAllocator(block_size, config);
+        }
+        large_ = MakeLargeObjectAllocator(SizeClassPolicy::kMaxClassSize, config);
+
+        num_shards_ = (num_shards != 0) ? num_shards : ConfiguredCpuCount();
+        caches_ = std::make_unique<CpuCache[]>(num_shards_);
+    }
+
+    PerCpuSlabManager::~PerCpuSlabManager() = default;
+
+    std::size_t PerCpuSlabManager::CurrentCpu()
+    {
+#if defined(__linux__)
+        const int cpu = sched_getcpu();
+        if (cpu >= 0)
+        {
+            return static_cast<std::size_t>(cpu);
+        }
+#endif
+        static thread_local const std::size_t slot = g_next_fallback_slot.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+
+    std::size_t PerCpuSlabManager::ShardCount() const
+    {
+        return num_shards_;
+    }
+
+    PerCpuSlabManager::CpuCache &PerCpuSlabManager::LocalCache()
+    {
+        // With the default shard count every CPU id is in range, so the division is skipped.
+        const std::size_t cpu = CurrentCpu();
+        return caches_[(cpu < num_shards_) ? cpu : cpu % num_shards_];
+    }
+
+    bool PerCpuSlabManager::Refill(CpuCache &cache, std::size_t class_idx)
+    {
+        CpuCache::Bin &bin = cache.bins[class_idx];
+        CentralClass &central = central_[class_idx];
+
+        std::lock_guard<std::mutex> lock(central.mutex);
+        if (bin.count < kTransferBatchSize)
+        {
+            bin.count += central.allocator->AllocateBatch(kTransferBatchSize - bin.count, bin.blocks.data() + bin.count);
+        }
+        return bin.count != 0;
+    }
+
+    void PerCpuSlabManager::Flush(CpuCache &cache, std::size_t class_idx, std::size_t count)
+    {
+        CpuCache::Bin &bin = cache.bins[class_idx];
+        CentralClass &central = central_[class_idx];
+        count = std::min(count, bin.count);
+
+        {
+            std::lock_guard<std::mutex> lock(central.mutex);
+            central.allocator->FreeBatch(bin.blocks.data(), count);
+        }
+
+        // Keep the most recently freed (cache-hot) blocks; they sit on top of the stack.
+        std::copy(bin.blocks.begin() + count, bin.blocks.begin() + bin.count, bin.blocks.begin());
+        bin.count -= count;
+    }
+
+    void *PerCpuSlabManager::Allocate(std::size_t size, std::size_t alignment)
+    {
+        std::size_t target_size = SizeClassPolicy::RoutingKey(size, alignment);
+        if (target_size > SizeClassPolicy::kMaxClassSize)
+        {
+            if (!large_)
+            {
+                return nullptr;
+            }
+            std::lock_guard<std::mutex> lock(large_mutex_);
+            return large_->Allocate(size, alignment);
+        }
+        std::size_t class_idx = SizeClassPolicy::ClassIndex(target_size);
+
+        CpuCache &cache = LocalCache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        CpuCache::Bin &bin = cache.bins[class_idx];
+        if (bin.count == 0 && !Refill(cache, class_idx))
+        {
+#if MCR_ENABLE_STATS
+            bin.stats_failed_allocations++;
+#endif
+            return nullptr;
+        }
+#if MCR_ENABLE_STATS
+        bin.stats_allocations++;
+#endif
+        return bin.blocks[--bin.count];
+    }
+
+    void PerCpuSlabManager::Free(void *ptr, std::size_t size, std::size_t alignment)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        std::size_t target_size = std::max(size, alignment);
+        if (large_ && target_size > SizeClassPolicy::kMaxClassSize)
+        {
+            std::lock_guard<std::mutex> lock(large_mutex_);
+            large_->Free(ptr, size, alignment);
+            return;
+        }
+        std::size_t class_idx = SizeClassPolicy::ClassIndex(target_size); // Route back using the same policy as Allocate().
+        FreeToCache(ptr, class_idx);
+    }
+
+    void PerCpuSlabManager::Free(void *ptr)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        if (arena_ && arena_->Owns(ptr))
+        {
+            FreeToCache(ptr, arena_->ClassOf(ptr));
+            return;
+        }
+        if (large_ && large_->Owns(ptr))
+        {
+            std::lock_guard<std::mutex> lock(large_mutex_);
+            large_->Free(ptr);
+            return;
+        }
+        throw std::invalid_argument("Pointer is not owned by the class arena or the large-object region.");
+    }
+
+    bool PerCpuSlabManager::Owns(const void *ptr) const
+    {
+        return (arena_ && arena_->Owns(ptr)) || (large_ && large_->Owns(ptr));
+    }
+
+    void PerCpuSlabManager::FreeToCache(void *ptr, std::size_t class_idx)
+    {
+        CpuCache &cache = LocalCache();
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        CpuCache::Bin &bin = cache.bins[class_idx];
+        if (bin.count == kCpuCacheCapacity)
+        {
+            Flush(cache, class_idx, kTransferBatchSize);
+        }
+        bin.blocks[bin.count++] = ptr;
+#if MCR_ENABLE_STATS
+        bin.stats_frees++;
+#endif
+    }
+
+    void PerCpuSlabManager::FlushCpuCaches()
+    {
+        for (std::size_t shard = 0; shard < num_shards_; shard++)
+        {
+            CpuCache &cache = caches_[shard];
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            for (std::size_t i = 0; i < kNumClasses; i++)
+            {
+                Flush(cache, i, cache.bins[i].count);
+            }
+        }
+    }
+
+    std::size_t PerCpuSlabManager::Scavenge(ReleaseAdvice advice)
+    {
+        std::size_t released_bytes = 0;
+        for (CentralClass &central : central_)
+        {
+            std::lock_guard<std::mutex> lock(central.mutex);
+            released_bytes += central.allocator->Scavenge(advice);
+        }
+        return released_bytes;
+    }
+
+    BuddyStats PerCpuSlabManager::GetLargeObjectStats()
+    {
+        if (!large_)
+        {
+            return BuddyStats{};
+        }
+        std::lock_guard<std::mutex> lock(large_mutex_);
+        return large_->GetStats();
+    }
+
+    SlabManagerStats PerCpuSlabManager::GetStats()
+    {
+        SlabManagerStats stats;
+        stats.classes.resize(kNumClasses);
+#if MCR_ENABLE_STATS
+        std::array<std::size_t, kNumClasses> frees{};
+
+        // Shards lock before the shared pools on the fast path, so sum them before taking any class lock.
+        for (std::size_t shard = 0; shard < num_shards_; shard++)
+        {
+            CpuCache &cache = caches_[shard];
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            for (std::size_t i = 0; i < kNumClasses; i++)
+            {
+                const CpuCache::Bin &bin = cache.bins[i];
+                SlabStats &class_stats = stats.classes[i];
+                class_stats.total_allocations += bin.stats_allocations;
+                class_stats.failed_allocations += bin.stats_failed_allocations;
+                frees[i] += bin.stats_frees;
+            }
+        }
+#endif
+        for (std::size_t i = 0; i < kNumClasses; i++)
+        {
+            CentralClass &central = central_[i];
+            std::lock_guard<std::mutex> lock(central.mutex);
+            const SlabStats pool_stats = central.allocator->GetStats();
+            SlabStats &class_stats = stats.classes[i];
+            class_stats.block_size = pool_stats.block_size;
+            class_stats.capacity = pool_stats.capacity;
+#if MCR_ENABLE_STATS
+            // A block freed on another shard may be counted before the shard that allocated it was summed.
+            class_stats.in_use = (class_stats.total_allocations > frees[i]) ? class_stats.total_allocations - frees[i] : 0;
+            class_stats.peak_in_use = std::max(pool_stats.peak_in_use, class_stats.in_use);
+#endif
+        }
+        stats.large = GetLargeObjectStats();
+        return stats;
+    }
+}
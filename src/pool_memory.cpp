@@ -0,0 +1,223 @@
+#include "pool_memory.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <limits>
+#include <new>
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <malloc.h> // for _aligned_malloc and _aligned_free
+#else
+#include <stdlib.h> // for posix_memalign
+#include <sys/mman.h> // for mmap, munmap and madvise
+#include <unistd.h> // for sysconf
+#endif
+
+namespace mcr
+{
+#if !defined(_WIN32) && !defined(_WIN64)
+    namespace
+    {
+        std::size_t RoundUp(std::size_t value, std::size_t granularity)
+        {
+            return (value + granularity - 1) / granularity * granularity;
+        }
+
+        /**
+         * @brief Map `size` bytes aligned to `alignment`, or return nullptr.
+         *
+         * Over-maps by the alignment and unmaps the unaligned head and the tail.
+         */
+        void *MapAligned(std::size_t size, std::size_t alignment, int extra_flags)
+        {
+            const std::size_t page_size = SystemPageSize();
+            const std::size_t padding = (alignment > page_size) ? alignment : 0;
+            if (size > std::numeric_limits<std::size_t>::max() - padding)
+            {
+                return nullptr;
+            }
+
+            void *mapping = mmap(nullptr, size + padding, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+            if (mapping == MAP_FAILED)
+            {
+                return nullptr;
+            }
+            if (padding == 0)
+            {
+                return mapping;
+            }
+
+            const std::uintptr_t raw = reinterpret_cast<std::uintptr_t>(mapping);
+            const std::uintptr_t aligned = (raw + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+            const std::size_t head = aligned - raw;
+            if (head != 0)
+            {
+                munmap(mapping, head);
+            }
+            if (padding - head != 0)
+            {
+                munmap(reinterpret_cast<void *>(aligned + size), padding - head);
+            }
+            return reinterpret_cast<void *>(aligned);
+        }
+    }
+#endif
+
+    PoolLayout ComputePoolLayout(std::size_t block_size, std::size_t pool_size, std::size_t alignment, std::size_t min_block_size)
+    {
+        PoolLayout layout{};
+
+        // Validate the requested alignment and derive the effective alignment.
+        if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+        {
+            throw std::invalid_argument("Alignment must be non-zero and a power of 2.");
+        }
+        layout.alignment = std::max(alignment, sizeof(void *));
+
+        // Ensure the block is large enough to hold the embedded metadata.
+        block_size = std::max(block_size, min_block_size);
+
+        // Avoid the block size become overflow during round up.
+        const std::size_t max_size = std::numeric_limits<std::size_t>::max();
+        const std::size_t align_padding = layout.alignment - 1;
+        if (block_size > max_size - align_padding)
+        {
+            throw std::invalid_argument("Block size overflow.");
+        }
+
+        // Round the final block size up to the nearest multiple of the effective alignment.
+        layout.block_size = (block_size + align_padding) & ~(align_padding);
+
+        // Compute how many whole blocks fit in the requested pool size.
+        layout.block_count = pool_size / layout.block_size;
+        if (layout.block_count == 0)
+        {
+            throw std::invalid_argument("Pool size must be able to hold at least one effective block.");
+        }
+
+        return layout;
+    }
+
+    void *AllocateAlignedPool(std::size_t size, std::size_t alignment)
+    {
+        void *pool = nullptr;
+#if defined(_WIN32) || defined(_WIN64)
+        pool = _aligned_malloc(size, alignment);
+        if (!pool)
+        {
+            throw std::bad_alloc();
+        }
+#else
+        if (posix_memalign(&pool, alignment, size) != 0)
+        {
+            throw std::bad_alloc();
+        }
+#endif
+        return pool;
+    }
+
+    void FreeAlignedPool(void *pool)
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        _aligned_free(pool);
+#else
+        std::free(pool);
+#endif
+    }
+
+    PoolRegion AllocatePool(std::size_t size, std::size_t alignment, PoolBacking backing)
+    {
+        PoolRegion region;
+#if !defined(_WIN32) && !defined(_WIN64)
+        const std::size_t page_size = SystemPageSize();
+        if (size <= std::numeric_limits<std::size_t>::max() - kHugePageSize)
+        {
+#if defined(MAP_HUGETLB)
+            // Fails unless huge pages are reserved (vm.nr_hugepages); fall through to THP then.
+            if (backing == PoolBacking::kExplicitHugePages && alignment <= kHugePageSize)
+            {
+                const std::size_t mapped_size = RoundUp(size, kHugePageSize);
+                void *mapping = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (mapping != MAP_FAILED)
+                {
+                    return PoolRegion{mapping, mapped_size, PoolBacking::kExplicitHugePages};
+                }
+            }
+#endif
+            if (backing != PoolBacking::kHeap)
+            {
+                // Huge-page candidates are aligned to the huge-page size so the kernel can back them with PMD mappings.
+                const bool want_huge = backing != PoolBacking::kMmap;
+                const std::size_t map_alignment = want_huge ? std::max(alignment, kHugePageSize) : alignment;
+                const std::size_t mapped_size = RoundUp(size, want_huge ? kHugePageSize : page_size);
+                void *mapping = MapAligned(mapped_size, map_alignment, 0);
+                if (mapping)
+                {
+                    region = PoolRegion{mapping, mapped_size, PoolBacking::kMmap};
+#if defined(MADV_HUGEPAGE)
+                    if (want_huge && madvise(mapping, mapped_size, MADV_HUGEPAGE) == 0)
+                    {
+                        region.backing = PoolBacking::kTransparentHugePages;
+                    }
+#endif
+                    return region;
+                }
+            }
+        }
+#else
+        (void)backing;
+#endif
+        region.start = AllocateAlignedPool(size, alignment);
+        region.size = size;
+        region.backing = PoolBacking::kHeap;
+        return region;
+    }
+
+    void FreePool(const PoolRegion &region)
+    {
+        if (!region.start)
+        {
+            return;
+        }
+#if !defined(_WIN32) && !defined(_WIN64)
+        if (region.backing != PoolBacking::kHeap)
+        {
+            munmap(region.start, region.size);
+            return;
+        }
+#endif
+        FreeAlignedPool(region.start);
+    }
+
+    std::size_t SystemPageSize()
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        return 4096;
+#else
+        static const std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        return page_size;
+#endif
+    }
+
+    bool ReleasePages(void *start, std::size_t size, ReleaseAdvice advice)
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        (void)start;
+        (void)size;
+        (void)advice;
+        return false;
+#else
+#if defined(MADV_FREE)
+        if (advice == ReleaseAdvice::kFree && madvise(start, size, MADV_FREE) == 0)
+        {
+            return true;
+        }
+#else
+        (void)advice;
+#endif
+        return madvise(start, size, MADV_DONTNEED) == 0;
+#endif
+    }
+}
\ No newline at end of file
@@ -0,0 +1,327 @@
+#include "relocatable_slab_manager.h"
+#include "pool_memory.h"
+#include "size_class.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <cstdio> // for std::rename
+#include <fcntl.h> // for open
+#include <sys/mman.h> // for mmap and munmap
+#include <sys/stat.h> // for fstat
+#include <unistd.h> // for pread, pwrite, ftruncate, close and unlink
+#endif
+
+namespace mcr
+{
+    namespace
+    {
+        constexpr char kImageMagic[8] = {'M', 'C', 'R', 'H', 'E', 'A', 'P', '\0'};
+        constexpr std::uint32_t kImageVersion = 1;
+
+        /**
+         * @brief Bytes before the first class span; a whole page, so class spans start page-aligned.
+         */
+        constexpr std::size_t kHeaderSize = 4096;
+
+        /**
+         * @brief Largest class span; keeps the reservation of a misconfigured heap within reason.
+         */
+        constexpr unsigned kMaxSpanShift = 40;
+
+        /**
+         * @brief Allocator state of one size class, as offsets from the base.
+         */
+        struct ImageClassState
+        {
+            /**
+             * @brief First block of the free list; 0 when it is empty (offset 0 is the header, never a block).
+             */
+            std::uint64_t free_head;
+
+            /**
+             * @brief Next never-used block of the class span, and the end of the span.
+             */
+            std::uint64_t frontier;
+            std::uint64_t end;
+        };
+
+        std::uint64_t ClassStart(std::size_t class_idx, unsigned span_shift)
+        {
+            return kHeaderSize + (std::uint64_t{class_idx} << span_shift);
+        }
+
+#if !defined(_WIN32) && !defined(_WIN64)
+        /**
+         * @brief Write all of `[data, data + size)` at `offset`, retrying short writes.
+         */
+        bool WriteAt(int fd, const void *data, std::size_t size, std::uint64_t offset)
+        {
+            const char *bytes = static_cast<const char *>(data);
+            while (size != 0)
+            {
+                const ssize_t written = pwrite(fd, bytes, size, static_cast<off_t>(offset));
+                if (written <= 0)
+                {
+                    return false;
+                }
+                bytes += written;
+                size -= static_cast<std::size_t>(written);
+                offset += static_cast<std::uint64_t>(written);
+            }
+            return true;
+        }
+#endif
+    }
+
+    struct RelocatableSlabManager::ImageHeader
+    {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t num_classes;
+
+        /**
+         * @brief Address the heap was mapped at when the header was last written.
+         */
+        std::uint64_t base;
+
+        std::uint64_t image_size;
+        std::uint64_t span_shift;
+
+        /**
+         * @brief Offset of the graph entry point set with `SetRoot()`; 0 if none.
+         */
+        std::uint64_t root;
+
+        ImageClassState classes[kNumClasses];
+    };
+
+    RelocatableSlabManager::RelocatableSlabManager(const RelocatableHeapConfig &config)
+    {
+        static_assert(sizeof(ImageHeader) <= kHeaderSize, "Image header must fit in its page.");
+#if defined(_WIN32) || defined(_WIN64)
+        (void)config;
+        throw std::runtime_error("Relocatable heaps need mmap.");
+#else
+        if (config.base % SystemPageSize() != 0)
+        {
+            throw std::invalid_argument("Heap base must be page-aligned.");
+        }
+        if (config.blocks_per_class == 0 || config.blocks_per_class > (std::size_t{1} << kMaxSpanShift) / SizeClassPolicy::kMaxClassSize)
+        {
+            throw std::invalid_argument("Blocks per class must be non-zero and fit a class span of at most 2^40 bytes.");
+        }
+
+        // Every class gets the same power-of-2 span, so the class of an address is one subtract and shift.
+        unsigned span_shift = FloorLog2(kHeaderSize);
+        while ((std::size_t{1} << span_shift) < config.blocks_per_class * SizeClassPolicy::kMaxClassSize)
+        {
+            span_shift++;
+        }
+        const std::size_t image_size = kHeaderSize + (kNumClasses << span_shift);
+
+        // Untouched pages cost nothing, so the whole heap is reserved up front.
+        void *hint = reinterpret_cast<void *>(config.base);
+        void *mapping = mmap(hint, image_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (mapping == MAP_FAILED)
+        {
+            throw std::bad_alloc();
+        }
+        if (config.base != 0 && mapping != hint)
+        {
+            munmap(mapping, image_size);
+            throw std::bad_alloc();
+        }
+
+        base_ = reinterpret_cast<std::uintptr_t>(mapping);
+        image_size_ = image_size;
+        header_ = static_cast<ImageHeader *>(mapping);
+        span_shift_ = span_shift;
+
+        std::memcpy(header_->magic, kImageMagic, sizeof(kImageMagic));
+        header_->version = kImageVersion;
+        header_->num_classes = static_cast<std::uint32_t>(kNumClasses);
+        header_->base = base_;
+        header_->image_size = image_size;
+        header_->span_shift = span_shift;
+        header_->root = 0;
+        for (std::size_t i = 0; i < kNumClasses; i++)
+        {
+            ImageClassState &state = header_->classes[i];
+            const std::uint64_t start = ClassStart(i, span_shift);
+            state.free_head = 0;
+            state.frontier = start;
+            state.end = start + config.blocks_per_class * SizeClassPolicy::ClassSize(i);
+        }
+#endif
+    }
+
+    RelocatableSlabManager::RelocatableSlabManager(void *base, std::size_t image_size)
+        : base_(reinterpret_cast<std::uintptr_t>(base)), image_size_(image_size), header_(static_cast<ImageHeader *>(base))
+    {
+        span_shift_ = static_cast<unsigned>(header_->span_shift);
+        header_->base = base_;
+    }
+
+    std::unique_ptr<RelocatableSlabManager> RelocatableSlabManager::Restore(const std::string &path, bool allow_relocation)
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        (void)path;
+        (void)allow_relocation;
+        throw std::runtime_error("Relocatable heaps need mmap.");
+#else
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Cannot open heap image: " + path);
+        }
+
+        ImageHeader header;
+        struct stat file_stat;
+        const bool readable = pread(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) && fstat(fd, &file_stat) == 0;
+        bool valid = readable && std::memcmp(header.magic, kImageMagic, sizeof(kImageMagic)) == 0 && header.version == kImageVersion &&
+                     header.num_classes == kNumClasses && header.span_shift >= FloorLog2(kHeaderSize) && header.span_shift <= kMaxSpanShift &&
+                     header.image_size == kHeaderSize + (kNumClasses << header.span_shift) &&
+                     static_cast<std::uint64_t>(file_stat.st_size) == header.image_size;
+        for (std::size_t i = 0; valid && i < kNumClasses; i++)
+        {
+            const ImageClassState &state = header.classes[i];
+            const std::uint64_t start = ClassStart(i, static_cast<unsigned>(header.span_shift));
+            valid = start <= state.frontier && state.frontier <= state.end && state.end <= start + (std::uint64_t{1} << header.span_shift) &&
+                    (state.free_head == 0 || (start <= state.free_head && state.free_head < state.frontier));
+        }
+        if (!valid)
+        {
+            close(fd);
+            throw std::runtime_error("Not a heap image of this version: " + path);
+        }
+
+        // The recorded base is only a hint; the kernel maps elsewhere rather than replace an existing mapping.
+        const std::size_t image_size = static_cast<std::size_t>(header.image_size);
+        void *hint = reinterpret_cast<void *>(static_cast<std::uintptr_t>(header.base));
+        void *mapping = mmap(hint, image_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            throw std::runtime_error("Cannot map heap image: " + path);
+        }
+        if (mapping != hint && !allow_relocation)
+        {
+            munmap(mapping, image_size);
+            throw std::runtime_error("Heap image base is not available: " + path);
+        }
+        return std::unique_ptr<RelocatableSlabManager>(new RelocatableSlabManager(mapping, image_size));
+#endif
+    }
+
+    RelocatableSlabManager::~RelocatableSlabManager()
+    {
+#if !defined(_WIN32) && !defined(_WIN64)
+        munmap(reinterpret_cast<void *>(base_), image_size_);
+#endif
+    }
+
+    void *RelocatableSlabManager::Allocate(std::size_t size, std::size_t alignment)
+    {
+        const std::size_t target_size = SizeClassPolicy::RoutingKey(size, alignment);
+        if (target_size > SizeClassPolicy::kMaxClassSize)
+        {
+            return nullptr;
+        }
+        const std::size_t class_idx = SizeClassPolicy::ClassIndex(target_size);
+        ImageClassState &state = header_->classes[class_idx];
+
+        // Recycled blocks first, then the class span's frontier.
+        std::uint64_t offset = state.free_head;
+        if (offset != 0)
+        {
+            state.free_head = *reinterpret_cast<const std::uint64_t *>(base_ + offset);
+        }
+        else if (state.frontier != state.end)
+        {
+            offset = state.frontier;
+            state.frontier += SizeClassPolicy::ClassSize(class_idx);
+        }
+        else
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<void *>(base_ + offset);
+    }
+
+    void RelocatableSlabManager::Free(void *ptr, std::size_t, std::size_t)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+        const std::uint64_t offset = ToOffset(ptr);
+        ImageClassState &state = header_->classes[(offset - kHeaderSize) >> span_shift_];
+        *static_cast<std::uint64_t *>(ptr) = state.free_head;
+        state.free_head = offset;
+    }
+
+    void RelocatableSlabManager::Free(void *ptr)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+        if (!Owns(ptr))
+        {
+            throw std::invalid_argument("Pointer does not lie in a size-class span of the heap.");
+        }
+        Free(ptr, 0, 0);
+    }
+
+    bool RelocatableSlabManager::Owns(const void *ptr) const
+    {
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(ptr);
+        return address >= base_ + kHeaderSize && address - base_ < image_size_;
+    }
+
+    void RelocatableSlabManager::SetRoot(void *root)
+    {
+        header_->root = root ? ToOffset(root) : 0;
+    }
+
+    void *RelocatableSlabManager::Root() const
+    {
+        return header_->root != 0 ? FromOffset(header_->root) : nullptr;
+    }
+
+    void RelocatableSlabManager::WriteImage(const std::string &path) const
+    {
+#if defined(_WIN32) || defined(_WIN64)
+        (void)path;
+        throw std::runtime_error("Relocatable heaps need mmap.");
+#else
+        // Renaming a finished file over `path` leaves existing mappings of the old image intact.
+        const std::string temp_path = path + ".tmp";
+        const int fd = open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Cannot write heap image: " + path);
+        }
+
+        // Sizing the file first leaves the never-carved tail of every class span as a hole.
+        bool written = ftruncate(fd, static_cast<off_t>(image_size_)) == 0 && WriteAt(fd, header_, kHeaderSize, 0);
+        for (std::size_t i = 0; written && i < kNumClasses; i++)
+        {
+            const std::uint64_t start = ClassStart(i, span_shift_);
+            const std::uint64_t frontier = header_->classes[i].frontier;
+            written = WriteAt(fd, FromOffset(start), static_cast<std::size_t>(frontier - start), start);
+        }
+        written = (close(fd) == 0) && written;
+        if (!written || std::rename(temp_path.c_str(), path.c_str()) != 0)
+        {
+            unlink(temp_path.c_str());
+            throw std::runtime_error("Cannot write heap image: " + path);
+        }
+#endif
+    }
+}
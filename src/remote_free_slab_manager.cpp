@@ -0,0 +1,128 @@
+#include "remote_free_slab_manager.h"
+#include <algorithm>
+#include <cstddef>
+
+namespace mcr
+{
+    RemoteFreeSlabManager::RemoteFreeSlabManager(const SlabManagerConfig &config) : manager_(config), owner_(std::this_thread::get_id()), over_aligned_(config.over_aligned_blocks_per_class != 0)
+    {
+    }
+
+    std::size_t RemoteFreeSlabManager::QueueFor(std::size_t size, std::size_t alignment) const
+    {
+        const std::size_t target_size = std::max(size, alignment);
+        if (target_size > SizeClassPolicy::kMaxClassSize || (over_aligned_ && SlabManager::IsOverAligned(size, alignment)))
+        {
+            return kNumClasses;
+        }
+        return manager_.ClassIndex(size, alignment);
+    }
+
+    void *RemoteFreeSlabManager::Allocate(std::size_t size, std::size_t alignment)
+    {
+        SizeClassPolicy::RoutingKey(size, alignment); // Reject invalid requests before they pick a queue.
+        const std::size_t queue = QueueFor(size, alignment);
+
+        // A relaxed peek keeps the common empty case to one shared load; `Drain()` synchronizes with the pushers.
+        if (remote_[queue].load(std::memory_order_relaxed))
+        {
+            Drain(queue);
+        }
+        return manager_.Allocate(size, alignment);
+    }
+
+    void RemoteFreeSlabManager::Free(void *ptr, std::size_t size, std::size_t alignment)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        if (std::this_thread::get_id() == owner_)
+        {
+            manager_.Free(ptr, size, alignment);
+            return;
+        }
+
+        const std::size_t queue = QueueFor(size, alignment);
+
+        // Push only; the owner takes the whole stack at once, so there is no pop and no ABA.
+        RemoteBlock *block = static_cast<RemoteBlock *>(ptr);
+        RemoteBlock *head = remote_[queue].load(std::memory_order_relaxed);
+        do
+        {
+            block->next = head;
+        } while (!remote_[queue].compare_exchange_weak(head, block, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    std::size_t RemoteFreeSlabManager::Drain(std::size_t queue)
+    {
+        RemoteBlock *block = remote_[queue].exchange(nullptr, std::memory_order_acquire);
+        if (queue == kNumClasses)
+        {
+            // Large and over-aligned blocks are found by address.
+            std::size_t drained = 0;
+            while (block)
+            {
+                RemoteBlock *next = block->next;
+                manager_.Free(block);
+                block = next;
+                drained++;
+            }
+            return drained;
+        }
+
+        // Any request of the class size routes back to the class.
+        const std::size_t class_size = manager_.ClassSize(queue);
+        void *batch[kDrainBatchSize];
+        std::size_t count = 0;
+        std::size_t drained = 0;
+        while (block)
+        {
+            batch[count++] = block;
+            block = block->next;
+            if (count == kDrainBatchSize)
+            {
+                manager_.FreeBatch(batch, count, class_size, sizeof(void *));
+                drained += count;
+                count = 0;
+            }
+        }
+        manager_.FreeBatch(batch, count, class_size, sizeof(void *));
+        return drained + count;
+    }
+
+    std::size_t RemoteFreeSlabManager::CollectRemoteFrees()
+    {
+        std::size_t drained = 0;
+        for (std::size_t queue = 0; queue <= kNumClasses; queue++)
+        {
+            if (remote_[queue].load(std::memory_order_relaxed))
+            {
+                drained += Drain(queue);
+            }
+        }
+        return drained;
+    }
+
+    void RemoteFreeSlabManager::TakeOwnership()
+    {
+        owner_ = std::this_thread::get_id();
+    }
+
+    bool RemoteFreeSlabManager::IsOwner() const
+    {
+        return std::this_thread::get_id() == owner_;
+    }
+
+    std::size_t RemoteFreeSlabManager::Scavenge(ReleaseAdvice advice)
+    {
+        CollectRemoteFrees();
+        return manager_.Scavenge(advice);
+    }
+
+    SlabManagerStats RemoteFreeSlabManager::GetStats() const
+    {
+        return manager_.GetStats();
+    }
+}
@@ -0,0 +1,53 @@
+#include "scavenger.h"
+#include <stdexcept>
+#include <utility>
+
+namespace mcr
+{
+    Scavenger::Scavenger(std::function<std::size_t()> scavenge, std::chrono::milliseconds interval) : scavenge_(std::move(scavenge)), interval_(interval)
+    {
+        if (!scavenge_)
+        {
+            throw std::invalid_argument("Scavenge pass must not be empty.");
+        }
+        if (interval_.count() <= 0)
+        {
+            throw std::invalid_argument("Scavenge interval must be positive.");
+        }
+        thread_ = std::thread(&Scavenger::Run, this);
+    }
+
+    Scavenger::~Scavenger()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        thread_.join();
+    }
+
+    void Scavenger::Run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!wake_.wait_for(lock, interval_, [this]
+                               { return stopping_; }))
+        {
+            // Run the pass unlocked so destruction is not blocked behind the wait mutex.
+            lock.unlock();
+            released_bytes_.fetch_add(scavenge_(), std::memory_order_relaxed);
+            passes_.fetch_add(1, std::memory_order_release);
+            lock.lock();
+        }
+    }
+
+    std::size_t Scavenger::ReleasedBytes() const
+    {
+        return released_bytes_.load(std::memory_order_relaxed);
+    }
+
+    std::size_t Scavenger::Passes() const
+    {
+        return passes_.load(std::memory_order_acquire);
+    }
+}
@@ -1,103 +1,147 @@
 #include "slab_allocator.h"
+#include "pool_memory.h"
 #include <algorithm>
-#include <cstdlib>
 #include <cstddef>
 #include <cstdint>
-#include <stdexcept>
 #include <limits>
 #include <new>
-
-#if defined(_WIN32) || defined(_WIN64)
-#include <malloc.h> // for _aligned_malloc and _aligned_free
-#else
-#include <stdlib.h> // for posix_memalign
-#endif
+#include <numeric>
+#include <stdexcept>
 
 namespace mcr
 {
-    SlabAllocator::SlabAllocator(std::size_t block_size, std::size_t pool_size, std::size_t alignment) : alignment_(alignment)
+    SlabAllocator::SlabAllocator(std::size_t block_size, std::size_t pool_size, std::size_t alignment, const SlabGrowthPolicy &growth, PoolBacking backing) : backing_(backing), owns_pool_(true), free_list_head_(nullptr), growth_(growth)
+    {
+        // Validate the request and derive the effective block size, alignment and block count.
+        // Every block must be large enough to hold an embedded free-list node.
+        const PoolLayout layout = ComputePoolLayout(block_size, pool_size, alignment, sizeof(FreeBlock));
+        block_size_ = layout.block_size;
+        alignment_ = layout.alignment;
+        pool_size_ = layout.PoolSize(); // Trim the backing-pool size to a whole-block multiple.
+        initial_slab_size_ = pool_size_;
+        last_slab_size_ = pool_size_;
+
+        // Allocate the backing pool.
+        pool_ = AllocatePool(pool_size_, alignment_, backing_);
+
+        // Blocks are carved lazily from the frontier; nothing is written to the pool yet.
+        SetFrontier(pool_.start, pool_size_);
+    }
+
+    SlabAllocator::SlabAllocator(std::size_t block_size, void *pool, std::size_t pool_size, std::size_t alignment) : backing_(PoolBacking::kHeap), owns_pool_(false), free_list_head_(nullptr), growth_()
     {
-        // Validate the requested alignment and derive the effective alignment.
-        if (alignment_ == 0 || (alignment_ & (alignment_ - 1)) != 0)
+        const PoolLayout layout = ComputePoolLayout(block_size, pool_size, alignment, sizeof(FreeBlock));
+        if (!pool || reinterpret_cast<std::uintptr_t>(pool) % layout.alignment != 0)
         {
-            throw std::invalid_argument("Alignment must be non-zero and a power of 2.");
+            throw std::invalid_argument("Pool must be non-null and aligned to the effective alignment.");
         }
-        alignment_ = std::max(alignment_, sizeof(void *));
+        block_size_ = layout.block_size;
+        alignment_ = layout.alignment;
+        pool_size_ = layout.PoolSize();
+        initial_slab_size_ = pool_size_;
+        last_slab_size_ = pool_size_;
 
-        // Adjust the final block size.
-        // Ensure the block is large enough to hold an embedded free-list node.
-        block_size = std::max(block_size, sizeof(FreeBlock));
+        // The caller owns the memory; only its geometry is recorded for the frontier and for scavenging.
+        pool_ = PoolRegion{pool, pool_size_, PoolBacking::kHeap};
+        SetFrontier(pool_.start, pool_size_);
+    }
 
-        // Avoid the block size become overflow during round up.
-        const std::size_t max_size = std::numeric_limits<std::size_t>::max();
-        const std::size_t align_padding = alignment_ - 1;
-        if (block_size > max_size - align_padding)
+    SlabAllocator::~SlabAllocator()
+    {
+        // Release the grown slabs and the backing pool.
+        for (const PoolRegion &slab : grown_slabs_)
+        {
+            FreePool(slab);
+        }
+        if (owns_pool_)
         {
-            throw std::invalid_argument("Block size overflow.");
+            FreePool(pool_);
         }
+    }
 
-        // Round the final block size up to the nearest multiple of alignment_.
-        block_size_ = (block_size + align_padding) & ~(align_padding);
+    void SlabAllocator::SetFrontier(void *slab, std::size_t slab_size)
+    {
+        frontier_ = reinterpret_cast<std::uintptr_t>(slab);
+        frontier_end_ = frontier_ + slab_size;
+    }
 
-        // Compute how many whole blocks fit in the requested pool size.
-        std::size_t block_count = pool_size / block_size_;
-        if (block_count == 0)
+    bool SlabAllocator::RefillFrontier()
+    {
+        // Units whose pages are still committed go first; they do not fault on touch.
+        std::vector<std::uintptr_t> &units = !retained_units_.empty() ? retained_units_ : released_units_;
+        if (units.empty())
         {
-            throw std::invalid_argument("Pool size must be able to hold at least one effective block.");
+            return Grow();
         }
 
-        // Trim the backing-pool size to a whole-block multiple.
-        pool_size_ = block_count * block_size_;
+        const std::uintptr_t unit = units.back();
+        units.pop_back();
+        frontier_ = unit;
+        frontier_end_ = unit + ScavengeUnitSize();
+        return true;
+    }
 
-        // Allocate the backing pool.
-#if defined(_WIN32) || defined(_WIN64)
-        pool_start_ = _aligned_malloc(pool_size_, alignment_);
-        if (!pool_start_)
+    bool SlabAllocator::Grow()
+    {
+        if (growth_.growth == SlabGrowth::kNone || pool_size_ >= growth_.max_pool_size)
         {
-            throw std::bad_alloc();
+            return false;
         }
-#else
-        if (posix_memalign(&pool_start_, alignment_, pool_size_) != 0)
+
+        // Pick the next slab size and trim it to the remaining budget in whole blocks.
+        std::size_t slab_size = initial_slab_size_;
+        if (growth_.growth == SlabGrowth::kGeometric)
         {
-            throw std::bad_alloc();
+            const std::size_t max_size = std::numeric_limits<std::size_t>::max();
+            slab_size = (last_slab_size_ > max_size / 2) ? max_size : last_slab_size_ * 2;
         }
-#endif
+        slab_size = std::min(slab_size, growth_.max_pool_size - pool_size_);
+        const std::size_t block_count = slab_size / block_size_;
+        if (block_count == 0)
+        {
+            return false;
+        }
+        slab_size = block_count * block_size_;
 
-        // Link the free list across the pool blocks.
-        free_list_head_ = static_cast<FreeBlock *>(pool_start_);
-        std::uintptr_t current_byte_ptr = reinterpret_cast<std::uintptr_t>(pool_start_);
-        for (std::size_t i = 0; i < block_count - 1; i++)
+        // Running out of system memory while growing is reported like exhaustion.
+        PoolRegion slab;
+        try
         {
-            FreeBlock *current_block = reinterpret_cast<FreeBlock *>(current_byte_ptr);
-            FreeBlock *next_block = reinterpret_cast<FreeBlock *>(current_byte_ptr + block_size_);
-            current_block->next = next_block;
-            current_byte_ptr += block_size_;
+            grown_slabs_.reserve(grown_slabs_.size() + 1);
+            slab = AllocatePool(slab_size, alignment_, backing_);
         }
-        FreeBlock *last_block = reinterpret_cast<FreeBlock *>(current_byte_ptr);
-        last_block->next = nullptr; // Terminate the free list.
-    }
+        catch (const std::bad_alloc &)
+        {
+            return false;
+        }
+        grown_slabs_.push_back(slab);
 
-    SlabAllocator::~SlabAllocator()
-    {
-        // Release the backing pool.
-#if defined(_WIN32) || defined(_WIN64)
-        _aligned_free(pool_start_);
-#else
-        std::free(pool_start_);
-#endif
+        SetFrontier(slab.start, slab_size);
+        pool_size_ += slab_size;
+        last_slab_size_ = slab_size;
+        return true;
     }
 
     void *SlabAllocator::Allocate()
     {
-        // If the allocator is exhausted, return nullptr.
-        if (!free_list_head_)
+        // Pop the head block from the free list.
+        if (free_list_head_)
         {
-            return nullptr;
+            void *allocate_ptr = free_list_head_;
+            free_list_head_ = free_list_head_->next;
+            CountAllocations(1);
+            return allocate_ptr;
         }
 
-        // Pop the head block from the free list.
-        void *allocate_ptr = free_list_head_;
-        free_list_head_ = free_list_head_->next;
+        // Carve a never-used block from the frontier; if the allocator is exhausted and cannot grow, return nullptr.
+        if (frontier_ == frontier_end_ && !RefillFrontier())
+        {
+            CountFailure();
+            return nullptr;
+        }
+        void *allocate_ptr = reinterpret_cast<void *>(frontier_);
+        frontier_ += block_size_;
+        CountAllocations(1);
         return allocate_ptr;
     }
 
@@ -113,5 +157,209 @@ namespace mcr
         FreeBlock *free_block = static_cast<FreeBlock *>(ptr);
         free_block->next = free_list_head_;
         free_list_head_ = free_block;
+        CountFrees(1);
+    }
+
+    std::size_t SlabAllocator::AllocateBatch(std::size_t count, void **out)
+    {
+        // Walk a prefix of the free list and detach it with one head update.
+        std::size_t allocated = 0;
+        FreeBlock *block = free_list_head_;
+        while (block && allocated < count)
+        {
+            out[allocated++] = block;
+            block = block->next;
+        }
+        free_list_head_ = block;
+
+        // Carve the rest from the frontier, growing as needed.
+        while (allocated < count)
+        {
+            if (frontier_ == frontier_end_ && !RefillFrontier())
+            {
+                break;
+            }
+            std::uintptr_t frontier = frontier_;
+            while (frontier != frontier_end_ && allocated < count)
+            {
+                out[allocated++] = reinterpret_cast<void *>(frontier);
+                frontier += block_size_;
+            }
+            frontier_ = frontier;
+        }
+
+        CountAllocations(allocated);
+        if (allocated < count)
+        {
+            CountFailure();
+        }
+        return allocated;
+    }
+
+    void SlabAllocator::FreeBatch(void *const *ptrs, std::size_t count)
+    {
+        // Build the segment back to front so `ptrs[0]` ends up on top, then splice it in.
+        FreeBlock *head = free_list_head_;
+        std::size_t freed = 0;
+        for (std::size_t i = count; i-- > 0;)
+        {
+            if (!ptrs[i])
+            {
+                continue;
+            }
+            FreeBlock *free_block = static_cast<FreeBlock *>(ptrs[i]);
+            free_block->next = head;
+            head = free_block;
+            freed++;
+        }
+        free_list_head_ = head;
+        CountFrees(freed);
+    }
+
+    PoolBacking SlabAllocator::Backing() const
+    {
+        return pool_.backing;
+    }
+
+    SlabStats SlabAllocator::GetStats() const
+    {
+        SlabStats stats;
+        stats.block_size = block_size_;
+        stats.capacity = pool_size_ / block_size_;
+#if MCR_ENABLE_STATS
+        stats.in_use = stats_allocations_ - stats_frees_;
+        stats.peak_in_use = (stats.in_use > stats_peak_in_use_) ? stats.in_use : stats_peak_in_use_;
+        stats.total_allocations = stats_allocations_;
+        stats.failed_allocations = stats_failed_allocations_;
+#endif
+        return stats;
+    }
+
+    std::size_t SlabAllocator::ScavengeUnitSize() const
+    {
+        const std::size_t page_size = SystemPageSize();
+        const std::size_t pages = block_size_ / std::gcd(block_size_, page_size);
+        return (pages > kMaxScavengeUnitPages) ? 0 : pages * page_size;
+    }
+
+    std::size_t SlabAllocator::ReleasedBytes() const
+    {
+        return released_units_.size() * ScavengeUnitSize();
+    }
+
+    std::size_t SlabAllocator::Scavenge(ReleaseAdvice advice)
+    {
+        const std::size_t unit_size = ScavengeUnitSize();
+        if (unit_size == 0 || !free_list_head_)
+        {
+            return 0;
+        }
+        const std::size_t page_size = SystemPageSize();
+        const std::size_t blocks_per_unit = unit_size / block_size_;
+
+        // Whole units of each slab, starting at its first page-aligned block boundary.
+        struct UnitRun
+        {
+            std::uintptr_t first;
+            std::size_t count;
+            std::size_t base; // Index of the run's first unit in `free_counts`.
+        };
+        std::vector<UnitRun> runs;
+        runs.reserve(grown_slabs_.size() + 1);
+        std::size_t total_units = 0;
+        auto add_run = [&](const PoolRegion &slab)
+        {
+            const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(slab.start);
+            const std::uintptr_t end = start + slab.size;
+            std::uintptr_t first = start;
+            while (first % page_size != 0 && first - start < unit_size)
+            {
+                first += block_size_;
+            }
+            if (first % page_size != 0 || first >= end)
+            {
+                return;
+            }
+            const std::size_t count = (end - first) / unit_size;
+            runs.push_back(UnitRun{first, count, total_units});
+            total_units += count;
+        };
+        add_run(pool_);
+        for (const PoolRegion &slab : grown_slabs_)
+        {
+            add_run(slab);
+        }
+        std::sort(runs.begin(), runs.end(), [](const UnitRun &a, const UnitRun &b)
+                  { return a.first < b.first; });
+
+        // Global unit index of a block, or `total_units` if it lies outside every whole unit.
+        auto unit_of = [&](const void *block) -> std::size_t
+        {
+            const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block);
+            auto run = std::upper_bound(runs.begin(), runs.end(), address, [](std::uintptr_t value, const UnitRun &r)
+                                        { return value < r.first; });
+            if (run == runs.begin())
+            {
+                return total_units;
+            }
+            --run;
+            const std::size_t index = (address - run->first) / unit_size;
+            return (index < run->count) ? run->base + index : total_units;
+        };
+
+        // Count the free blocks of every unit.
+        std::vector<std::uint32_t> free_counts(total_units + 1, 0);
+        for (FreeBlock *block = free_list_head_; block; block = block->next)
+        {
+            free_counts[unit_of(block)]++;
+        }
+        std::size_t releasable = 0;
+        for (std::size_t i = 0; i < total_units; i++)
+        {
+            releasable += (free_counts[i] == blocks_per_unit) ? 1 : 0;
+        }
+        if (releasable == 0)
+        {
+            return 0;
+        }
+        released_units_.reserve(released_units_.size() + releasable);
+        retained_units_.reserve(retained_units_.size() + releasable);
+
+        // Unlink the blocks of fully free units before their contents (the links) are discarded.
+        FreeBlock **link = &free_list_head_;
+        while (*link)
+        {
+            if (free_counts[unit_of(*link)] == blocks_per_unit)
+            {
+                *link = (*link)->next;
+            }
+            else
+            {
+                link = &(*link)->next;
+            }
+        }
+
+        std::size_t released_bytes = 0;
+        for (const UnitRun &run : runs)
+        {
+            for (std::size_t i = 0; i < run.count; i++)
+            {
+                if (free_counts[run.base + i] != blocks_per_unit)
+                {
+                    continue;
+                }
+                const std::uintptr_t unit = run.first + i * unit_size;
+                if (ReleasePages(reinterpret_cast<void *>(unit), unit_size, advice))
+                {
+                    released_units_.push_back(unit);
+                    released_bytes += unit_size;
+                }
+                else
+                {
+                    retained_units_.push_back(unit); // Already unlinked; carved again like a released unit.
+                }
+            }
+        }
+        return released_bytes;
     }
 }
\ No newline at end of file
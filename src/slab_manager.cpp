@@ -1,75 +1,197 @@
 #include "slab_manager.h"
 #include <cstddef>
+#include <cstring>
 #include <stdexcept>
 #include <algorithm>
-
-#if defined(_WIN32) || defined(_WIN64)
-#include <intrin.h> // for _BitScanReverse
-#endif
+#include <limits>
 
 namespace mcr
 {
-    SlabManager::SlabManager()
+    namespace
+    {
+        /**
+         * @brief Validate the per-class capacity settings of a configuration.
+         */
+        void ValidateClassCapacity(std::size_t block_size, const SlabManagerConfig &config)
+        {
+            if (config.blocks_per_class == 0)
+            {
+                throw std::invalid_argument("Blocks per class must be non-zero.");
+            }
+            if (config.blocks_per_class > std::numeric_limits<std::size_t>::max() / block_size)
+            {
+                throw std::invalid_argument("Pool size overflow.");
+            }
+            if (config.growth != SlabGrowth::kNone && config.max_blocks_per_class < config.blocks_per_class)
+            {
+                throw std::invalid_argument("Max blocks per class must not be below blocks per class.");
+            }
+        }
+
+        /**
+         * @brief Create the over-aligned pool of one size class, or nullptr if the tier is disabled.
+         */
+        std::unique_ptr<BitmapSlabAllocator> MakeOverAlignedAllocator(std::size_t block_size, const SlabManagerConfig &config)
+        {
+            if (config.over_aligned_blocks_per_class == 0)
+            {
+                return nullptr;
+            }
+            if (config.over_aligned_blocks_per_class > std::numeric_limits<std::size_t>::max() / block_size)
+            {
+                throw std::invalid_argument("Over-aligned pool size overflow.");
+            }
+            return std::make_unique<BitmapSlabAllocator>(block_size, block_size * config.over_aligned_blocks_per_class, block_size, config.backing);
+        }
+
+        /**
+         * @brief Natural alignment of a class: the largest power of 2 dividing its block size.
+         */
+        std::size_t ClassAlignment(std::size_t block_size)
+        {
+            return block_size & (~block_size + 1);
+        }
+
+        /**
+         * @brief Blocks of one class in arena mode: the growth bound if growth is enabled, the initial count otherwise.
+         */
+        std::size_t ArenaClassBlocks(const SlabManagerConfig &config)
+        {
+            return (config.growth != SlabGrowth::kNone) ? config.max_blocks_per_class : config.blocks_per_class;
+        }
+    }
+
+    std::unique_ptr<SlabAllocator> MakeSizeClassAllocator(std::size_t block_size, const SlabManagerConfig &config)
     {
-        std::size_t current_block_size = kMinClassSize; // Start from the smallest managed class size.
+        const std::size_t max_size = std::numeric_limits<std::size_t>::max();
+        ValidateClassCapacity(block_size, config);
 
-        for (std::size_t i = 0; i < kNumClasses; i++)
+        SlabGrowthPolicy growth;
+        growth.growth = config.growth;
+        if (config.growth != SlabGrowth::kNone)
         {
-            std::size_t pool_size = current_block_size * kBlocksPerClass;
-            allocators_[i] = std::make_unique<SlabAllocator>(current_block_size, pool_size, current_block_size); // Align each class to its block size.
-            current_block_size *= 2;
+            // Saturate instead of overflowing; the bound is only compared against the grown size.
+            growth.max_pool_size = (config.max_blocks_per_class > max_size / block_size) ? max_size : config.max_blocks_per_class * block_size;
         }
+
+        const std::size_t pool_size = block_size * config.blocks_per_class;
+        return std::make_unique<SlabAllocator>(block_size, pool_size, ClassAlignment(block_size), growth, config.backing);
     }
 
-    std::size_t SlabManager::GetClassIndex(std::size_t size) const
+    std::unique_ptr<BuddyAllocator> MakeLargeObjectAllocator(std::size_t max_class_size, const SlabManagerConfig &config)
     {
-        if (size <= kMinClassSize)
+        if (config.large_region_size == 0)
         {
-            return 0;
+            return nullptr;
         }
-        if (size > kMaxClassSize)
+        if (config.max_large_block_size <= max_class_size)
         {
-            throw std::invalid_argument("Size exceeds maximum managed class size.");
+            throw std::invalid_argument("Max large block size must exceed the largest size class.");
         }
+        // Power-of-2 class tables make `2 * max_class_size` the next block size; the buddy allocator validates the rest.
+        return std::make_unique<BuddyAllocator>(max_class_size * 2, config.max_large_block_size, config.large_region_size, config.backing);
+    }
 
-        // Use `size - 1` so exact powers of 2 stay in their own class.
-        // For example, size 32 maps to class 32 instead of class 64.
-        std::size_t s = size - 1;
-        unsigned long highest_bit_index = 0; // After the bit scan, this is `floor(log2(size - 1))`.
-#if defined(_WIN32) || defined(_WIN64)
-#ifdef _WIN64
-        _BitScanReverse64(&highest_bit_index, s);
-#else
-        _BitScanReverse(&highest_bit_index, s);
-#endif
-#else
-        highest_bit_index = 63 - __builtin_clzll(static_cast<unsigned long long>(s));
-#endif
+    ClassArena::ClassArena(std::size_t class_span, std::size_t num_classes, PoolBacking backing)
+    {
+        if (class_span == 0 || (class_span & (class_span - 1)) != 0)
+        {
+            throw std::invalid_argument("Class span must be a power of 2.");
+        }
+        if (num_classes == 0 || num_classes > std::numeric_limits<std::size_t>::max() / class_span)
+        {
+            throw std::invalid_argument("Arena size overflow.");
+        }
+        span_log2_ = FloorLog2(class_span);
+        size_ = num_classes * class_span;
 
-        // `floor(log2(size - 1)) + 1` gives `ceil(log2(size))` for this size-class mapping.
-        // kMinClassSize is 16 = 2^4, so subtract log2(16) = 4 to get the zero-based class index.
-        static constexpr unsigned kMinClassLog2 = 4;
-        return static_cast<std::size_t>(highest_bit_index + 1 - kMinClassLog2);
+        // Reserve address space rather than heap memory; untouched pages stay uncommitted.
+        region_ = AllocatePool(size_, class_span, (backing == PoolBacking::kHeap) ? PoolBacking::kMmap : backing);
     }
 
-    void *SlabManager::Allocate(std::size_t size, std::size_t alignment)
+    ClassArena::~ClassArena()
+    {
+        FreePool(region_);
+    }
+
+    std::unique_ptr<ClassArena> MakeClassArena(std::size_t max_class_size, std::size_t num_classes, const SlabManagerConfig &config)
+    {
+        if (!config.contiguous_arena)
+        {
+            return nullptr;
+        }
+        ValidateClassCapacity(max_class_size, config);
+
+        const std::size_t capacity = ArenaClassBlocks(config);
+        if (capacity > std::numeric_limits<std::size_t>::max() / max_class_size)
+        {
+            throw std::invalid_argument("Arena size overflow.");
+        }
+        const std::size_t bytes = capacity * max_class_size;
+        const unsigned span_log2 = (bytes == 1) ? 0 : FloorLog2(bytes - 1) + 1;
+        if (span_log2 >= std::numeric_limits<std::size_t>::digits)
+        {
+            throw std::invalid_argument("Arena size overflow.");
+        }
+        return std::make_unique<ClassArena>(std::size_t{1} << span_log2, num_classes, config.backing);
+    }
+
+    std::unique_ptr<SlabAllocator> MakeArenaClassAllocator(std::size_t block_size, const ClassArena &arena, std::size_t class_idx, const SlabManagerConfig &config)
+    {
+        ValidateClassCapacity(block_size, config);
+        return std::make_unique<SlabAllocator>(block_size, arena.ClassStart(class_idx), block_size * ArenaClassBlocks(config), ClassAlignment(block_size));
+    }
+
+    SlabManager::SlabManager() : SlabManager(SlabManagerConfig{})
+    {
+    }
+
+    SlabManager::SlabManager(const SlabManagerConfig &config)
+        : geometric_(config.class_spacing == ClassSpacing::kGeometric),
+          num_classes_(geometric_ ? GeometricClassPolicy::kNumClasses : SizeClassPolicy::kNumClasses),
+          arena_(MakeClassArena(SizeClassPolicy::kMaxClassSize, num_classes_, config))
     {
-        if (size == 0)
+        if (geometric_ && config.over_aligned_blocks_per_class != 0)
+        {
+            throw std::invalid_argument("Over-aligned tier needs power-of-2 class spacing.");
+        }
+        for (std::size_t i = 0; i < num_classes_; i++)
         {
-            throw std::invalid_argument("Size must be non-zero.");
+            const std::size_t block_size = ClassSize(i);
+            allocators_[i] = arena_ ? MakeArenaClassAllocator(block_size, *arena_, i, config) : MakeSizeClassAllocator(block_size, config);
+            over_aligned_[i] = MakeOverAlignedAllocator(block_size, config);
         }
+        large_ = MakeLargeObjectAllocator(SizeClassPolicy::kMaxClassSize, config);
+    }
 
-        if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    BitmapSlabAllocator *SlabManager::OverAlignedOwner(const void *ptr) const
+    {
+        if (over_aligned_[0])
         {
-            throw std::invalid_argument("Alignment must be non-zero and a power of 2.");
+            for (std::size_t i = 0; i < num_classes_; i++)
+            {
+                if (over_aligned_[i]->Owns(ptr))
+                {
+                    return over_aligned_[i].get();
+                }
+            }
         }
+        return nullptr;
+    }
 
-        std::size_t target_size = std::max(size, alignment); // Ensure the target block size could satisfy both size and alignment.
-        if (target_size > kMaxClassSize)
+    void *SlabManager::Allocate(std::size_t size, std::size_t alignment)
+    {
+        std::size_t target_size = SizeClassPolicy::RoutingKey(size, alignment); // Validates the request and yields `max(size, alignment)`.
+        const std::size_t over_aligned_idx = OverAlignedClass(size, alignment);
+        if (over_aligned_idx != kMaxNumClasses)
         {
-            return nullptr;
+            return over_aligned_[over_aligned_idx]->AllocateAligned(alignment);
         }
-        std::size_t class_idx = GetClassIndex(target_size); // Route by `max(size, alignment)`, `Free()` uses the same policy.
+        if (target_size > SizeClassPolicy::kMaxClassSize)
+        {
+            return large_ ? large_->Allocate(size, alignment) : nullptr;
+        }
+        std::size_t class_idx = ClassIndex(size, alignment); // `Free()` routes with the same class table.
         return allocators_[class_idx]->Allocate();
     }
 
@@ -80,8 +202,198 @@ namespace mcr
             return;
         }
         
+        const std::size_t over_aligned_idx = OverAlignedClass(size, alignment);
+        if (over_aligned_idx != kMaxNumClasses)
+        {
+            over_aligned_[over_aligned_idx]->Free(ptr);
+            return;
+        }
         std::size_t target_size = std::max(size, alignment);
-        std::size_t class_idx = GetClassIndex(target_size); // Route back using the same policy as Allocate().
+        if (large_ && target_size > SizeClassPolicy::kMaxClassSize)
+        {
+            large_->Free(ptr, size, alignment);
+            return;
+        }
+        std::size_t class_idx = ClassIndex(size, alignment); // Route back using the same class table as Allocate().
         allocators_[class_idx]->Free(ptr);
     }
+
+    void *SlabManager::Reallocate(void *ptr, std::size_t old_size, std::size_t new_size, std::size_t alignment)
+    {
+        const std::size_t new_key = SizeClassPolicy::RoutingKey(new_size, alignment);
+        if (!ptr)
+        {
+            return Allocate(new_size, alignment);
+        }
+
+        const std::size_t old_key = std::max(old_size, alignment);
+        const std::size_t old_over_aligned = OverAlignedClass(old_size, alignment);
+        const std::size_t new_over_aligned = OverAlignedClass(new_size, alignment);
+        if (old_over_aligned != kMaxNumClasses || new_over_aligned != kMaxNumClasses)
+        {
+            if (old_over_aligned == new_over_aligned)
+            {
+                return ptr;
+            }
+        }
+        else if (old_key <= SizeClassPolicy::kMaxClassSize && new_key <= SizeClassPolicy::kMaxClassSize)
+        {
+            if (ClassIndex(old_size, alignment) == ClassIndex(new_size, alignment))
+            {
+                return ptr; // The block already holds the whole class size.
+            }
+        }
+        else if (large_ && old_key > SizeClassPolicy::kMaxClassSize && new_key > SizeClassPolicy::kMaxClassSize)
+        {
+            if (large_->Resize(ptr, old_size, new_size, alignment))
+            {
+                return ptr;
+            }
+        }
+
+        void *moved = Allocate(new_size, alignment);
+        if (!moved)
+        {
+            return nullptr;
+        }
+        std::memcpy(moved, ptr, std::min(old_size, new_size));
+        Free(ptr, old_size, alignment);
+        return moved;
+    }
+
+    void SlabManager::Free(void *ptr)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        if (arena_ && arena_->Owns(ptr))
+        {
+            allocators_[arena_->ClassOf(ptr)]->Free(ptr); // Subtract and shift; no size needed.
+            return;
+        }
+        if (large_ && large_->Owns(ptr))
+        {
+            large_->Free(ptr);
+            return;
+        }
+        if (BitmapSlabAllocator *pool = OverAlignedOwner(ptr))
+        {
+            pool->Free(ptr);
+            return;
+        }
+        throw std::invalid_argument("Pointer is not owned by the class arena, the large-object region or the over-aligned tier.");
+    }
+
+    bool SlabManager::Owns(const void *ptr) const
+    {
+        return (arena_ && arena_->Owns(ptr)) || (large_ && large_->Owns(ptr)) || OverAlignedOwner(ptr);
+    }
+
+    std::size_t SlabManager::AllocateBatch(std::size_t count, void **out, std::size_t size, std::size_t alignment)
+    {
+        std::size_t target_size = SizeClassPolicy::RoutingKey(size, alignment);
+        const std::size_t over_aligned_idx = OverAlignedClass(size, alignment);
+        if (over_aligned_idx != kMaxNumClasses)
+        {
+            std::size_t allocated = 0;
+            while (allocated < count)
+            {
+                void *ptr = over_aligned_[over_aligned_idx]->AllocateAligned(alignment);
+                if (!ptr)
+                {
+                    break;
+                }
+                out[allocated++] = ptr;
+            }
+            return allocated;
+        }
+        if (target_size <= SizeClassPolicy::kMaxClassSize)
+        {
+            return allocators_[ClassIndex(size, alignment)]->AllocateBatch(count, out);
+        }
+        if (!large_)
+        {
+            return 0;
+        }
+
+        std::size_t allocated = 0;
+        while (allocated < count)
+        {
+            void *ptr = large_->Allocate(size, alignment);
+            if (!ptr)
+            {
+                break;
+            }
+            out[allocated++] = ptr;
+        }
+        return allocated;
+    }
+
+    void SlabManager::FreeBatch(void *const *ptrs, std::size_t count, std::size_t size, std::size_t alignment)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        const std::size_t over_aligned_idx = OverAlignedClass(size, alignment);
+        if (over_aligned_idx != kMaxNumClasses)
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                over_aligned_[over_aligned_idx]->Free(ptrs[i]);
+            }
+            return;
+        }
+        std::size_t target_size = std::max(size, alignment);
+        if (large_ && target_size > SizeClassPolicy::kMaxClassSize)
+        {
+            for (std::size_t i = 0; i < count; i++)
+            {
+                large_->Free(ptrs[i], size, alignment);
+            }
+            return;
+        }
+        allocators_[ClassIndex(size, alignment)]->FreeBatch(ptrs, count);
+    }
+
+    std::size_t SlabManager::Scavenge(ReleaseAdvice advice)
+    {
+        std::size_t released_bytes = 0;
+        for (std::size_t i = 0; i < num_classes_; i++)
+        {
+            released_bytes += allocators_[i]->Scavenge(advice);
+        }
+        return released_bytes;
+    }
+
+    BuddyStats SlabManager::GetLargeObjectStats() const
+    {
+        return large_ ? large_->GetStats() : BuddyStats{};
+    }
+
+    SlabManagerStats SlabManager::GetStats() const
+    {
+        SlabManagerStats stats;
+        stats.classes.resize(num_classes_);
+        for (std::size_t i = 0; i < num_classes_; i++)
+        {
+            stats.classes[i] = allocators_[i]->GetStats();
+        }
+        if (over_aligned_[0])
+        {
+            stats.over_aligned.resize(num_classes_);
+            for (std::size_t i = 0; i < num_classes_; i++)
+            {
+                SlabStats &pool_stats = stats.over_aligned[i];
+                pool_stats.block_size = SizeClassPolicy::ClassSize(i);
+                pool_stats.capacity = over_aligned_[i]->Capacity();
+                pool_stats.in_use = over_aligned_[i]->InUse();
+            }
+        }
+        stats.large = GetLargeObjectStats();
+        return stats;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,221 @@
+#include "span_slab_manager.h"
+#include "page_heap.h"
+#include "size_class.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace mcr
+{
+    SpanSlabManager::SpanSlabManager(const SpanSlabManagerConfig &config) : heap_(config.heap_size, config.span_size, config.backing)
+    {
+        spans_.resize(heap_.SpanCount());
+        for (std::size_t i = 0; i < kNumClasses; i++)
+        {
+            SizeClass &size_class = classes_[i];
+            size_class.block_size = SizeClassPolicy::ClassSize(i);
+            size_class.blocks_per_span = static_cast<std::uint32_t>(heap_.SpanSize() / size_class.block_size);
+            size_class.max_spans = config.max_spans_per_class;
+        }
+    }
+
+    void SpanSlabManager::PushPartial(SizeClass &size_class, std::uint32_t index)
+    {
+        Span &span = spans_[index];
+        span.prev = kNone;
+        span.next = size_class.partial;
+        if (size_class.partial != kNone)
+        {
+            spans_[size_class.partial].prev = index;
+        }
+        size_class.partial = index;
+    }
+
+    void SpanSlabManager::UnlinkPartial(SizeClass &size_class, std::uint32_t index)
+    {
+        Span &span = spans_[index];
+        if (span.prev != kNone)
+        {
+            spans_[span.prev].next = span.next;
+        }
+        else
+        {
+            size_class.partial = span.next;
+        }
+        if (span.next != kNone)
+        {
+            spans_[span.next].prev = span.prev;
+        }
+    }
+
+    bool SpanSlabManager::AddSpan(std::size_t class_idx)
+    {
+        SizeClass &size_class = classes_[class_idx];
+        if (size_class.max_spans != 0 && size_class.spans >= size_class.max_spans)
+        {
+            return false;
+        }
+        void *start = heap_.AllocateSpan();
+        if (!start)
+        {
+            return false;
+        }
+
+        // Blocks are carved lazily through the span's frontier, so nothing is written to the span yet.
+        const std::uint32_t index = static_cast<std::uint32_t>(heap_.SpanIndex(start));
+        spans_[index] = Span{};
+        spans_[index].class_idx = static_cast<std::uint32_t>(class_idx);
+        PushPartial(size_class, index);
+        size_class.spans++;
+        return true;
+    }
+
+    void SpanSlabManager::RemoveSpan(std::size_t class_idx, std::uint32_t index)
+    {
+        SizeClass &size_class = classes_[class_idx];
+        UnlinkPartial(size_class, index);
+        spans_[index].class_idx = kNone;
+        size_class.spans--;
+        heap_.FreeSpan(heap_.SpanAddress(index));
+    }
+
+    void *SpanSlabManager::Allocate(std::size_t size, std::size_t alignment)
+    {
+        const std::size_t target_size = SizeClassPolicy::RoutingKey(size, alignment);
+        if (target_size > SizeClassPolicy::kMaxClassSize)
+        {
+            return nullptr;
+        }
+        const std::size_t class_idx = SizeClassPolicy::ClassIndex(target_size);
+        SizeClass &size_class = classes_[class_idx];
+
+        if (size_class.partial == kNone && !AddSpan(class_idx))
+        {
+#if MCR_ENABLE_STATS
+            size_class.stats_failed_allocations++;
+#endif
+            return nullptr;
+        }
+
+        // Recycled blocks first, then the span's frontier.
+        const std::uint32_t index = size_class.partial;
+        Span &span = spans_[index];
+        void *block;
+        if (span.free_list)
+        {
+            block = span.free_list;
+            span.free_list = span.free_list->next;
+        }
+        else
+        {
+            block = static_cast<char *>(heap_.SpanAddress(index)) + std::size_t{span.carved} * size_class.block_size;
+            span.carved++;
+        }
+
+        if (++span.in_use == size_class.blocks_per_span)
+        {
+            UnlinkPartial(size_class, index); // Full spans leave the list until a block comes back.
+        }
+#if MCR_ENABLE_STATS
+        size_class.stats_allocations++;
+#endif
+        return block;
+    }
+
+    void SpanSlabManager::FreeToSpan(void *ptr)
+    {
+        const std::uint32_t index = static_cast<std::uint32_t>(heap_.SpanIndex(ptr));
+        Span &span = spans_[index];
+        const std::size_t class_idx = span.class_idx;
+        SizeClass &size_class = classes_[class_idx];
+#if MCR_ENABLE_STATS
+        const std::size_t in_use = size_class.stats_allocations - size_class.stats_frees;
+        size_class.stats_peak_in_use = (in_use > size_class.stats_peak_in_use) ? in_use : size_class.stats_peak_in_use;
+        size_class.stats_frees++;
+#endif
+
+        if (span.in_use == size_class.blocks_per_span)
+        {
+            PushPartial(size_class, index);
+        }
+        FreeBlock *free_block = static_cast<FreeBlock *>(ptr);
+        free_block->next = span.free_list;
+        span.free_list = free_block;
+
+        // Empty spans go back to the heap for any class to use; the last one stays to absorb allocate/free churn.
+        if (--span.in_use == 0 && size_class.spans > 1)
+        {
+            RemoveSpan(class_idx, index);
+        }
+    }
+
+    void SpanSlabManager::Free(void *ptr, std::size_t, std::size_t)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+        FreeToSpan(ptr);
+    }
+
+    void SpanSlabManager::Free(void *ptr)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+        if (!Owns(ptr))
+        {
+            throw std::invalid_argument("Pointer does not lie in a span held by a size class.");
+        }
+        FreeToSpan(ptr);
+    }
+
+    bool SpanSlabManager::Owns(const void *ptr) const
+    {
+        return heap_.Owns(ptr) && spans_[heap_.SpanIndex(ptr)].class_idx != kNone;
+    }
+
+    void SpanSlabManager::SetSpanLimit(std::size_t size, std::size_t max_spans)
+    {
+        if (size == 0 || size > SizeClassPolicy::kMaxClassSize)
+        {
+            throw std::invalid_argument("Size must be non-zero and at most kMaxClassSize.");
+        }
+        classes_[SizeClassPolicy::ClassIndex(size)].max_spans = max_spans;
+    }
+
+    std::size_t SpanSlabManager::Scavenge(ReleaseAdvice advice)
+    {
+        for (std::size_t i = 0; i < kNumClasses; i++)
+        {
+            // A kept empty span is the class's only span, so it heads the list of spans with free blocks.
+            const std::uint32_t index = classes_[i].partial;
+            if (index != kNone && spans_[index].in_use == 0)
+            {
+                RemoveSpan(i, index);
+            }
+        }
+        return heap_.Release(advice);
+    }
+
+    SpanSlabManagerStats SpanSlabManager::GetStats() const
+    {
+        SpanSlabManagerStats stats;
+        for (std::size_t i = 0; i < kNumClasses; i++)
+        {
+            const SizeClass &size_class = classes_[i];
+            SlabStats &class_stats = stats.classes[i];
+            class_stats.block_size = size_class.block_size;
+            class_stats.capacity = size_class.spans * size_class.blocks_per_span;
+#if MCR_ENABLE_STATS
+            class_stats.in_use = size_class.stats_allocations - size_class.stats_frees;
+            class_stats.peak_in_use = (class_stats.in_use > size_class.stats_peak_in_use) ? class_stats.in_use : size_class.stats_peak_in_use;
+            class_stats.total_allocations = size_class.stats_allocations;
+            class_stats.failed_allocations = size_class.stats_failed_allocations;
+#endif
+        }
+        stats.heap = heap_.GetStats();
+        return stats;
+    }
+}
@@ -0,0 +1,468 @@
+#include "thread_cached_slab_manager.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+namespace mcr
+{
+    namespace
+    {
+        /**
+         * @brief Source of process-unique manager ids; 0 is reserved for "no cache looked up yet".
+         */
+        std::atomic<std::uint64_t> g_next_manager_id{1};
+
+        /**
+         * @brief Set once the calling thread's cache list is destroyed; trivially destructible, so it stays readable afterwards.
+         */
+        thread_local bool t_caches_released = false;
+
+        SlabManagerConfig FixedCapacityConfig(std::size_t blocks_per_class)
+        {
+            SlabManagerConfig config;
+            config.blocks_per_class = blocks_per_class;
+            return config;
+        }
+
+#if MCR_ENABLE_STATS
+        /**
+         * @brief Add to a counter only its owning thread writes; a relaxed load and store, no read-modify-write.
+         */
+        void Bump(std::atomic<std::size_t> &counter)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+#endif
+    }
+
+    /**
+     * @brief One thread's cached blocks for one manager.
+     */
+    struct ThreadCachedSlabManager::ThreadCache
+    {
+        /**
+         * @brief LIFO stack of cached blocks of one size class; the top is the most recently freed block.
+         */
+        struct Bin
+        {
+            std::size_t count = 0;
+            std::array<void *, kThreadCacheCapacity> blocks;
+
+#if MCR_ENABLE_STATS
+            /**
+             * @brief Written by the owning thread only; atomic so `GetStats()` may read them from another thread.
+             */
+            std::atomic<std::size_t> stats_allocations{0};
+            std::atomic<std::size_t> stats_frees{0};
+            std::atomic<std::size_t> stats_failed_allocations{0};
+#endif
+        };
+
+        explicit ThreadCache(ThreadCachedSlabManager *manager) : owner(manager), owner_id(manager->id_) {}
+
+        /**
+         * @brief Serializes thread exit against manager destruction.
+         */
+        std::mutex detach_mutex;
+
+        /**
+         * @brief The manager this cache belongs to; nullptr once the manager has been destroyed.
+         */
+        ThreadCachedSlabManager *owner;
+
+        const std::uint64_t owner_id;
+
+        std::array<Bin, kNumClasses> bins{};
+
+        /**
+         * @brief Hand the cached blocks back to the owner if it is still alive.
+         */
+        void Detach()
+        {
+            std::lock_guard<std::mutex> lock(detach_mutex);
+            if (owner)
+            {
+                owner->ReleaseThreadCache(*this);
+                owner = nullptr;
+            }
+        }
+
+        /**
+         * @brief Check whether the owner has been destroyed.
+         */
+        bool IsOrphaned()
+        {
+            std::lock_guard<std::mutex> lock(detach_mutex);
+            return owner == nullptr;
+        }
+    };
+
+    /**
+     * @brief All caches of one thread, detached when the thread exits.
+     */
+    struct ThreadCachedSlabManager::ThreadCacheList
+    {
+        /**
+         * @brief One-entry lookup cache for the manager used most recently by this thread.
+         */
+        std::uint64_t last_id = 0;
+        ThreadCache *last = nullptr;
+
+        std::vector<std::shared_ptr<ThreadCache>> caches;
+
+        ~ThreadCacheList()
+        {
+            // Destructors that run after this one (other thread_locals, pthread keys, exit handlers)
+            // may still allocate or free; send them past the caches to the shared pools.
+            t_caches_released = true;
+            for (const std::shared_ptr<ThreadCache> &cache : caches)
+            {
+                cache->Detach();
+            }
+        }
+    };
+
+    ThreadCachedSlabManager::ThreadCachedSlabManager(std::size_t blocks_per_class) : ThreadCachedSlabManager(FixedCapacityConfig(blocks_per_class))
+    {
+    }
+
+    ThreadCachedSlabManager::ThreadCachedSlabManager(const SlabManagerConfig &config) : id_(g_next_manager_id.fetch_add(1, std::memory_order_relaxed)), arena_(MakeClassArena(SizeClassPolicy::kMaxClassSize, kNumClasses, config))
+    {
+        for (std::size_t i = 0; i < kNumClasses; i++)
+        {
+            const std::size_t block_size = SizeClassPolicy::ClassSize(i);
+            central_[i].allocator = arena_ ? MakeArenaClassAllocator(block_size, *arena_, i, config) : MakeSizeClassAllocator(block_size, config);
+        }
+        large_ = MakeLargeObjectAllocator(SizeClassPolicy::kMaxClassSize, config);
+    }
+
+    ThreadCachedSlabManager::~ThreadCachedSlabManager()
+    {
+        // Take the registry first so exiting threads no longer find themselves in it,
+        // then orphan each cache. Locking `detach_mutex` waits out any thread that is
+        // flushing into the shared pools right now.
+        std::vector<std::shared_ptr<ThreadCache>> caches;
+        {
+            std::lock_guard<std::mutex> lock(caches_mutex_);
+            caches.swap(caches_);
+        }
+
+        for (const std::shared_ptr<ThreadCache> &cache : caches)
+        {
+            std::lock_guard<std::mutex> lock(cache->detach_mutex);
+            cache->owner = nullptr;
+        }
+    }
+
+    ThreadCachedSlabManager::ThreadCacheList &ThreadCachedSlabManager::ThreadCaches()
+    {
+        static thread_local ThreadCacheList list;
+        return list;
+    }
+
+    ThreadCachedSlabManager::ThreadCache *ThreadCachedSlabManager::LocalCache()
+    {
+        // Checked before the list is touched: after thread exit it is destroyed and must not be read.
+        if (t_caches_released)
+        {
+            return nullptr;
+        }
+        ThreadCacheList &list = ThreadCaches();
+        if (list.last_id == id_)
+        {
+            return list.last;
+        }
+        return LocalCacheSlow(list);
+    }
+
+    ThreadCachedSlabManager::ThreadCache *ThreadCachedSlabManager::LocalCacheSlow(ThreadCacheList &list)
+    {
+        ThreadCache *found = nullptr;
+        for (const std::shared_ptr<ThreadCache> &cache : list.caches)
+        {
+            if (cache->owner_id == id_)
+            {
+                found = cache.get();
+                break;
+            }
+        }
+
+        if (!found)
+        {
+            // Drop caches whose managers are gone before adding a new one.
+            list.caches.erase(std::remove_if(list.caches.begin(), list.caches.end(),
+                                             [](const std::shared_ptr<ThreadCache> &cache)
+                                             { return cache->IsOrphaned(); }),
+                              list.caches.end());
+
+            std::shared_ptr<ThreadCache> cache = std::make_shared<ThreadCache>(this);
+            {
+                std::lock_guard<std::mutex> lock(caches_mutex_);
+                caches_.push_back(cache);
+            }
+            list.caches.push_back(cache);
+            found = cache.get();
+        }
+
+        list.last_id = id_;
+        list.last = found;
+        return found;
+    }
+
+    bool ThreadCachedSlabManager::Refill(ThreadCache &cache, std::size_t class_idx)
+    {
+        ThreadCache::Bin &bin = cache.bins[class_idx];
+        CentralClass &central = central_[class_idx];
+
+        std::lock_guard<std::mutex> lock(central.mutex);
+        if (bin.count < kTransferBatchSize)
+        {
+            bin.count += central.allocator->AllocateBatch(kTransferBatchSize - bin.count, bin.blocks.data() + bin.count);
+        }
+        return bin.count != 0;
+    }
+
+    void ThreadCachedSlabManager::Flush(ThreadCache &cache, std::size_t class_idx, std::size_t count)
+    {
+        ThreadCache::Bin &bin = cache.bins[class_idx];
+        CentralClass &central = central_[class_idx];
+        count = std::min(count, bin.count);
+
+        {
+            std::lock_guard<std::mutex> lock(central.mutex);
+            central.allocator->FreeBatch(bin.blocks.data(), count);
+        }
+
+        // Keep the most recently freed (cache-hot) blocks; they sit on top of the stack.
+        std::copy(bin.blocks.begin() + count, bin.blocks.begin() + bin.count, bin.blocks.begin());
+        bin.count -= count;
+    }
+
+    void ThreadCachedSlabManager::ReleaseThreadCache(ThreadCache &cache)
+    {
+        // Held throughout, so `GetStats()` sees the cache's counters either in the registry or folded into the classes.
+        std::lock_guard<std::mutex> lock(caches_mutex_);
+        for (std::size_t i = 0; i < kNumClasses; i++)
+        {
+            Flush(cache, i, cache.bins[i].count);
+#if MCR_ENABLE_STATS
+            const ThreadCache::Bin &bin = cache.bins[i];
+            CentralClass &central = central_[i];
+            std::lock_guard<std::mutex> central_lock(central.mutex);
+            central.stats_allocations += bin.stats_allocations.load(std::memory_order_relaxed);
+            central.stats_frees += bin.stats_frees.load(std::memory_order_relaxed);
+            central.stats_failed_allocations += bin.stats_failed_allocations.load(std::memory_order_relaxed);
+#endif
+        }
+
+        caches_.erase(std::remove_if(caches_.begin(), caches_.end(),
+                                     [&cache](const std::shared_ptr<ThreadCache> &registered)
+                                     { return registered.get() == &cache; }),
+                      caches_.end());
+    }
+
+    void *ThreadCachedSlabManager::Allocate(std::size_t size, std::size_t alignment)
+    {
+        std::size_t target_size = SizeClassPolicy::RoutingKey(size, alignment);
+        if (target_size > SizeClassPolicy::kMaxClassSize)
+        {
+            if (!large_)
+            {
+                return nullptr;
+            }
+            std::lock_guard<std::mutex> lock(large_mutex_);
+            return large_->Allocate(size, alignment);
+        }
+        std::size_t class_idx = SizeClassPolicy::ClassIndex(target_size);
+
+        ThreadCache *cache = LocalCache();
+        if (!cache)
+        {
+            CentralClass &central = central_[class_idx];
+            std::lock_guard<std::mutex> lock(central.mutex);
+            void *ptr = central.allocator->Allocate();
+#if MCR_ENABLE_STATS
+            (ptr ? central.stats_allocations : central.stats_failed_allocations)++;
+#endif
+            return ptr;
+        }
+        ThreadCache::Bin &bin = cache->bins[class_idx];
+        if (bin.count == 0 && !Refill(*cache, class_idx))
+        {
+#if MCR_ENABLE_STATS
+            Bump(bin.stats_failed_allocations);
+#endif
+            return nullptr;
+        }
+#if MCR_ENABLE_STATS
+        Bump(bin.stats_allocations);
+#endif
+        return bin.blocks[--bin.count];
+    }
+
+    void ThreadCachedSlabManager::Free(void *ptr, std::size_t size, std::size_t alignment)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        std::size_t target_size = std::max(size, alignment);
+        if (large_ && target_size > SizeClassPolicy::kMaxClassSize)
+        {
+            std::lock_guard<std::mutex> lock(large_mutex_);
+            large_->Free(ptr, size, alignment);
+            return;
+        }
+        std::size_t class_idx = SizeClassPolicy::ClassIndex(target_size); // Route back using the same policy as Allocate().
+        FreeToCache(ptr, class_idx);
+    }
+
+    void ThreadCachedSlabManager::Free(void *ptr)
+    {
+        if (!ptr)
+        {
+            return;
+        }
+
+        if (arena_ && arena_->Owns(ptr))
+        {
+            FreeToCache(ptr, arena_->ClassOf(ptr));
+            return;
+        }
+        if (large_ && large_->Owns(ptr))
+        {
+            std::lock_guard<std::mutex> lock(large_mutex_);
+            large_->Free(ptr);
+            return;
+        }
+        throw std::invalid_argument("Pointer is not owned by the class arena or the large-object region.");
+    }
+
+    bool ThreadCachedSlabManager::Owns(const void *ptr) const
+    {
+        return (arena_ && arena_->Owns(ptr)) || (large_ && large_->Owns(ptr));
+    }
+
+    std::size_t ThreadCachedSlabManager::ArenaBlockSize(const void *ptr) const
+    {
+        return (arena_ && arena_->Owns(ptr)) ? SizeClassPolicy::ClassSize(arena_->ClassOf(ptr)) : 0;
+    }
+
+    void ThreadCachedSlabManager::FreeToCache(void *ptr, std::size_t class_idx)
+    {
+        ThreadCache *cache = LocalCache();
+        if (!cache)
+        {
+            CentralClass &central = central_[class_idx];
+            std::lock_guard<std::mutex> lock(central.mutex);
+            central.allocator->Free(ptr);
+#if MCR_ENABLE_STATS
+            central.stats_frees++;
+#endif
+            return;
+        }
+        ThreadCache::Bin &bin = cache->bins[class_idx];
+        if (bin.count == kThreadCacheCapacity)
+        {
+            Flush(*cache, class_idx, kTransferBatchSize);
+        }
+        bin.blocks[bin.count++] = ptr;
+#if MCR_ENABLE_STATS
+        Bump(bin.stats_frees);
+#endif
+    }
+
+    void ThreadCachedSlabManager::FlushThreadCache()
+    {
+        ThreadCache *cache = LocalCache();
+        if (!cache)
+        {
+            return;
+        }
+        for (std::size_t i = 0; i < kNumClasses; i++)
+        {
+            Flush(*cache, i, cache->bins[i].count);
+        }
+    }
+
+    void ThreadCachedSlabManager::LockForFork()
+    {
+        // Same order as `ReleaseThreadCache()` and `GetStats()`; `large_mutex_` is never held with another lock.
+        caches_mutex_.lock();
+        for (CentralClass &central : central_)
+        {
+            central.mutex.lock();
+        }
+        large_mutex_.lock();
+    }
+
+    void ThreadCachedSlabManager::UnlockAfterFork()
+    {
+        large_mutex_.unlock();
+        for (std::size_t i = kNumClasses; i-- > 0;)
+        {
+            central_[i].mutex.unlock();
+        }
+        caches_mutex_.unlock();
+    }
+
+    std::size_t ThreadCachedSlabManager::Scavenge(ReleaseAdvice advice)
+    {
+        std::size_t released_bytes = 0;
+        for (CentralClass &central : central_)
+        {
+            std::lock_guard<std::mutex> lock(central.mutex);
+            released_bytes += central.allocator->Scavenge(advice);
+        }
+        return released_bytes;
+    }
+
+    BuddyStats ThreadCachedSlabManager::GetLargeObjectStats()
+    {
+        if (!large_)
+        {
+            return BuddyStats{};
+        }
+        std::lock_guard<std::mutex> lock(large_mutex_);
+        return large_->GetStats();
+    }
+
+    SlabManagerStats ThreadCachedSlabManager::GetStats()
+    {
+        SlabManagerStats stats;
+        stats.classes.resize(kNumClasses);
+        {
+            std::lock_guard<std::mutex> lock(caches_mutex_);
+            for (std::size_t i = 0; i < kNumClasses; i++)
+            {
+                CentralClass &central = central_[i];
+                std::lock_guard<std::mutex> central_lock(central.mutex);
+                SlabStats &class_stats = stats.classes[i];
+                class_stats = central.allocator->GetStats(); // Counts blocks parked in caches as taken; replaced below.
+#if MCR_ENABLE_STATS
+                std::size_t allocations = central.stats_allocations;
+                std::size_t frees = central.stats_frees;
+                std::size_t failed_allocations = central.stats_failed_allocations;
+                for (const std::shared_ptr<ThreadCache> &cache : caches_)
+                {
+                    const ThreadCache::Bin &bin = cache->bins[i];
+                    allocations += bin.stats_allocations.load(std::memory_order_relaxed);
+                    frees += bin.stats_frees.load(std::memory_order_relaxed);
+                    failed_allocations += bin.stats_failed_allocations.load(std::memory_order_relaxed);
+                }
+
+                // A block freed on another thread may be counted before its allocation is visible here.
+                class_stats.in_use = (allocations > frees) ? allocations - frees : 0;
+                class_stats.peak_in_use = std::max(class_stats.peak_in_use, class_stats.in_use);
+                class_stats.total_allocations = allocations;
+                class_stats.failed_allocations = failed_allocations;
+#endif
+            }
+        }
+        stats.large = GetLargeObjectStats();
+        return stats;
+    }
+}
@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+#include "allocation_trace.h"
+#include "slab_manager.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    mcr::TraceEvent Event(mcr::TraceOp op, std::uint64_t address, std::uint32_t size)
+    {
+        mcr::TraceEvent event{};
+        event.address = address;
+        event.size = size;
+        event.alignment_log2 = 3;
+        event.op = op;
+        return event;
+    }
+
+    std::string TempPath(const char *name)
+    {
+        return testing::TempDir() + name;
+    }
+}
+
+// ------------------------------------------------------------
+// Recording.
+// ------------------------------------------------------------
+
+TEST(AllocationTraceTest, RecorderDrainsEventsInOrderAndDropsWhenFull)
+{
+    mcr::TraceRecorder recorder(3);
+    EXPECT_EQ(recorder.Capacity(), 4);
+
+    int objects[5];
+    for (int &object : objects)
+    {
+        recorder.Record(mcr::TraceOp::kAllocate, &object, 24, 8);
+    }
+    EXPECT_EQ(recorder.Dropped(), 1);
+
+    std::vector<mcr::TraceEvent> events;
+    EXPECT_EQ(recorder.Drain(events), 4);
+    ASSERT_EQ(events.size(), 4);
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(events[i].address, reinterpret_cast<std::uintptr_t>(&objects[i]));
+        EXPECT_EQ(events[i].size, 24);
+        EXPECT_EQ(events[i].alignment_log2, 3);
+    }
+
+    // Drained slots are reusable on the next lap.
+    EXPECT_TRUE(recorder.Record(mcr::TraceOp::kFree, &objects[0], 24, 8));
+    EXPECT_EQ(recorder.Drain(events), 1);
+    EXPECT_EQ(events.back().op, mcr::TraceOp::kFree);
+}
+
+TEST(AllocationTraceTest, ConcurrentProducersLoseNoEvents)
+{
+    constexpr int kThreads = 4;
+    constexpr int kEventsPerThread = 2000;
+    mcr::TraceRecorder recorder(kThreads * kEventsPerThread);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++)
+    {
+        threads.emplace_back([&recorder, t]
+                             {
+            for (int i = 0; i < kEventsPerThread; i++)
+            {
+                recorder.Record(mcr::TraceOp::kAllocate, reinterpret_cast<void *>(static_cast<std::uintptr_t>(t * kEventsPerThread + i + 1)), 16, 16);
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<mcr::TraceEvent> events;
+    recorder.Drain(events);
+    EXPECT_EQ(recorder.Dropped(), 0);
+    std::set<std::uint64_t> addresses;
+    for (const mcr::TraceEvent &event : events)
+    {
+        addresses.insert(event.address);
+    }
+    EXPECT_EQ(addresses.size(), static_cast<std::size_t>(kThreads * kEventsPerThread));
+}
+
+TEST(AllocationTraceTest, RecordingManagerRecordsSuccessfulCalls)
+{
+    mcr::SlabManagerConfig config;
+    config.blocks_per_class = 1;
+    mcr::SlabManager manager(config);
+    mcr::TraceRecorder recorder;
+    mcr::RecordingManager<mcr::SlabManager> recording(manager, recorder);
+
+    void *ptr = recording.Allocate(40);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(recording.Allocate(40), nullptr); // Not recorded.
+    recording.Free(ptr, 40, sizeof(void *));
+
+    std::vector<mcr::TraceEvent> events;
+    ASSERT_EQ(recorder.Drain(events), 2);
+    EXPECT_EQ(events[0].op, mcr::TraceOp::kAllocate);
+    EXPECT_EQ(events[1].op, mcr::TraceOp::kFree);
+    EXPECT_EQ(events[0].address, events[1].address);
+}
+
+// ------------------------------------------------------------
+// Trace files and replay.
+// ------------------------------------------------------------
+
+TEST(AllocationTraceTest, TraceFileRoundTrips)
+{
+    const std::string path = TempPath("mcr_roundtrip.trace");
+    const std::vector<mcr::TraceEvent> events = {Event(mcr::TraceOp::kAllocate, 0x10, 24), Event(mcr::TraceOp::kFree, 0x10, 24)};
+    mcr::WriteTraceFile(path, events);
+
+    const std::vector<mcr::TraceEvent> loaded = mcr::ReadTraceFile(path);
+    ASSERT_EQ(loaded.size(), events.size());
+    EXPECT_EQ(loaded[1].address, 0x10);
+    EXPECT_EQ(loaded[1].op, mcr::TraceOp::kFree);
+    std::remove(path.c_str());
+}
+
+TEST(AllocationTraceTest, MalformedTraceFilesThrowRuntimeError)
+{
+    EXPECT_THROW({ mcr::ReadTraceFile(TempPath("mcr_missing.trace")); }, std::runtime_error);
+
+    const std::string path = TempPath("mcr_bad.trace");
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "NOTATRACE-----------------------";
+    }
+    EXPECT_THROW({ mcr::ReadTraceFile(path); }, std::runtime_error);
+
+    // A valid header whose count exceeds the records on disk.
+    mcr::WriteTraceFile(path, {Event(mcr::TraceOp::kAllocate, 0x10, 24), Event(mcr::TraceOp::kFree, 0x10, 24)});
+    std::vector<char> bytes;
+    {
+        std::ifstream file(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 1));
+    }
+    EXPECT_THROW({ mcr::ReadTraceFile(path); }, std::runtime_error);
+    std::remove(path.c_str());
+}
+
+TEST(AllocationTraceTest, ReplayPlanReusesSlotsAndReleasesLeftovers)
+{
+    // 0x10 and 0x20 overlap, 0x10 is reused after its free, 0x30 is never freed, 0x40 was allocated before recording.
+    const std::vector<mcr::TraceEvent> events = {
+        Event(mcr::TraceOp::kAllocate, 0x10, 100),
+        Event(mcr::TraceOp::kAllocate, 0x20, 50),
+        Event(mcr::TraceOp::kFree, 0x10, 100),
+        Event(mcr::TraceOp::kFree, 0x40, 8),
+        Event(mcr::TraceOp::kAllocate, 0x10, 30),
+        Event(mcr::TraceOp::kFree, 0x20, 50),
+        Event(mcr::TraceOp::kAllocate, 0x30, 20),
+        Event(mcr::TraceOp::kFree, 0x10, 30),
+    };
+    const mcr::ReplayPlan plan = mcr::BuildReplayPlan(events);
+
+    EXPECT_EQ(plan.slot_count, 2);
+    EXPECT_EQ(plan.peak_live_bytes, 150);
+    ASSERT_EQ(plan.ops.size(), 8); // The foreign free is dropped; a free for 0x30 is appended.
+    EXPECT_EQ(plan.ops[3].slot, plan.ops[0].slot);
+    EXPECT_EQ(plan.ops.back().op, mcr::TraceOp::kFree);
+    EXPECT_EQ(plan.ops.back().size, 20);
+
+    mcr::SlabManager manager;
+    std::vector<void *> table;
+    std::size_t live = 0;
+    const std::size_t failures = mcr::ReplayTrace(
+        plan, table,
+        [&](std::size_t size, std::size_t alignment)
+        {
+            live++;
+            return manager.Allocate(size, alignment);
+        },
+        [&](void *ptr, std::size_t size, std::size_t alignment)
+        {
+            live--;
+            manager.Free(ptr, size, alignment);
+        });
+    EXPECT_EQ(failures, 0);
+    EXPECT_EQ(live, 0);
+}
+
+TEST(AllocationTraceTest, ReplayPlanFreesObjectDisplacedByRepeatedAddress)
+{
+    // 0x10 is allocated twice with the free in between lost.
+    const std::vector<mcr::TraceEvent> events = {
+        Event(mcr::TraceOp::kAllocate, 0x10, 100),
+        Event(mcr::TraceOp::kAllocate, 0x10, 40),
+        Event(mcr::TraceOp::kFree, 0x10, 40),
+    };
+    const mcr::ReplayPlan plan = mcr::BuildReplayPlan(events);
+
+    EXPECT_EQ(plan.slot_count, 1);
+    EXPECT_EQ(plan.peak_live_bytes, 100);
+    ASSERT_EQ(plan.ops.size(), 4);
+    EXPECT_EQ(plan.ops[1].op, mcr::TraceOp::kFree);
+    EXPECT_EQ(plan.ops[1].size, 100);
+    EXPECT_EQ(plan.ops[2].op, mcr::TraceOp::kAllocate);
+    EXPECT_EQ(plan.ops[3].size, 40);
+
+    mcr::SlabManager manager;
+    std::vector<void *> table;
+    std::size_t live = 0;
+    const std::size_t failures = mcr::ReplayTrace(
+        plan, table,
+        [&](std::size_t size, std::size_t alignment)
+        {
+            live++;
+            return manager.Allocate(size, alignment);
+        },
+        [&](void *ptr, std::size_t size, std::size_t alignment)
+        {
+            live--;
+            manager.Free(ptr, size, alignment);
+        });
+    EXPECT_EQ(failures, 0);
+    EXPECT_EQ(live, 0);
+}
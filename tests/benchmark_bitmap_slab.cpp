@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include <bitmap_slab_allocator.h>
+#include <slab_allocator.h>
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t kBlockSize = 64;
+
+    // Allocate every block, then free them all, per iteration.
+    template <typename Allocator>
+    void RunFillDrain(benchmark::State &state)
+    {
+        const std::size_t blocks = static_cast<std::size_t>(state.range(0));
+        Allocator allocator(kBlockSize, kBlockSize * blocks);
+        std::vector<void *> pointers(blocks);
+
+        for (auto _ : state)
+        {
+            for (void *&ptr : pointers)
+            {
+                ptr = allocator.Allocate();
+            }
+            benchmark::DoNotOptimize(pointers.data());
+            for (void *ptr : pointers)
+            {
+                allocator.Free(ptr);
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * blocks));
+    }
+
+    // Fill the pool once, then per iteration free a random half and allocate it back.
+    template <typename Allocator>
+    void RunScatteredRefill(benchmark::State &state)
+    {
+        const std::size_t blocks = static_cast<std::size_t>(state.range(0));
+        Allocator allocator(kBlockSize, kBlockSize * blocks);
+        std::vector<void *> pointers(blocks);
+        for (void *&ptr : pointers)
+        {
+            ptr = allocator.Allocate();
+        }
+
+        std::mt19937 rng(42);
+        const std::size_t half = blocks / 2;
+        for (auto _ : state)
+        {
+            state.PauseTiming();
+            std::shuffle(pointers.begin(), pointers.end(), rng);
+            state.ResumeTiming();
+
+            for (std::size_t i = 0; i < half; i++)
+            {
+                allocator.Free(pointers[i]);
+            }
+            for (std::size_t i = 0; i < half; i++)
+            {
+                pointers[i] = allocator.Allocate();
+            }
+            benchmark::DoNotOptimize(pointers.data());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * half * 2));
+    }
+
+    // Benchmark 1: Embedded free list, allocation-heavy fill and drain.
+    void BM_EmbeddedListFillDrain(benchmark::State &state)
+    {
+        RunFillDrain<mcr::SlabAllocator>(state);
+    }
+    BENCHMARK(BM_EmbeddedListFillDrain)->Arg(1 << 10)->Arg(1 << 16);
+
+    // Benchmark 2: Out-of-band bitmap, allocation-heavy fill and drain.
+    void BM_BitmapFillDrain(benchmark::State &state)
+    {
+        RunFillDrain<mcr::BitmapSlabAllocator>(state);
+    }
+    BENCHMARK(BM_BitmapFillDrain)->Arg(1 << 10)->Arg(1 << 16);
+
+    // Benchmark 3: Embedded free list, frees scattered across the pool; reuse is LIFO.
+    void BM_EmbeddedListScatteredRefill(benchmark::State &state)
+    {
+        RunScatteredRefill<mcr::SlabAllocator>(state);
+    }
+    BENCHMARK(BM_EmbeddedListScatteredRefill)->Arg(1 << 10)->Arg(1 << 16);
+
+    // Benchmark 4: Out-of-band bitmap, frees scattered across the pool; reuse scans words in address order.
+    void BM_BitmapScatteredRefill(benchmark::State &state)
+    {
+        RunScatteredRefill<mcr::BitmapSlabAllocator>(state);
+    }
+    BENCHMARK(BM_BitmapScatteredRefill)->Arg(1 << 10)->Arg(1 << 16);
+}
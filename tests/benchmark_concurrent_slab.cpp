@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+#include <concurrent_slab_allocator.h>
+#include <slab_allocator.h>
+#include <array>
+#include <cstddef>
+#include <mutex>
+
+namespace
+{
+    constexpr std::size_t kObjectSize = 24;
+    constexpr std::size_t kThreadBatch = 16;
+    constexpr std::size_t kPoolBlocks = 8 * kThreadBatch; // Enough for the largest thread count.
+
+    // Benchmark 1: A single `SlabAllocator` shared through one mutex.
+    void BM_MutexSlabAllocator(benchmark::State &state)
+    {
+        static mcr::SlabAllocator allocator(kObjectSize, 32 * kPoolBlocks);
+        static std::mutex allocator_mutex;
+
+        std::array<void *, kThreadBatch> pointers{};
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < kThreadBatch; i++)
+            {
+                std::lock_guard<std::mutex> lock(allocator_mutex);
+                pointers[i] = allocator.Allocate();
+            }
+            benchmark::DoNotOptimize(pointers.data());
+
+            for (std::size_t i = 0; i < kThreadBatch; i++)
+            {
+                std::lock_guard<std::mutex> lock(allocator_mutex);
+                allocator.Free(pointers[i]);
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kThreadBatch));
+    }
+    BENCHMARK(BM_MutexSlabAllocator)->ThreadRange(1, 8)->UseRealTime();
+
+    // Benchmark 2: The lock-free allocator under the same contention.
+    void BM_ConcurrentSlabAllocator(benchmark::State &state)
+    {
+        static mcr::ConcurrentSlabAllocator allocator(kObjectSize, 32 * kPoolBlocks);
+
+        std::array<void *, kThreadBatch> pointers{};
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < kThreadBatch; i++)
+            {
+                pointers[i] = allocator.Allocate();
+            }
+            benchmark::DoNotOptimize(pointers.data());
+
+            for (std::size_t i = 0; i < kThreadBatch; i++)
+            {
+                allocator.Free(pointers[i]);
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kThreadBatch));
+    }
+    BENCHMARK(BM_ConcurrentSlabAllocator)->ThreadRange(1, 8)->UseRealTime();
+}
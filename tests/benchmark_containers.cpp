@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+#include <slab_manager.h>
+#include <slab_memory_resource.h>
+#include <stl_allocator.h>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t kElements = 10000;
+
+    mcr::SlabManagerConfig ContainerConfig()
+    {
+        mcr::SlabManagerConfig config;
+        config.blocks_per_class = 1024;
+        config.growth = mcr::SlabGrowth::kGeometric;
+        config.max_blocks_per_class = 1 << 20;
+        config.large_region_size = 16 << 20; // Hash-table bucket arrays.
+        return config;
+    }
+
+    const std::vector<int> &Keys()
+    {
+        static const std::vector<int> keys = []
+        {
+            std::vector<int> generated(kElements);
+            for (std::size_t i = 0; i < kElements; i++)
+            {
+                generated[i] = static_cast<int>(i);
+            }
+            std::shuffle(generated.begin(), generated.end(), std::mt19937(42));
+            return generated;
+        }();
+        return keys;
+    }
+
+    // Insert every key, then erase every key, through one container instance per iteration.
+    template <typename MakeContainer>
+    void RunInsertErase(benchmark::State &state, MakeContainer make_container)
+    {
+        const std::vector<int> &keys = Keys();
+        for (auto _ : state)
+        {
+            auto container = make_container();
+            for (int key : keys)
+            {
+                container.emplace(key, key);
+            }
+            for (int key : keys)
+            {
+                container.erase(key);
+            }
+            benchmark::DoNotOptimize(container);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * keys.size() * 2));
+    }
+
+    template <typename MakeList>
+    void RunPushPop(benchmark::State &state, MakeList make_list)
+    {
+        for (auto _ : state)
+        {
+            auto list = make_list();
+            for (std::size_t i = 0; i < kElements; i++)
+            {
+                list.push_back(static_cast<int>(i));
+            }
+            while (!list.empty())
+            {
+                list.pop_front();
+            }
+            benchmark::DoNotOptimize(list);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kElements * 2));
+    }
+
+    using MapAllocator = mcr::StlAllocator<std::pair<const int, int>>;
+
+    // Benchmark 1: std::map, default allocator vs. pmr resource vs. StlAllocator over SlabManager.
+    void BM_MapDefault(benchmark::State &state)
+    {
+        RunInsertErase(state, []
+                       { return std::map<int, int>(); });
+    }
+    BENCHMARK(BM_MapDefault);
+
+    void BM_MapPmrSlab(benchmark::State &state)
+    {
+        mcr::SlabManager manager(ContainerConfig());
+        mcr::SlabMemoryResource resource(manager);
+        RunInsertErase(state, [&resource]
+                       { return std::pmr::map<int, int>(&resource); });
+    }
+    BENCHMARK(BM_MapPmrSlab);
+
+    void BM_MapStlSlab(benchmark::State &state)
+    {
+        mcr::SlabManager manager(ContainerConfig());
+        RunInsertErase(state, [&manager]
+                       { return std::map<int, int, std::less<int>, MapAllocator>(MapAllocator(manager)); });
+    }
+    BENCHMARK(BM_MapStlSlab);
+
+    // Benchmark 2: std::unordered_map, default allocator vs. StlAllocator over SlabManager.
+    void BM_UnorderedMapDefault(benchmark::State &state)
+    {
+        RunInsertErase(state, []
+                       { return std::unordered_map<int, int>(); });
+    }
+    BENCHMARK(BM_UnorderedMapDefault);
+
+    void BM_UnorderedMapStlSlab(benchmark::State &state)
+    {
+        mcr::SlabManager manager(ContainerConfig());
+        RunInsertErase(state, [&manager]
+                       { return std::unordered_map<int, int, std::hash<int>, std::equal_to<int>, MapAllocator>(0, std::hash<int>(), std::equal_to<int>(), MapAllocator(manager)); });
+    }
+    BENCHMARK(BM_UnorderedMapStlSlab);
+
+    // Benchmark 3: std::list push/pop, default allocator vs. pmr resource over SlabManager.
+    void BM_ListDefault(benchmark::State &state)
+    {
+        RunPushPop(state, []
+                   { return std::list<int>(); });
+    }
+    BENCHMARK(BM_ListDefault);
+
+    void BM_ListPmrSlab(benchmark::State &state)
+    {
+        mcr::SlabManager manager(ContainerConfig());
+        mcr::SlabMemoryResource resource(manager);
+        RunPushPop(state, [&resource]
+                   { return std::pmr::list<int>(&resource); });
+    }
+    BENCHMARK(BM_ListPmrSlab);
+}
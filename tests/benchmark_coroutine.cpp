@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+#include <coroutine_frame.h>
+#include <slab_manager.h>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+
+namespace
+{
+    constexpr std::size_t kCoroutinesPerIteration = 1000;
+
+    // Eagerly started coroutine that completes at once and hands its result to the caller, which then frees the frame.
+    template <typename Promise>
+    class Job
+    {
+    public:
+        using promise_type = Promise;
+
+        explicit Job(std::coroutine_handle<Promise> handle) : handle_(handle) {}
+        Job(const Job &) = delete;
+        Job &operator=(const Job &) = delete;
+        ~Job()
+        {
+            handle_.destroy();
+        }
+
+        int Result() const
+        {
+            return handle_.promise().value;
+        }
+
+    private:
+        std::coroutine_handle<Promise> handle_;
+    };
+
+    template <typename Promise>
+    struct JobPromise
+    {
+        int value = 0;
+
+        Job<Promise> get_return_object()
+        {
+            return Job<Promise>(std::coroutine_handle<Promise>::from_promise(static_cast<Promise &>(*this)));
+        }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_value(int result) { value = result; }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    struct HeapPromise : JobPromise<HeapPromise>
+    {
+    };
+
+    struct SlabPromise : JobPromise<SlabPromise>, mcr::CoroutineFramePromise<mcr::SlabManager>
+    {
+    };
+
+    template <typename Promise>
+    Job<Promise> Square(int x)
+    {
+        co_return x * x;
+    }
+
+    template <typename Promise>
+    void RunShortCoroutines(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            int sum = 0;
+            for (std::size_t i = 0; i < kCoroutinesPerIteration; i++)
+            {
+                Job<Promise> job = Square<Promise>(static_cast<int>(i));
+                sum += job.Result();
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kCoroutinesPerIteration));
+    }
+
+    // Benchmark 1: Frames from global `operator new`.
+    void BM_CoroutineFramesDefaultHeap(benchmark::State &state)
+    {
+        RunShortCoroutines<HeapPromise>(state);
+    }
+    BENCHMARK(BM_CoroutineFramesDefaultHeap);
+
+    // Benchmark 2: Frames from the size classes of a `SlabManager` installed with a frame scope.
+    void BM_CoroutineFramesSlabManager(benchmark::State &state)
+    {
+        mcr::SlabManager manager;
+        mcr::CoroutineFrameScope<mcr::SlabManager> scope(manager);
+        RunShortCoroutines<SlabPromise>(state);
+    }
+    BENCHMARK(BM_CoroutineFramesSlabManager);
+}
@@ -0,0 +1,137 @@
+#include <benchmark/benchmark.h>
+#include <frame_allocator.h>
+#include <slab_manager.h>
+#include <cstddef>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t kAllocationsPerFrame = 2000;
+    constexpr std::size_t kFrameCapacity = 1 << 20;
+
+    // Mixed-size per-frame scratch requests (particles, draw commands, temporary strings) in [8, 256] bytes.
+    const std::vector<std::size_t> &FrameSizes()
+    {
+        static const std::vector<std::size_t> sizes = []
+        {
+            std::mt19937 rng(42);
+            std::uniform_int_distribution<std::size_t> dist(8, 256);
+            std::vector<std::size_t> generated(kAllocationsPerFrame);
+            for (std::size_t &size : generated)
+            {
+                size = dist(rng);
+            }
+            return generated;
+        }();
+        return sizes;
+    }
+
+    // Benchmark 1: One frame burst through malloc, released object by object at the end of the frame.
+    void BM_FrameBurstMalloc(benchmark::State &state)
+    {
+        const std::vector<std::size_t> &sizes = FrameSizes();
+        std::vector<void *> pointers;
+        pointers.reserve(sizes.size());
+
+        for (auto _ : state)
+        {
+            for (std::size_t size : sizes)
+            {
+                void *ptr = std::malloc(size);
+                benchmark::DoNotOptimize(ptr);
+                pointers.push_back(ptr);
+            }
+            for (void *ptr : pointers)
+            {
+                std::free(ptr);
+            }
+            pointers.clear();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * sizes.size()));
+    }
+    BENCHMARK(BM_FrameBurstMalloc);
+
+    // Benchmark 2: The same burst through the slab manager; every object pays a free-list push and pop.
+    void BM_FrameBurstSlabManager(benchmark::State &state)
+    {
+        const std::vector<std::size_t> &sizes = FrameSizes();
+        mcr::SlabManagerConfig config;
+        config.blocks_per_class = kAllocationsPerFrame;
+        config.max_blocks_per_class = kAllocationsPerFrame;
+        mcr::SlabManager manager(config);
+        std::vector<void *> pointers;
+        pointers.reserve(sizes.size());
+
+        for (auto _ : state)
+        {
+            for (std::size_t size : sizes)
+            {
+                void *ptr = manager.Allocate(size);
+                if (!ptr)
+                {
+                    state.SkipWithError("Size class exhausted during frame burst.");
+                    return;
+                }
+                benchmark::DoNotOptimize(ptr);
+                pointers.push_back(ptr);
+            }
+            for (std::size_t i = 0; i < pointers.size(); i++)
+            {
+                manager.Free(pointers[i], sizes[i], sizeof(void *));
+            }
+            pointers.clear();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * sizes.size()));
+    }
+    BENCHMARK(BM_FrameBurstSlabManager);
+
+    // Benchmark 3: Linear allocator; the frame is released with one `Reset()`.
+    void BM_FrameBurstLinear(benchmark::State &state)
+    {
+        const std::vector<std::size_t> &sizes = FrameSizes();
+        mcr::LinearAllocator allocator(kFrameCapacity);
+
+        for (auto _ : state)
+        {
+            for (std::size_t size : sizes)
+            {
+                void *ptr = allocator.Allocate(size);
+                if (!ptr)
+                {
+                    state.SkipWithError("Frame buffer exhausted during frame burst.");
+                    return;
+                }
+                benchmark::DoNotOptimize(ptr);
+            }
+            allocator.Reset();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * sizes.size()));
+    }
+    BENCHMARK(BM_FrameBurstLinear);
+
+    // Benchmark 4: Double-buffered frames; the previous frame stays readable while the next one is built.
+    void BM_FrameBurstDoubleBuffered(benchmark::State &state)
+    {
+        const std::vector<std::size_t> &sizes = FrameSizes();
+        mcr::DoubleBufferedFrameAllocator frames(kFrameCapacity);
+
+        for (auto _ : state)
+        {
+            for (std::size_t size : sizes)
+            {
+                void *ptr = frames.Allocate(size);
+                if (!ptr)
+                {
+                    state.SkipWithError("Frame buffer exhausted during frame burst.");
+                    return;
+                }
+                benchmark::DoNotOptimize(ptr);
+            }
+            frames.NextFrame();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * sizes.size()));
+    }
+    BENCHMARK(BM_FrameBurstDoubleBuffered);
+}
@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+#include <relocatable_slab_manager.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <string>
+
+namespace
+{
+    /**
+     * @brief Objects in the startup state; each is a node plus its payload.
+     */
+    constexpr std::size_t kObjects = 50000;
+
+    /**
+     * @brief Startup object: a name index entry pointing at the object's payload.
+     */
+    struct Entry
+    {
+        Entry *next;
+        std::uint64_t key;
+        char *payload;
+        char name[40];
+    };
+
+    constexpr std::size_t kPayloadSize = 200;
+
+    mcr::RelocatableHeapConfig StartupHeap()
+    {
+        mcr::RelocatableHeapConfig config;
+        config.blocks_per_class = kObjects;
+        return config;
+    }
+
+    // Stands in for the work a process does to reach its ready state: allocate and initialize every object.
+    void BuildStartupState(mcr::RelocatableSlabManager &manager)
+    {
+        Entry *head = nullptr;
+        for (std::size_t i = 0; i < kObjects; i++)
+        {
+            Entry *entry = new (manager.Allocate(sizeof(Entry))) Entry{head, i * 2654435761u, nullptr, {}};
+            std::snprintf(entry->name, sizeof(entry->name), "object-%zu", i);
+            entry->payload = static_cast<char *>(manager.Allocate(kPayloadSize));
+            for (std::size_t j = 0; j < kPayloadSize; j++)
+            {
+                entry->payload[j] = static_cast<char>(i + j);
+            }
+            head = entry;
+        }
+        manager.SetRoot(head);
+    }
+
+    std::uint64_t Traverse(const mcr::RelocatableSlabManager &manager)
+    {
+        std::uint64_t sum = 0;
+        for (const Entry *entry = static_cast<const Entry *>(manager.Root()); entry; entry = entry->next)
+        {
+            sum += entry->key + static_cast<unsigned char>(entry->payload[0]);
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Image of the built startup state, written once per benchmark process.
+     */
+    const std::string &StartupImage()
+    {
+        static const std::string path = []
+        {
+            const std::string image_path = (std::filesystem::temp_directory_path() / "mcr_benchmark_startup.heap").string();
+            mcr::RelocatableSlabManager manager(StartupHeap());
+            BuildStartupState(manager);
+            manager.WriteImage(image_path);
+            return image_path;
+        }();
+        return path;
+    }
+
+    // Benchmark 1: Reach the ready state by mapping a fresh heap and rebuilding every object.
+    void BM_StartupRebuild(benchmark::State &state)
+    {
+        for (auto _ : state)
+        {
+            auto manager = std::make_unique<mcr::RelocatableSlabManager>(StartupHeap());
+            BuildStartupState(*manager);
+            benchmark::DoNotOptimize(manager->Root());
+
+            state.PauseTiming();
+            manager.reset();
+            state.ResumeTiming();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kObjects));
+    }
+    BENCHMARK(BM_StartupRebuild)->Unit(benchmark::kMicrosecond);
+
+    // Benchmark 2: Reach the ready state by mapping the saved image; O(1) in the number of objects.
+    void BM_StartupRestore(benchmark::State &state)
+    {
+        const std::string &path = StartupImage();
+        for (auto _ : state)
+        {
+            std::unique_ptr<mcr::RelocatableSlabManager> manager = mcr::RelocatableSlabManager::Restore(path);
+            benchmark::DoNotOptimize(manager->Root());
+
+            state.PauseTiming();
+            manager.reset();
+            state.ResumeTiming();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kObjects));
+    }
+    BENCHMARK(BM_StartupRestore)->Unit(benchmark::kMicrosecond);
+
+    // Benchmark 3: Restore, then touch every object once; includes the page faults a restored heap pays lazily.
+    void BM_StartupRestoreAndTraverse(benchmark::State &state)
+    {
+        const std::string &path = StartupImage();
+        for (auto _ : state)
+        {
+            std::unique_ptr<mcr::RelocatableSlabManager> manager = mcr::RelocatableSlabManager::Restore(path);
+            benchmark::DoNotOptimize(Traverse(*manager));
+
+            state.PauseTiming();
+            manager.reset();
+            state.ResumeTiming();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kObjects));
+    }
+    BENCHMARK(BM_StartupRestoreAndTraverse)->Unit(benchmark::kMicrosecond);
+}
@@ -0,0 +1,86 @@
+#include <benchmark/benchmark.h>
+#include <buddy_allocator.h>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t kMinBlock = 2048;
+    constexpr std::size_t kMaxBlock = 1 << 20;
+    constexpr std::size_t kRegionSize = 64 << 20;
+    constexpr std::size_t kBatchSize = 64;
+
+    // Mid-size request sizes in (1 KiB, 256 KiB], log-uniform so small buffers dominate like in practice.
+    const std::vector<std::size_t> &RequestSizes()
+    {
+        static const std::vector<std::size_t> sizes = []
+        {
+            std::mt19937 rng(42);
+            std::uniform_real_distribution<double> exponent(10.0, 18.0);
+            std::vector<std::size_t> generated(kBatchSize);
+            for (std::size_t &size : generated)
+            {
+                size = static_cast<std::size_t>(std::exp2(exponent(rng))) + 1;
+            }
+            return generated;
+        }();
+        return sizes;
+    }
+
+    // Benchmark 1: Mixed mid-size batch through the buddy region.
+    void BM_BuddyMixedBatch(benchmark::State &state)
+    {
+        mcr::BuddyAllocator buddy(kMinBlock, kMaxBlock, kRegionSize);
+        const std::vector<std::size_t> &sizes = RequestSizes();
+        std::vector<void *> pointers(kBatchSize);
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < kBatchSize; i++)
+            {
+                pointers[i] = buddy.Allocate(sizes[i], sizeof(void *));
+                benchmark::DoNotOptimize(pointers[i]);
+            }
+            // Free in reverse order of every other block first to force out-of-order coalescing.
+            for (std::size_t i = 1; i < kBatchSize; i += 2)
+            {
+                buddy.Free(pointers[i], sizes[i], sizeof(void *));
+            }
+            for (std::size_t i = 0; i < kBatchSize; i += 2)
+            {
+                buddy.Free(pointers[i], sizes[i], sizeof(void *));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kBatchSize));
+    }
+    BENCHMARK(BM_BuddyMixedBatch);
+
+    // Benchmark 2: Same batch through the system heap.
+    void BM_MallocMixedBatch(benchmark::State &state)
+    {
+        const std::vector<std::size_t> &sizes = RequestSizes();
+        std::vector<void *> pointers(kBatchSize);
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < kBatchSize; i++)
+            {
+                pointers[i] = std::malloc(sizes[i]);
+                benchmark::DoNotOptimize(pointers[i]);
+            }
+            for (std::size_t i = 1; i < kBatchSize; i += 2)
+            {
+                std::free(pointers[i]);
+            }
+            for (std::size_t i = 0; i < kBatchSize; i += 2)
+            {
+                std::free(pointers[i]);
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kBatchSize));
+    }
+    BENCHMARK(BM_MallocMixedBatch);
+}
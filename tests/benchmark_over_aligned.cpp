@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+#include <slab_manager.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t kLiveRequests = 256;
+
+    using Request = std::pair<std::size_t, std::size_t>; // (size, alignment)
+
+    // SIMD scratch: 64-byte vectors with alignments from 128 to 1024 bytes.
+    std::vector<Request> SimdRequests()
+    {
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<int> shift(7, 10);
+        std::vector<Request> requests(kLiveRequests);
+        for (Request &request : requests)
+        {
+            request = Request{64, std::size_t{1} << shift(rng)};
+        }
+        return requests;
+    }
+
+    // Direct I/O: 512-byte sector buffers on page boundaries.
+    std::vector<Request> DirectIoRequests()
+    {
+        return std::vector<Request>(kLiveRequests, Request{512, 4096});
+    }
+
+    mcr::SlabManagerConfig RoutingByAlignmentConfig()
+    {
+        mcr::SlabManagerConfig config;
+        config.blocks_per_class = kLiveRequests;
+        config.large_region_size = std::size_t{1} << 21; // Serves the page-aligned requests above the largest class.
+        return config;
+    }
+
+    mcr::SlabManagerConfig OverAlignedConfig()
+    {
+        mcr::SlabManagerConfig config;
+        config.blocks_per_class = kLiveRequests;
+        config.over_aligned_blocks_per_class = kLiveRequests * 8;
+        return config;
+    }
+
+    // Allocate and free every request per iteration; report the bytes each live request holds.
+    void RunAlignedWorkload(benchmark::State &state, mcr::SlabManager &manager, const std::vector<Request> &requests, bool over_aligned)
+    {
+        std::vector<void *> pointers(requests.size());
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < requests.size(); i++)
+            {
+                pointers[i] = manager.Allocate(requests[i].first, requests[i].second);
+                if (!pointers[i])
+                {
+                    state.SkipWithError("Allocation failed during benchmark batch.");
+                    return;
+                }
+            }
+            benchmark::DoNotOptimize(pointers.data());
+            for (std::size_t i = 0; i < requests.size(); i++)
+            {
+                manager.Free(pointers[i], requests[i].first, requests[i].second);
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * requests.size()));
+
+        // Routing by alignment holds a whole power-of-2 block of `max(size, alignment)` per request. The over-aligned
+        // tier holds one block of the request's size, but its boundaries strand the blocks in between, so count the
+        // whole address range the requests span.
+        double bytes = 0;
+        if (over_aligned)
+        {
+            const auto [lowest, highest] = std::minmax_element(pointers.begin(), pointers.end(), [](void *a, void *b)
+                                                               { return reinterpret_cast<std::uintptr_t>(a) < reinterpret_cast<std::uintptr_t>(b); });
+            bytes = static_cast<double>(reinterpret_cast<std::uintptr_t>(*highest) - reinterpret_cast<std::uintptr_t>(*lowest) + requests[0].first);
+        }
+        else
+        {
+            for (const Request &request : requests)
+            {
+                const std::size_t key = std::max(request.first, request.second);
+                bytes += static_cast<double>(std::size_t{1} << (mcr::FloorLog2(key - 1) + 1));
+            }
+        }
+        state.counters["bytes_per_request"] = bytes / static_cast<double>(requests.size());
+    }
+
+    // Benchmark 1: SIMD scratch routed by `max(size, alignment)`.
+    void BM_SimdRoutingByAlignment(benchmark::State &state)
+    {
+        mcr::SlabManager manager(RoutingByAlignmentConfig());
+        RunAlignedWorkload(state, manager, SimdRequests(), false);
+    }
+    BENCHMARK(BM_SimdRoutingByAlignment);
+
+    // Benchmark 2: SIMD scratch in the over-aligned tier; lower alignments fill the gaps between higher ones.
+    void BM_SimdOverAlignedTier(benchmark::State &state)
+    {
+        mcr::SlabManager manager(OverAlignedConfig());
+        RunAlignedWorkload(state, manager, SimdRequests(), true);
+    }
+    BENCHMARK(BM_SimdOverAlignedTier);
+
+    // Benchmark 3: Page-aligned sector buffers from 4 KiB buddy blocks of the large-object region.
+    void BM_DirectIoRoutingByAlignment(benchmark::State &state)
+    {
+        mcr::SlabManager manager(RoutingByAlignmentConfig());
+        RunAlignedWorkload(state, manager, DirectIoRequests(), false);
+    }
+    BENCHMARK(BM_DirectIoRoutingByAlignment);
+
+    // Benchmark 4: Page-aligned sector buffers from the 512-byte class of the over-aligned tier.
+    void BM_DirectIoOverAlignedTier(benchmark::State &state)
+    {
+        mcr::SlabManager manager(OverAlignedConfig());
+        RunAlignedWorkload(state, manager, DirectIoRequests(), true);
+    }
+    BENCHMARK(BM_DirectIoOverAlignedTier);
+}
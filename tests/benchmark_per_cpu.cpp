@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <per_cpu_slab_manager.h>
+#include <thread_cached_slab_manager.h>
+#include <array>
+#include <cstddef>
+
+namespace
+{
+    constexpr std::size_t kObjectSize = 24;
+    constexpr std::size_t kThreadBatch = 8;
+
+    // Large enough that every thread cache of the oversubscribed runs can hold a full refill.
+    constexpr std::size_t kBlocksPerClass = 1 << 14;
+
+    mcr::SlabManagerConfig BenchmarkConfig()
+    {
+        mcr::SlabManagerConfig config;
+        config.blocks_per_class = kBlocksPerClass;
+        return config;
+    }
+
+    template <typename Manager>
+    void RunOversubscribed(benchmark::State &state, Manager &manager)
+    {
+        std::array<void *, kThreadBatch> pointers{};
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < kThreadBatch; i++)
+            {
+                pointers[i] = manager.Allocate(kObjectSize);
+            }
+            benchmark::DoNotOptimize(pointers.data());
+
+            for (std::size_t i = 0; i < kThreadBatch; i++)
+            {
+                manager.Free(pointers[i], kObjectSize, sizeof(void *));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kThreadBatch));
+    }
+
+    // Benchmark 1: Per-thread caches; cached memory grows with the thread count.
+    void BM_OversubscribedThreadCache(benchmark::State &state)
+    {
+        static mcr::ThreadCachedSlabManager manager(BenchmarkConfig());
+        RunOversubscribed(state, manager);
+        if (state.thread_index() == 0)
+        {
+            state.counters["caches"] = static_cast<double>(state.threads());
+        }
+    }
+    BENCHMARK(BM_OversubscribedThreadCache)->RangeMultiplier(4)->ThreadRange(1, 64)->UseRealTime();
+
+    // Benchmark 2: Per-CPU caches; cached memory is bounded by the core count.
+    void BM_OversubscribedPerCpu(benchmark::State &state)
+    {
+        static mcr::PerCpuSlabManager manager(BenchmarkConfig());
+        RunOversubscribed(state, manager);
+        if (state.thread_index() == 0)
+        {
+            state.counters["caches"] = static_cast<double>(manager.ShardCount());
+        }
+    }
+    BENCHMARK(BM_OversubscribedPerCpu)->RangeMultiplier(4)->ThreadRange(1, 64)->UseRealTime();
+}
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include <slab_allocator.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t kNodeSize = 64; // One cache line per node.
+    constexpr std::size_t kPoolSize = 256 << 20;
+    constexpr std::size_t kChaseSteps = 1 << 20;
+
+    struct Node
+    {
+        Node *next;
+    };
+
+    // Walk a random cyclic list over every block of a large pool; nearly every hop lands on another page,
+    // so the cost is dominated by TLB misses and page walks.
+    void BM_PointerChase(benchmark::State &state)
+    {
+        const mcr::PoolBacking backing = static_cast<mcr::PoolBacking>(state.range(0));
+        mcr::SlabAllocator allocator(kNodeSize, kPoolSize, kNodeSize, mcr::SlabGrowthPolicy{}, backing);
+
+        const std::size_t node_count = kPoolSize / kNodeSize;
+        std::vector<void *> nodes(node_count);
+        if (allocator.AllocateBatch(node_count, nodes.data()) != node_count)
+        {
+            state.SkipWithError("Pool exhausted while building the list.");
+            return;
+        }
+
+        std::vector<std::size_t> order(node_count);
+        std::iota(order.begin(), order.end(), std::size_t{0});
+        std::shuffle(order.begin(), order.end(), std::mt19937_64(42));
+        for (std::size_t i = 0; i < node_count; i++)
+        {
+            static_cast<Node *>(nodes[order[i]])->next = static_cast<Node *>(nodes[order[(i + 1) % node_count]]);
+        }
+
+        const Node *current = static_cast<Node *>(nodes[order[0]]);
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < kChaseSteps; i++)
+            {
+                current = current->next;
+            }
+            benchmark::DoNotOptimize(current);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kChaseSteps));
+        state.SetLabel(allocator.Backing() == backing ? "requested backing" : "fell back");
+        allocator.FreeBatch(nodes.data(), node_count);
+    }
+    BENCHMARK(BM_PointerChase)
+        ->Arg(static_cast<int>(mcr::PoolBacking::kHeap))
+        ->Arg(static_cast<int>(mcr::PoolBacking::kTransparentHugePages))
+        ->Arg(static_cast<int>(mcr::PoolBacking::kExplicitHugePages))
+        ->Unit(benchmark::kMillisecond);
+}
@@ -0,0 +1,142 @@
+#include <benchmark/benchmark.h>
+#include <remote_free_slab_manager.h>
+#include <slab_manager.h>
+#include <thread_cached_slab_manager.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+    constexpr std::size_t kMessageSize = 64;
+    constexpr std::size_t kMessagesPerIteration = 64;
+    constexpr std::size_t kRingCapacity = 256;
+    constexpr std::size_t kBlocksPerClass = 4096;
+
+    mcr::SlabManagerConfig BenchmarkConfig()
+    {
+        mcr::SlabManagerConfig config;
+        config.blocks_per_class = kBlocksPerClass;
+        return config;
+    }
+
+    // Single-producer, single-consumer ring carrying messages from the producer to the consumer.
+    class MessageRing
+    {
+    public:
+        void Push(void *message)
+        {
+            const std::size_t head = head_.load(std::memory_order_relaxed);
+            while (head - tail_.load(std::memory_order_acquire) == kRingCapacity)
+            {
+                std::this_thread::yield();
+            }
+            slots_[head % kRingCapacity] = message;
+            head_.store(head + 1, std::memory_order_release);
+        }
+
+        void *Pop()
+        {
+            const std::size_t tail = tail_.load(std::memory_order_relaxed);
+            while (head_.load(std::memory_order_acquire) == tail)
+            {
+                std::this_thread::yield();
+            }
+            void *message = slots_[tail % kRingCapacity];
+            tail_.store(tail + 1, std::memory_order_release);
+            return message;
+        }
+
+    private:
+        std::array<void *, kRingCapacity> slots_{};
+        alignas(64) std::atomic<std::size_t> head_{0};
+        alignas(64) std::atomic<std::size_t> tail_{0};
+    };
+
+    // The benchmark thread produces messages through `allocate`; a consumer thread reads and frees them through `release`.
+    template <typename AllocateFn, typename FreeFn>
+    void RunProducerConsumer(benchmark::State &state, AllocateFn allocate, FreeFn release)
+    {
+        MessageRing ring;
+        std::thread consumer([&ring, &release]
+                             {
+            for (;;)
+            {
+                void *message = ring.Pop();
+                if (!message)
+                {
+                    return;
+                }
+                benchmark::DoNotOptimize(*static_cast<unsigned char *>(message));
+                release(message);
+            } });
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < kMessagesPerIteration; i++)
+            {
+                void *message = allocate();
+                while (!message)
+                {
+                    // Every block is in flight; wait for the consumer to return some.
+                    std::this_thread::yield();
+                    message = allocate();
+                }
+                std::memset(message, static_cast<int>(i), kMessageSize);
+                ring.Push(message);
+            }
+        }
+        ring.Push(nullptr);
+        consumer.join();
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kMessagesPerIteration));
+    }
+
+    // Benchmark 1: One mutex around every `SlabManager` call on both sides.
+    void BM_ProducerConsumerMutexSlabManager(benchmark::State &state)
+    {
+        mcr::SlabManager manager(BenchmarkConfig());
+        std::mutex manager_mutex;
+        RunProducerConsumer(
+            state,
+            [&]
+            {
+                std::lock_guard<std::mutex> lock(manager_mutex);
+                return manager.Allocate(kMessageSize);
+            },
+            [&](void *ptr)
+            {
+                std::lock_guard<std::mutex> lock(manager_mutex);
+                manager.Free(ptr, kMessageSize, sizeof(void *));
+            });
+    }
+    BENCHMARK(BM_ProducerConsumerMutexSlabManager)->UseRealTime();
+
+    // Benchmark 2: Per-thread caches; blocks pile up in the consumer's cache and travel back through the locked shared pool.
+    void BM_ProducerConsumerThreadCached(benchmark::State &state)
+    {
+        mcr::ThreadCachedSlabManager manager(BenchmarkConfig());
+        RunProducerConsumer(
+            state,
+            [&]
+            { return manager.Allocate(kMessageSize); },
+            [&](void *ptr)
+            { manager.Free(ptr, kMessageSize, sizeof(void *)); });
+    }
+    BENCHMARK(BM_ProducerConsumerThreadCached)->UseRealTime();
+
+    // Benchmark 3: Producer-owned `SlabManager`; the consumer pushes onto its remote-free stack and the producer drains it.
+    void BM_ProducerConsumerRemoteFree(benchmark::State &state)
+    {
+        mcr::RemoteFreeSlabManager manager(BenchmarkConfig());
+        RunProducerConsumer(
+            state,
+            [&]
+            { return manager.Allocate(kMessageSize); },
+            [&](void *ptr)
+            { manager.Free(ptr, kMessageSize, sizeof(void *)); });
+    }
+    BENCHMARK(BM_ProducerConsumerRemoteFree)->UseRealTime();
+}
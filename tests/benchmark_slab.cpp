@@ -46,6 +46,7 @@ namespace
             }
             pointers.clear();
         }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kBatchSize));
     }
     // Register the test.
     BENCHMARK(BM_SystemMalloc);
@@ -89,7 +90,48 @@ namespace
             }
             pointers.clear();
         }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kBatchSize));
     }
     // Register the test.
     BENCHMARK(BM_SlabAllocator);
-}
+
+    // Benchmark 3: Slab Allocator batch API (one `AllocateBatch`/`FreeBatch` call per batch).
+    void BM_SlabAllocatorBatch(benchmark::State &state)
+    {
+        const std::size_t pool_size = EffectiveSlabBlockSize() * kBatchSize;
+        mcr::SlabAllocator allocator(kObjectSize, pool_size);
+
+        std::vector<void *> pointers(kBatchSize);
+
+        for (auto _ : state)
+        {
+            if (allocator.AllocateBatch(kBatchSize, pointers.data()) != kBatchSize)
+            {
+                state.SkipWithError("SlabAllocator exhausted during benchmark batch.");
+                return;
+            }
+            benchmark::DoNotOptimize(pointers.data());
+            benchmark::ClobberMemory();
+
+            allocator.FreeBatch(pointers.data(), kBatchSize);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kBatchSize));
+    }
+    // Register the test.
+    BENCHMARK(BM_SlabAllocatorBatch);
+
+    // Benchmark 4: Construction and destruction of a large pool; measures the up-front setup cost.
+    void BM_SlabAllocatorConstruct(benchmark::State &state)
+    {
+        const std::size_t pool_size = static_cast<std::size_t>(state.range(0));
+        for (auto _ : state)
+        {
+            mcr::SlabAllocator allocator(kObjectSize, pool_size);
+            void *ptr = allocator.Allocate();
+            benchmark::DoNotOptimize(ptr);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * pool_size));
+    }
+    // Register the test.
+    BENCHMARK(BM_SlabAllocatorConstruct)->RangeMultiplier(16)->Range(64 << 10, 64 << 20);
+}
\ No newline at end of file
@@ -0,0 +1,274 @@
+#include <benchmark/benchmark.h>
+#include <slab_manager.h>
+#include <static_slab_manager.h>
+#include <object_pool.h>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t kObjectSize = 24;
+    constexpr std::size_t kBatchSize = 100; // One full default size class.
+
+    // Allocate and free one batch of `kObjectSize` objects per iteration through `allocate`/`release`.
+    template <typename AllocateFn, typename FreeFn>
+    void RunManagerBatch(benchmark::State &state, AllocateFn allocate, FreeFn release)
+    {
+        std::vector<void *> pointers;
+        pointers.reserve(kBatchSize);
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < kBatchSize; i++)
+            {
+                void *ptr = allocate();
+                if (!ptr)
+                {
+                    state.SkipWithError("Size class exhausted during benchmark batch.");
+                    for (void *allocated_ptr : pointers)
+                    {
+                        release(allocated_ptr);
+                    }
+                    return;
+                }
+                benchmark::DoNotOptimize(ptr);
+                pointers.push_back(ptr);
+            }
+
+            for (void *ptr : pointers)
+            {
+                release(ptr);
+            }
+            pointers.clear();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kBatchSize));
+    }
+
+    // Benchmark 1: Runtime manager (allocators behind `std::unique_ptr`).
+    void BM_SlabManager(benchmark::State &state)
+    {
+        mcr::SlabManager manager;
+        RunManagerBatch(
+            state,
+            [&manager]
+            { return manager.Allocate(kObjectSize); },
+            [&manager](void *ptr)
+            { manager.Free(ptr, kObjectSize, sizeof(void *)); });
+    }
+    BENCHMARK(BM_SlabManager);
+
+    // Benchmark 1b: Runtime manager batch API; one routing decision per batch.
+    void BM_SlabManagerBatch(benchmark::State &state)
+    {
+        mcr::SlabManager manager;
+        std::vector<void *> pointers(kBatchSize);
+
+        for (auto _ : state)
+        {
+            if (manager.AllocateBatch(kBatchSize, pointers.data(), kObjectSize) != kBatchSize)
+            {
+                state.SkipWithError("Size class exhausted during benchmark batch.");
+                return;
+            }
+            benchmark::DoNotOptimize(pointers.data());
+            benchmark::ClobberMemory();
+
+            manager.FreeBatch(pointers.data(), kBatchSize, kObjectSize, sizeof(void *));
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kBatchSize));
+    }
+    BENCHMARK(BM_SlabManagerBatch);
+
+    // Benchmark 1c: Contiguous class arena; `Free(ptr)` finds the class by subtract-and-shift instead of a size.
+    void BM_SlabManagerArenaSizelessFree(benchmark::State &state)
+    {
+        mcr::SlabManagerConfig config;
+        config.contiguous_arena = true;
+        mcr::SlabManager manager(config);
+        RunManagerBatch(
+            state,
+            [&manager]
+            { return manager.Allocate(kObjectSize); },
+            [&manager](void *ptr)
+            { manager.Free(ptr); });
+    }
+    BENCHMARK(BM_SlabManagerArenaSizelessFree);
+
+    // Benchmark 1d: Runtime manager with geometric class spacing; routing is one table load instead of a clz.
+    void BM_SlabManagerGeometricSpacing(benchmark::State &state)
+    {
+        mcr::SlabManagerConfig config;
+        config.class_spacing = mcr::ClassSpacing::kGeometric;
+        mcr::SlabManager manager(config);
+        RunManagerBatch(
+            state,
+            [&manager]
+            { return manager.Allocate(kObjectSize); },
+            [&manager](void *ptr)
+            { manager.Free(ptr, kObjectSize, sizeof(void *)); });
+    }
+    BENCHMARK(BM_SlabManagerGeometricSpacing);
+
+    constexpr std::size_t kAppendChunk = 24;
+    constexpr std::size_t kBuilderLimit = 8192;
+
+    // Grow a string-builder buffer by `kAppendChunk` bytes per append until `kBuilderLimit`, through `resize`.
+    template <typename ResizeFn>
+    void RunStringBuilder(benchmark::State &state, mcr::SlabManager &manager, ResizeFn resize)
+    {
+        std::size_t appends = 0;
+        for (auto _ : state)
+        {
+            void *buffer = nullptr;
+            std::size_t size = 0;
+            while (size + kAppendChunk <= kBuilderLimit)
+            {
+                buffer = resize(buffer, size, size + kAppendChunk);
+                std::memset(static_cast<char *>(buffer) + size, 'x', kAppendChunk);
+                size += kAppendChunk;
+                appends++;
+            }
+            benchmark::DoNotOptimize(buffer);
+            manager.Free(buffer, size, sizeof(void *));
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(appends));
+    }
+
+    mcr::SlabManagerConfig StringBuilderConfig()
+    {
+        mcr::SlabManagerConfig config;
+        config.large_region_size = 1 << 20;
+        return config;
+    }
+
+    // Benchmark 1d: Each append allocates the exact new size, copies and frees the old buffer.
+    void BM_StringBuilderAllocateCopyFree(benchmark::State &state)
+    {
+        mcr::SlabManager manager(StringBuilderConfig());
+        RunStringBuilder(state, manager, [&manager](void *old, std::size_t old_size, std::size_t new_size)
+                         {
+            void *grown = manager.Allocate(new_size);
+            if (old)
+            {
+                std::memcpy(grown, old, old_size);
+                manager.Free(old, old_size, sizeof(void *));
+            }
+            return grown; });
+    }
+    BENCHMARK(BM_StringBuilderAllocateCopyFree);
+
+    // Benchmark 1e: `Reallocate()`; moves only on class changes and grows large blocks in place.
+    void BM_StringBuilderReallocate(benchmark::State &state)
+    {
+        mcr::SlabManager manager(StringBuilderConfig());
+        RunStringBuilder(state, manager, [&manager](void *old, std::size_t old_size, std::size_t new_size)
+                         { return manager.Reallocate(old, old_size, new_size); });
+    }
+    BENCHMARK(BM_StringBuilderReallocate);
+
+    // Benchmark 2: Compile-time class table, inline allocators, runtime request routing.
+    void BM_StaticSlabManager(benchmark::State &state)
+    {
+        mcr::DefaultStaticSlabManager manager;
+        RunManagerBatch(
+            state,
+            [&manager]
+            { return manager.Allocate(kObjectSize); },
+            [&manager](void *ptr)
+            { manager.Free(ptr, kObjectSize, sizeof(void *)); });
+    }
+    BENCHMARK(BM_StaticSlabManager);
+
+    // Benchmark 3: Request size known at compile time; no routing or validation on the hot path.
+    void BM_StaticSlabManagerCompileTimeClass(benchmark::State &state)
+    {
+        mcr::DefaultStaticSlabManager manager;
+        RunManagerBatch(
+            state,
+            [&manager]
+            { return manager.Allocate<kObjectSize>(); },
+            [&manager](void *ptr)
+            { manager.Free<kObjectSize>(ptr); });
+    }
+    BENCHMARK(BM_StaticSlabManagerCompileTimeClass);
+
+    // Benchmark 4: Geometric class table (LUT routing) under the same batch workload.
+    void BM_GeometricStaticSlabManager(benchmark::State &state)
+    {
+        mcr::GeometricStaticSlabManager manager;
+        RunManagerBatch(
+            state,
+            [&manager]
+            { return manager.Allocate(kObjectSize); },
+            [&manager](void *ptr)
+            { manager.Free(ptr, kObjectSize, sizeof(void *)); });
+    }
+    BENCHMARK(BM_GeometricStaticSlabManager);
+
+    struct Object
+    {
+        unsigned char bytes[kObjectSize];
+    };
+
+    // Benchmark 4b: Typed pool; size, alignment and class binding are resolved at compile time.
+    void BM_ObjectPool(benchmark::State &state)
+    {
+        mcr::ObjectPool<Object> pool(kBatchSize);
+        RunManagerBatch(
+            state,
+            [&pool]
+            { return static_cast<void *>(pool.Create()); },
+            [&pool](void *ptr)
+            { pool.Destroy(static_cast<Object *>(ptr)); });
+    }
+    BENCHMARK(BM_ObjectPool);
+
+    // Routing-only benchmarks over a fixed set of random keys in [1, 1024].
+    const std::vector<std::size_t> &RoutingKeys()
+    {
+        static const std::vector<std::size_t> keys = []
+        {
+            std::mt19937 rng(42);
+            std::uniform_int_distribution<std::size_t> dist(1, 1024);
+            std::vector<std::size_t> generated(4096);
+            for (std::size_t &key : generated)
+            {
+                key = dist(rng);
+            }
+            return generated;
+        }();
+        return keys;
+    }
+
+    template <typename ClassTable>
+    void RunRouting(benchmark::State &state)
+    {
+        const std::vector<std::size_t> &keys = RoutingKeys();
+        for (auto _ : state)
+        {
+            std::size_t sum = 0;
+            for (std::size_t key : keys)
+            {
+                sum += ClassTable::ClassIndex(key);
+            }
+            benchmark::DoNotOptimize(sum);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * keys.size()));
+    }
+
+    // Benchmark 5: Power-of-2 routing through a bit scan (clz).
+    void BM_RoutePowerOfTwoClz(benchmark::State &state)
+    {
+        RunRouting<mcr::PowerOfTwoClasses<16, 1024>>(state);
+    }
+    BENCHMARK(BM_RoutePowerOfTwoClz);
+
+    // Benchmark 6: Geometric routing through the `(key + 15) >> 4` lookup table.
+    void BM_RouteGeometricLookup(benchmark::State &state)
+    {
+        RunRouting<mcr::GeometricClasses<16, 1024, 4>>(state);
+    }
+    BENCHMARK(BM_RouteGeometricLookup);
+}
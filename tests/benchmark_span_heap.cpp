@@ -0,0 +1,137 @@
+#include <benchmark/benchmark.h>
+#include <slab_manager.h>
+#include <span_slab_manager.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Memory both managers get: the span heap size, and the sum of the private class pools.
+     */
+    constexpr std::size_t kBudget = std::size_t{2} << 20;
+
+    /**
+     * @brief Each phase asks for this much memory of one size class.
+     */
+    constexpr std::size_t kPhaseBytes = kBudget * 3 / 4;
+
+    /**
+     * @brief One size per phase; the workload moves through every class.
+     */
+    constexpr std::array<std::size_t, 7> kPhaseSizes = {64, 512, 16, 1024, 128, 256, 32};
+
+    constexpr std::size_t kLiveBlocks = 256;
+
+    mcr::SlabManagerConfig PrivatePoolsConfig()
+    {
+        // Split the budget evenly: one block of every class per row.
+        std::size_t row_bytes = 0;
+        for (std::size_t i = 0; i < mcr::SizeClassPolicy::kNumClasses; i++)
+        {
+            row_bytes += mcr::SizeClassPolicy::ClassSize(i);
+        }
+        mcr::SlabManagerConfig config;
+        config.blocks_per_class = kBudget / row_bytes;
+        return config;
+    }
+
+    mcr::SpanSlabManagerConfig SharedHeapConfig()
+    {
+        mcr::SpanSlabManagerConfig config;
+        config.heap_size = kBudget;
+        return config;
+    }
+
+    // Each phase fills one class up to `kPhaseBytes` (or until the manager runs out) and frees it again.
+    // `served` is the fraction of the requested bytes the manager could hand out.
+    template <typename Manager>
+    void RunShiftingWorkload(benchmark::State &state, Manager &manager)
+    {
+        std::vector<void *> ptrs;
+        std::size_t requested = 0;
+        std::size_t served = 0;
+        std::size_t blocks = 0;
+        for (auto _ : state)
+        {
+            for (std::size_t size : kPhaseSizes)
+            {
+                const std::size_t count = kPhaseBytes / size;
+                ptrs.clear();
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    void *ptr = manager.Allocate(size);
+                    if (!ptr)
+                    {
+                        break;
+                    }
+                    ptrs.push_back(ptr);
+                }
+                benchmark::DoNotOptimize(ptrs.data());
+                requested += count * size;
+                served += ptrs.size() * size;
+                blocks += ptrs.size();
+                for (void *ptr : ptrs)
+                {
+                    manager.Free(ptr, size, sizeof(void *));
+                }
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(blocks));
+        state.counters["served"] = static_cast<double>(served) / static_cast<double>(requested);
+    }
+
+    // Allocate and free a fixed set of live 64-byte blocks per iteration.
+    template <typename Manager>
+    void RunSteadyChurn(benchmark::State &state, Manager &manager)
+    {
+        std::vector<void *> ptrs(kLiveBlocks);
+        for (auto _ : state)
+        {
+            for (void *&ptr : ptrs)
+            {
+                ptr = manager.Allocate(64);
+            }
+            benchmark::DoNotOptimize(ptrs.data());
+            for (void *ptr : ptrs)
+            {
+                manager.Free(ptr, 64, sizeof(void *));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kLiveBlocks));
+    }
+
+    // Benchmark 1: Shifting workload against private per-class pools that split the budget.
+    void BM_ShiftingWorkloadPrivatePools(benchmark::State &state)
+    {
+        mcr::SlabManager manager(PrivatePoolsConfig());
+        RunShiftingWorkload(state, manager);
+    }
+    BENCHMARK(BM_ShiftingWorkloadPrivatePools);
+
+    // Benchmark 2: Shifting workload against classes that share the budget as spans.
+    void BM_ShiftingWorkloadSharedSpans(benchmark::State &state)
+    {
+        mcr::SpanSlabManager manager(SharedHeapConfig());
+        RunShiftingWorkload(state, manager);
+    }
+    BENCHMARK(BM_ShiftingWorkloadSharedSpans);
+
+    // Benchmark 3: Steady alloc/free churn from a private pool.
+    void BM_SteadyChurnPrivatePools(benchmark::State &state)
+    {
+        mcr::SlabManager manager(PrivatePoolsConfig());
+        RunSteadyChurn(state, manager);
+    }
+    BENCHMARK(BM_SteadyChurnPrivatePools);
+
+    // Benchmark 4: Steady alloc/free churn from spans; the hot path stays O(1).
+    void BM_SteadyChurnSharedSpans(benchmark::State &state)
+    {
+        mcr::SpanSlabManager manager(SharedHeapConfig());
+        RunSteadyChurn(state, manager);
+    }
+    BENCHMARK(BM_SteadyChurnSharedSpans);
+}
@@ -0,0 +1,66 @@
+#include <benchmark/benchmark.h>
+#include <slab_manager.h>
+#include <thread_cached_slab_manager.h>
+#include <array>
+#include <cstddef>
+#include <mutex>
+
+namespace
+{
+    constexpr std::size_t kObjectSize = 24;
+
+    // Live objects per thread and iteration. Kept small so that 8 threads still fit
+    // into the fixed 100-block class of the mutex-wrapped `SlabManager`.
+    constexpr std::size_t kThreadBatch = 8;
+
+    // Benchmark 1: One global mutex around every `SlabManager` call (the current deployment).
+    void BM_MutexSlabManager(benchmark::State &state)
+    {
+        static mcr::SlabManager manager;
+        static std::mutex manager_mutex;
+
+        std::array<void *, kThreadBatch> pointers{};
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < kThreadBatch; i++)
+            {
+                std::lock_guard<std::mutex> lock(manager_mutex);
+                pointers[i] = manager.Allocate(kObjectSize);
+            }
+            benchmark::DoNotOptimize(pointers.data());
+
+            for (std::size_t i = 0; i < kThreadBatch; i++)
+            {
+                std::lock_guard<std::mutex> lock(manager_mutex);
+                manager.Free(pointers[i], kObjectSize, sizeof(void *));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kThreadBatch));
+    }
+    BENCHMARK(BM_MutexSlabManager)->ThreadRange(1, 8)->UseRealTime();
+
+    // Benchmark 2: Per-thread caches; the shared pools are only locked for batch transfers.
+    void BM_ThreadCachedSlabManager(benchmark::State &state)
+    {
+        static mcr::ThreadCachedSlabManager manager(4096);
+
+        std::array<void *, kThreadBatch> pointers{};
+
+        for (auto _ : state)
+        {
+            for (std::size_t i = 0; i < kThreadBatch; i++)
+            {
+                pointers[i] = manager.Allocate(kObjectSize);
+            }
+            benchmark::DoNotOptimize(pointers.data());
+
+            for (std::size_t i = 0; i < kThreadBatch; i++)
+            {
+                manager.Free(pointers[i], kObjectSize, sizeof(void *));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kThreadBatch));
+    }
+    BENCHMARK(BM_ThreadCachedSlabManager)->ThreadRange(1, 8)->UseRealTime();
+}
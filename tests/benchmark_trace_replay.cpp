@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+#include <allocation_trace.h>
+#include <slab_manager.h>
+#include <cstddef>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t kTraceOps = 20000;
+
+    // Record a mixed workload through `RecordingManager` once; every benchmark replays the same plan.
+    const mcr::ReplayPlan &RecordedPlan()
+    {
+        static const mcr::ReplayPlan plan = []
+        {
+            mcr::SlabManagerConfig config;
+            config.growth = mcr::SlabGrowth::kGeometric;
+            config.max_blocks_per_class = 1 << 16;
+            mcr::SlabManager manager(config);
+            mcr::TraceRecorder recorder(kTraceOps);
+            mcr::RecordingManager<mcr::SlabManager> recording(manager, recorder);
+
+            std::mt19937 rng(42);
+            std::uniform_int_distribution<std::size_t> size(8, 1024);
+            std::uniform_int_distribution<int> percent(0, 99);
+            struct Live
+            {
+                void *ptr;
+                std::size_t size;
+            };
+            std::vector<Live> live;
+            for (std::size_t i = 0; i < kTraceOps / 2; i++)
+            {
+                if (live.empty() || percent(rng) < 55)
+                {
+                    const std::size_t request = size(rng);
+                    live.push_back(Live{recording.Allocate(request), request});
+                    continue;
+                }
+                const std::size_t index = (percent(rng) < 70) ? live.size() - 1 : std::uniform_int_distribution<std::size_t>(0, live.size() - 1)(rng);
+                recording.Free(live[index].ptr, live[index].size, sizeof(void *));
+                live[index] = live.back();
+                live.pop_back();
+            }
+            for (const Live &object : live)
+            {
+                recording.Free(object.ptr, object.size, sizeof(void *));
+            }
+
+            std::vector<mcr::TraceEvent> events;
+            recorder.Drain(events);
+            return mcr::BuildReplayPlan(events);
+        }();
+        return plan;
+    }
+
+    template <typename AllocateFn, typename FreeFn>
+    void RunReplay(benchmark::State &state, AllocateFn allocate, FreeFn release)
+    {
+        const mcr::ReplayPlan &plan = RecordedPlan();
+        std::vector<void *> table;
+        for (auto _ : state)
+        {
+            if (mcr::ReplayTrace(plan, table, allocate, release) != 0)
+            {
+                state.SkipWithError("Allocation failed during replay.");
+                return;
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * plan.ops.size()));
+    }
+
+    // Benchmark 1: Recorded trace replayed through malloc/free.
+    void BM_ReplayMalloc(benchmark::State &state)
+    {
+        RunReplay(
+            state,
+            [](std::size_t size, std::size_t)
+            { return std::malloc(size); },
+            [](void *ptr, std::size_t, std::size_t)
+            { std::free(ptr); });
+    }
+    BENCHMARK(BM_ReplayMalloc);
+
+    // Benchmark 2: Same trace through a growing `SlabManager`.
+    void BM_ReplaySlabManager(benchmark::State &state)
+    {
+        mcr::SlabManagerConfig config;
+        config.growth = mcr::SlabGrowth::kGeometric;
+        config.max_blocks_per_class = 1 << 16;
+        mcr::SlabManager manager(config);
+        RunReplay(
+            state,
+            [&manager](std::size_t size, std::size_t alignment)
+            { return manager.Allocate(size, alignment); },
+            [&manager](void *ptr, std::size_t size, std::size_t alignment)
+            { manager.Free(ptr, size, alignment); });
+    }
+    BENCHMARK(BM_ReplaySlabManager);
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "bitmap_slab_allocator.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+// ------------------------------------------------------------
+// Allocation order and capacity.
+// ------------------------------------------------------------
+
+TEST(BitmapSlabAllocatorTest, AllocatesBlocksInAddressOrder)
+{
+    mcr::BitmapSlabAllocator allocator(32, 32 * 200);
+    ASSERT_EQ(allocator.Capacity(), 200);
+
+    std::uintptr_t previous = 0;
+    for (std::size_t i = 0; i < allocator.Capacity(); i++)
+    {
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(allocator.Allocate());
+        ASSERT_NE(address, 0);
+        if (i > 0)
+        {
+            EXPECT_EQ(address, previous + 32);
+        }
+        previous = address;
+    }
+    EXPECT_EQ(allocator.Allocate(), nullptr);
+    EXPECT_EQ(allocator.InUse(), 200);
+}
+
+TEST(BitmapSlabAllocatorTest, ReusesLowestFreeBlockFirst)
+{
+    // 300 blocks span five bitmap words, so the lowest free block may sit in an earlier word than the last one freed.
+    mcr::BitmapSlabAllocator allocator(16, 16 * 300);
+    std::vector<void *> ptrs;
+    for (std::size_t i = 0; i < allocator.Capacity(); i++)
+    {
+        ptrs.push_back(allocator.Allocate());
+    }
+
+    allocator.Free(ptrs[250]);
+    allocator.Free(ptrs[3]);
+    allocator.Free(ptrs[130]);
+    EXPECT_EQ(allocator.Allocate(), ptrs[3]);
+    EXPECT_EQ(allocator.Allocate(), ptrs[130]);
+    EXPECT_EQ(allocator.Allocate(), ptrs[250]);
+    EXPECT_EQ(allocator.Allocate(), nullptr);
+}
+
+TEST(BitmapSlabAllocatorTest, BlocksHonorAlignmentAndNonPowerOfTwoSizes)
+{
+    mcr::BitmapSlabAllocator aligned(20, 4096, 64);
+    void *ptr1 = aligned.Allocate();
+    void *ptr2 = aligned.Allocate();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr1) % 64, 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr2) % 64, 0);
+
+    // 24-byte blocks take the division path when mapping a pointer back to its block.
+    mcr::BitmapSlabAllocator odd(24, 24 * 10);
+    std::vector<void *> ptrs;
+    for (std::size_t i = 0; i < odd.Capacity(); i++)
+    {
+        ptrs.push_back(odd.Allocate());
+    }
+    odd.Free(ptrs[7]);
+    EXPECT_FALSE(odd.IsAllocated(ptrs[7]));
+    EXPECT_TRUE(odd.IsAllocated(ptrs[6]));
+    EXPECT_EQ(odd.Allocate(), ptrs[7]);
+}
+
+TEST(BitmapSlabAllocatorTest, AlignedAllocationFillsBoundariesAndLeavesGapsForOthers)
+{
+    mcr::BitmapSlabAllocator allocator(64, 64 * 512);
+
+    // 512-byte boundaries are every eighth block; the blocks in between stay free.
+    void *aligned1 = allocator.AllocateAligned(512);
+    void *aligned2 = allocator.AllocateAligned(512);
+    ASSERT_NE(aligned1, nullptr);
+    ASSERT_NE(aligned2, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned1) % 512, 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned2), reinterpret_cast<std::uintptr_t>(aligned1) + 512);
+
+    // Plain and lower-alignment requests fill the gaps first.
+    EXPECT_EQ(allocator.Allocate(), static_cast<char *>(aligned1) + 64);
+    EXPECT_EQ(allocator.AllocateAligned(128), static_cast<char *>(aligned1) + 128);
+
+    // Page boundaries are 64 blocks apart, past the end of a bitmap word.
+    void *page = allocator.AllocateAligned(4096);
+    ASSERT_NE(page, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(page) % 4096, 0);
+    EXPECT_EQ(page, static_cast<char *>(aligned1) + 4096);
+
+    // Alignments the block size already covers take the plain path.
+    EXPECT_EQ(allocator.AllocateAligned(32), static_cast<char *>(aligned1) + 192);
+    EXPECT_EQ(allocator.InUse(), 6);
+}
+
+TEST(BitmapSlabAllocatorTest, AlignedAllocationReturnsNullptrWhenNoBoundaryIsFree)
+{
+    mcr::BitmapSlabAllocator allocator(64, 64 * 128);
+    ASSERT_NE(allocator.AllocateAligned(4096), nullptr);
+    ASSERT_NE(allocator.AllocateAligned(4096), nullptr);
+    EXPECT_EQ(allocator.AllocateAligned(4096), nullptr);
+
+    // Everything else is still free.
+    EXPECT_EQ(allocator.InUse(), 2);
+    EXPECT_NE(allocator.AllocateAligned(2048), nullptr);
+    EXPECT_THROW({ allocator.AllocateAligned(8192); }, std::invalid_argument);
+    EXPECT_THROW({ allocator.AllocateAligned(96); }, std::invalid_argument);
+}
+
+// ------------------------------------------------------------
+// Invalid frees.
+// ------------------------------------------------------------
+
+TEST(BitmapSlabAllocatorTest, DoubleFreeThrowsInvalidArgument)
+{
+    mcr::BitmapSlabAllocator allocator(32, 32 * 10);
+    void *ptr = allocator.Allocate();
+    allocator.Free(ptr);
+
+    EXPECT_THROW({ allocator.Free(ptr); }, std::invalid_argument);
+    EXPECT_EQ(allocator.InUse(), 0);
+
+    allocator.Free(nullptr); // No-op.
+}
+
+TEST(BitmapSlabAllocatorTest, ForeignOrInteriorPointerThrowsInvalidArgument)
+{
+    mcr::BitmapSlabAllocator allocator(32, 32 * 10);
+    unsigned char *ptr = static_cast<unsigned char *>(allocator.Allocate());
+    int local = 0;
+
+    EXPECT_THROW({ allocator.Free(&local); }, std::invalid_argument);
+    EXPECT_THROW({ allocator.Free(ptr + 8); }, std::invalid_argument);
+    EXPECT_FALSE(allocator.Owns(&local));
+    EXPECT_TRUE(allocator.Owns(ptr + 8));
+    EXPECT_TRUE(allocator.IsAllocated(ptr));
+    EXPECT_FALSE(allocator.IsAllocated(ptr + 8));
+
+    allocator.Free(ptr);
+}
+
+TEST(BitmapSlabAllocatorTest, InvalidGeometryThrowsInvalidArgument)
+{
+    EXPECT_THROW({ mcr::BitmapSlabAllocator allocator(32, 16); }, std::invalid_argument);
+    EXPECT_THROW({ mcr::BitmapSlabAllocator allocator(32, 1024, 24); }, std::invalid_argument);
+}
@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "buddy_allocator.h"
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t kMinBlock = 2048;
+    constexpr std::size_t kMaxBlock = 1 << 16;
+}
+
+// ------------------------------------------------------------
+// Allocation and splitting.
+// ------------------------------------------------------------
+
+TEST(BuddyAllocatorTest, BlocksAreAlignedToTheirOrder)
+{
+    mcr::BuddyAllocator buddy(kMinBlock, kMaxBlock, kMaxBlock);
+
+    for (std::size_t size = 1; size <= kMaxBlock; size *= 2)
+    {
+        SCOPED_TRACE(testing::Message() << "size = " << size);
+
+        void *ptr = buddy.Allocate(size, sizeof(void *));
+        ASSERT_NE(ptr, nullptr);
+        const std::size_t block_size = buddy.BlockSizeFor(size, sizeof(void *));
+        EXPECT_EQ(block_size, size < kMinBlock ? kMinBlock : size);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % block_size, 0);
+        EXPECT_TRUE(buddy.Owns(ptr));
+        buddy.Free(ptr, size, sizeof(void *));
+    }
+}
+
+TEST(BuddyAllocatorTest, SplitsServeEveryMinimumBlockOfTheRegion)
+{
+    mcr::BuddyAllocator buddy(kMinBlock, kMaxBlock, kMaxBlock);
+    constexpr std::size_t kBlocks = kMaxBlock / kMinBlock;
+
+    std::vector<void *> ptrs;
+    for (std::size_t i = 0; i < kBlocks; i++)
+    {
+        void *ptr = buddy.Allocate(kMinBlock, sizeof(void *));
+        ASSERT_NE(ptr, nullptr);
+        std::memset(ptr, static_cast<int>(i), kMinBlock);
+        ptrs.push_back(ptr);
+    }
+    EXPECT_EQ(buddy.Allocate(1, sizeof(void *)), nullptr);
+    EXPECT_EQ(buddy.GetStats().bytes_in_use, kMaxBlock);
+    EXPECT_EQ(buddy.GetStats().failed_allocations, 1);
+
+    // Blocks must not overlap: every block still holds its own fill byte.
+    for (std::size_t i = 0; i < kBlocks; i++)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(ptrs[i]);
+        EXPECT_EQ(bytes[0], static_cast<unsigned char>(i));
+        EXPECT_EQ(bytes[kMinBlock - 1], static_cast<unsigned char>(i));
+    }
+
+    for (void *ptr : ptrs)
+    {
+        buddy.Free(ptr, kMinBlock, sizeof(void *));
+    }
+}
+
+// ------------------------------------------------------------
+// Coalescing on free.
+// ------------------------------------------------------------
+
+TEST(BuddyAllocatorTest, FreeCoalescesBackToTheLargestBlock)
+{
+    mcr::BuddyAllocator buddy(kMinBlock, kMaxBlock, kMaxBlock);
+
+    // Fragment the region with a random mix of sizes, then free in a different random order.
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<std::size_t> dist(1, kMaxBlock / 4);
+    std::vector<std::pair<void *, std::size_t>> live;
+    for (;;)
+    {
+        const std::size_t size = dist(rng);
+        void *ptr = buddy.Allocate(size, sizeof(void *));
+        if (!ptr)
+        {
+            break;
+        }
+        live.emplace_back(ptr, size);
+    }
+    ASSERT_GT(live.size(), 1u);
+
+    std::shuffle(live.begin(), live.end(), rng);
+    for (const auto &[ptr, size] : live)
+    {
+        buddy.Free(ptr, size, sizeof(void *));
+    }
+    EXPECT_EQ(buddy.GetStats().bytes_in_use, 0);
+    EXPECT_EQ(buddy.GetStats().live_allocations, 0);
+
+    // Only a fully merged region can serve the largest block again.
+    void *whole = buddy.Allocate(kMaxBlock, sizeof(void *));
+    EXPECT_NE(whole, nullptr);
+    buddy.Free(whole, kMaxBlock, sizeof(void *));
+}
+
+TEST(BuddyAllocatorTest, StatsTrackPeakAndTotals)
+{
+    mcr::BuddyAllocator buddy(kMinBlock, kMaxBlock, 2 * kMaxBlock);
+    EXPECT_EQ(buddy.GetStats().region_size, 2 * kMaxBlock);
+
+    void *ptr1 = buddy.Allocate(3000, sizeof(void *)); // 4 KiB block.
+    void *ptr2 = buddy.Allocate(kMaxBlock, sizeof(void *));
+    ASSERT_NE(ptr1, nullptr);
+    ASSERT_NE(ptr2, nullptr);
+    buddy.Free(ptr2, kMaxBlock, sizeof(void *));
+
+    const mcr::BuddyStats stats = buddy.GetStats();
+    EXPECT_EQ(stats.bytes_in_use, 4096);
+    EXPECT_EQ(stats.peak_bytes_in_use, 4096 + kMaxBlock);
+    EXPECT_EQ(stats.live_allocations, 1);
+    EXPECT_EQ(stats.total_allocations, 2);
+    buddy.Free(ptr1, 3000, sizeof(void *));
+}
+
+TEST(BuddyAllocatorTest, SizelessFreeRecoversTheBlockOrder)
+{
+    mcr::BuddyAllocator buddy(kMinBlock, kMaxBlock, kMaxBlock);
+
+    void *small = buddy.Allocate(100, sizeof(void *));
+    void *medium = buddy.Allocate(5000, 4096);
+    void *big = buddy.Allocate(kMaxBlock / 2, sizeof(void *));
+    ASSERT_NE(small, nullptr);
+    ASSERT_NE(medium, nullptr);
+    ASSERT_NE(big, nullptr);
+
+    buddy.Free(medium);
+    buddy.Free(small);
+    buddy.Free(big);
+    EXPECT_EQ(buddy.GetStats().bytes_in_use, 0);
+    EXPECT_NE(buddy.Allocate(kMaxBlock, sizeof(void *)), nullptr); // Fully coalesced again.
+}
+
+TEST(BuddyAllocatorTest, ResizeGrowsIntoFreeBuddiesAndShrinksInPlace)
+{
+    mcr::BuddyAllocator buddy(kMinBlock, kMaxBlock, kMaxBlock);
+
+    // Growing absorbs the free upper buddies; the block keeps its address.
+    void *ptr = buddy.Allocate(kMinBlock, sizeof(void *));
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_TRUE(buddy.Resize(ptr, kMinBlock, 4 * kMinBlock, sizeof(void *)));
+    EXPECT_EQ(buddy.GetStats().bytes_in_use, 4 * kMinBlock);
+
+    // A live block in the way stops further growth.
+    void *neighbor = buddy.Allocate(4 * kMinBlock, sizeof(void *));
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(neighbor), reinterpret_cast<std::uintptr_t>(ptr) + 4 * kMinBlock);
+    EXPECT_FALSE(buddy.Resize(ptr, 4 * kMinBlock, 8 * kMinBlock, sizeof(void *)));
+    EXPECT_EQ(buddy.GetStats().bytes_in_use, 8 * kMinBlock);
+
+    // Shrinking frees the upper halves, which serve the next small request.
+    EXPECT_TRUE(buddy.Resize(ptr, 4 * kMinBlock, kMinBlock, sizeof(void *)));
+    EXPECT_EQ(buddy.Allocate(kMinBlock, sizeof(void *)), static_cast<char *>(ptr) + kMinBlock);
+    EXPECT_EQ(buddy.GetStats().bytes_in_use, 6 * kMinBlock);
+
+    // An upper buddy can never grow in place.
+    EXPECT_FALSE(buddy.Resize(neighbor, 4 * kMinBlock, 8 * kMinBlock, sizeof(void *)));
+    EXPECT_FALSE(buddy.Resize(ptr, kMinBlock, 2 * kMaxBlock, sizeof(void *)));
+}
+
+// ------------------------------------------------------------
+// Allocation failure and invalid input.
+// ------------------------------------------------------------
+
+TEST(BuddyAllocatorTest, RequestAboveMaxBlockReturnsNullptr)
+{
+    mcr::BuddyAllocator buddy(kMinBlock, kMaxBlock, kMaxBlock);
+
+    EXPECT_EQ(buddy.Allocate(kMaxBlock + 1, sizeof(void *)), nullptr);
+    EXPECT_EQ(buddy.Allocate(16, 2 * kMaxBlock), nullptr);
+    EXPECT_EQ(buddy.BlockSizeFor(kMaxBlock + 1, sizeof(void *)), 0);
+}
+
+TEST(BuddyAllocatorTest, InvalidConfigThrowsInvalidArgument)
+{
+    EXPECT_THROW({ mcr::BuddyAllocator buddy(3000, kMaxBlock, kMaxBlock); }, std::invalid_argument);
+    EXPECT_THROW({ mcr::BuddyAllocator buddy(kMinBlock, kMinBlock / 2, kMaxBlock); }, std::invalid_argument);
+    EXPECT_THROW({ mcr::BuddyAllocator buddy(4, 64, 64); }, std::invalid_argument);
+    EXPECT_THROW({ mcr::BuddyAllocator buddy(kMinBlock, kMaxBlock, 0); }, std::invalid_argument);
+}
+
+TEST(BuddyAllocatorTest, FreeNullptrIsNoOp)
+{
+    mcr::BuddyAllocator buddy(kMinBlock, kMaxBlock, kMaxBlock);
+
+    buddy.Free(nullptr, kMinBlock, sizeof(void *));
+    EXPECT_EQ(buddy.GetStats().live_allocations, 0);
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include "concurrent_slab_allocator.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t kBlockSize = 32;
+}
+
+// ------------------------------------------------------------
+// Single-thread behavior (same contract as `SlabAllocator`).
+// ------------------------------------------------------------
+
+TEST(ConcurrentSlabAllocatorTest, ExhaustsAfterWholeBlocksAndRestoresOnFree)
+{
+    const int block_count = 3;
+    mcr::ConcurrentSlabAllocator allocator(kBlockSize, kBlockSize * block_count + kBlockSize / 2);
+
+    void *ptr1 = allocator.Allocate();
+    void *ptr2 = allocator.Allocate();
+    void *ptr3 = allocator.Allocate();
+    ASSERT_NE(ptr1, nullptr);
+    ASSERT_NE(ptr2, nullptr);
+    ASSERT_NE(ptr3, nullptr);
+    EXPECT_NE(ptr1, ptr2);
+    EXPECT_NE(ptr2, ptr3);
+    EXPECT_NE(ptr1, ptr3);
+
+    ASSERT_EQ(allocator.Allocate(), nullptr); // The remainder does not form another block.
+
+    allocator.Free(ptr2);
+    EXPECT_EQ(allocator.Allocate(), ptr2); // LIFO reuse.
+    EXPECT_EQ(allocator.Allocate(), nullptr);
+}
+
+TEST(ConcurrentSlabAllocatorTest, FreeNullptrIsNoOp)
+{
+    mcr::ConcurrentSlabAllocator allocator(kBlockSize, kBlockSize * 2);
+
+    void *ptr1 = allocator.Allocate();
+    void *ptr2 = allocator.Allocate();
+    ASSERT_NE(ptr1, nullptr);
+    ASSERT_NE(ptr2, nullptr);
+
+    allocator.Free(ptr2);
+    allocator.Free(ptr1);
+    allocator.Free(nullptr);
+
+    EXPECT_EQ(allocator.Allocate(), ptr1);
+    EXPECT_EQ(allocator.Allocate(), ptr2);
+    EXPECT_EQ(allocator.Allocate(), nullptr);
+}
+
+TEST(ConcurrentSlabAllocatorTest, RequestedAlignmentIsPreserved)
+{
+    mcr::ConcurrentSlabAllocator allocator(24, 64 * 4, 64);
+
+    for (int i = 0; i < 4; i++)
+    {
+        void *ptr = allocator.Allocate();
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64, 0);
+    }
+}
+
+TEST(ConcurrentSlabAllocatorTest, InvalidArgumentsThrow)
+{
+    EXPECT_THROW({ mcr::ConcurrentSlabAllocator allocator(kBlockSize, kBlockSize * 2, 0); }, std::invalid_argument);
+    EXPECT_THROW({ mcr::ConcurrentSlabAllocator allocator(kBlockSize, kBlockSize * 2, 24); }, std::invalid_argument);
+    EXPECT_THROW({ mcr::ConcurrentSlabAllocator allocator(kBlockSize, kBlockSize / 2); }, std::invalid_argument);
+}
+
+// ------------------------------------------------------------
+// Concurrent stress.
+// ------------------------------------------------------------
+
+TEST(ConcurrentSlabAllocatorTest, ConcurrentAllocateFreeStress)
+{
+    constexpr int kThreads = 8;
+    constexpr int kRounds = 2000;
+    constexpr int kLive = 8;
+    constexpr std::size_t kBlocks = 48; // Fewer blocks than threads * kLive, so threads also hit exhaustion.
+    mcr::ConcurrentSlabAllocator allocator(kBlockSize, kBlockSize * kBlocks);
+
+    std::atomic<int> corrupted{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++)
+    {
+        threads.emplace_back([&allocator, &corrupted, t]
+                             {
+            unsigned char *held[kLive];
+            for (int round = 0; round < kRounds; round++)
+            {
+                const unsigned char tag = static_cast<unsigned char>(t + 1);
+                int count = 0;
+                for (int i = 0; i < kLive; i++)
+                {
+                    unsigned char *ptr = static_cast<unsigned char *>(allocator.Allocate());
+                    if (ptr)
+                    {
+                        std::memset(ptr, tag, kBlockSize);
+                        held[count++] = ptr;
+                    }
+                }
+
+                // A block handed out twice would carry another thread's tag.
+                for (int i = 0; i < count; i++)
+                {
+                    for (std::size_t b = 0; b < kBlockSize; b++)
+                    {
+                        if (held[i][b] != tag)
+                        {
+                            corrupted.fetch_add(1, std::memory_order_relaxed);
+                            break;
+                        }
+                    }
+                    allocator.Free(held[i]);
+                }
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(corrupted.load(), 0);
+
+    // Every block must be back on the free list exactly once.
+    std::set<void *> blocks;
+    for (std::size_t i = 0; i < kBlocks; i++)
+    {
+        void *ptr = allocator.Allocate();
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_TRUE(blocks.insert(ptr).second);
+    }
+    EXPECT_EQ(allocator.Allocate(), nullptr);
+}
+
+TEST(ConcurrentSlabAllocatorTest, StatsAggregateAllThreads)
+{
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 4;
+    mcr::ConcurrentSlabAllocator allocator(kBlockSize, kBlockSize * 20);
+
+    std::vector<void *> held(kThreads * kPerThread);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++)
+    {
+        threads.emplace_back([&allocator, &held, t]
+                             {
+            for (int i = 0; i < kPerThread; i++)
+            {
+                held[t * kPerThread + i] = allocator.Allocate();
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    for (int i = 0; i < kThreads * kPerThread; i += 2)
+    {
+        allocator.Free(held[i]);
+    }
+    for (int i = 0; i < 13; i++)
+    {
+        allocator.Allocate();
+    }
+
+    const mcr::SlabStats stats = allocator.GetStats();
+    EXPECT_EQ(stats.block_size, kBlockSize);
+    EXPECT_EQ(stats.capacity, 20);
+    if (mcr::kStatsEnabled)
+    {
+        EXPECT_EQ(stats.in_use, 20);
+        EXPECT_EQ(stats.peak_in_use, 20);
+        EXPECT_EQ(stats.total_allocations, 28);
+        EXPECT_EQ(stats.failed_allocations, 1);
+    }
+    else
+    {
+        EXPECT_EQ(stats.in_use, 0);
+        EXPECT_EQ(stats.total_allocations, 0);
+    }
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include "coroutine_frame.h"
+#include "slab_manager.h"
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <utility>
+
+namespace
+{
+    // Lazily started coroutine returning an int; the frame lives until the task is destroyed.
+    template <typename Promise>
+    class Task
+    {
+    public:
+        using promise_type = Promise;
+
+        explicit Task(std::coroutine_handle<Promise> handle) : handle_(handle) {}
+        Task(Task &&other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+        ~Task()
+        {
+            if (handle_)
+            {
+                handle_.destroy();
+            }
+        }
+
+        int Run()
+        {
+            handle_.resume();
+            return handle_.promise().value;
+        }
+
+        void *Frame() const
+        {
+            return handle_.address();
+        }
+
+    private:
+        std::coroutine_handle<Promise> handle_;
+    };
+
+    template <typename Promise>
+    struct PromiseBase
+    {
+        int value = 0;
+
+        Task<Promise> get_return_object()
+        {
+            return Task<Promise>(std::coroutine_handle<Promise>::from_promise(static_cast<Promise &>(*this)));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_value(int result) { value = result; }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    struct SlabPromise : PromiseBase<SlabPromise>, mcr::CoroutineFramePromise<mcr::SlabManager>
+    {
+    };
+
+    using SlabTask = Task<SlabPromise>;
+
+    SlabTask Add(int a, int b)
+    {
+        co_return a + b;
+    }
+
+    SlabTask AddWith(std::allocator_arg_t, mcr::SlabManager &, int a, int b)
+    {
+        co_return a + b;
+    }
+
+    struct Worker
+    {
+        int base = 40;
+
+        SlabTask AddTo(std::allocator_arg_t, mcr::SlabManager &, int a)
+        {
+            co_return base + a;
+        }
+    };
+
+    // The contiguous arena lets `Owns()` tell slab frames apart from heap frames.
+    mcr::SlabManagerConfig ArenaConfig()
+    {
+        mcr::SlabManagerConfig config;
+        config.contiguous_arena = true;
+        return config;
+    }
+}
+
+// ------------------------------------------------------------
+// Frame routing.
+// ------------------------------------------------------------
+
+TEST(CoroutineFrameTest, ScopeRoutesFramesIntoTheManager)
+{
+    mcr::SlabManager manager(ArenaConfig());
+    {
+        mcr::CoroutineFrameScope<mcr::SlabManager> scope(manager);
+        EXPECT_EQ(mcr::CoroutineFrameScope<mcr::SlabManager>::Current(), &manager);
+
+        SlabTask task = Add(2, 3);
+        EXPECT_TRUE(manager.Owns(task.Frame()));
+        EXPECT_EQ(task.Run(), 5);
+
+        // Destroying the frame returns its block: the next frame of the same size reuses it.
+        void *frame = task.Frame();
+        {
+            SlabTask discarded = std::move(task);
+        }
+        SlabTask again = Add(4, 5);
+        EXPECT_EQ(again.Frame(), frame);
+    }
+    EXPECT_EQ(mcr::CoroutineFrameScope<mcr::SlabManager>::Current(), nullptr);
+}
+
+TEST(CoroutineFrameTest, LeadingAllocatorArgumentPicksTheManager)
+{
+    mcr::SlabManager manager(ArenaConfig());
+
+    SlabTask task = AddWith(std::allocator_arg, manager, 20, 22);
+    EXPECT_TRUE(manager.Owns(task.Frame()));
+    EXPECT_EQ(task.Run(), 42);
+
+    Worker worker;
+    SlabTask member = worker.AddTo(std::allocator_arg, manager, 2);
+    EXPECT_TRUE(manager.Owns(member.Frame()));
+    EXPECT_EQ(member.Run(), 42);
+}
+
+TEST(CoroutineFrameTest, FrameOutlivesItsScope)
+{
+    mcr::SlabManager manager(ArenaConfig());
+    std::unique_ptr<SlabTask> task;
+    {
+        mcr::CoroutineFrameScope<mcr::SlabManager> scope(manager);
+        task = std::make_unique<SlabTask>(Add(1, 1));
+    }
+
+    // The frame remembers its manager, so destroying it outside the scope still frees into the manager.
+    void *frame = task->Frame();
+    EXPECT_EQ(task->Run(), 2);
+    task.reset();
+
+    mcr::CoroutineFrameScope<mcr::SlabManager> scope(manager);
+    SlabTask again = Add(1, 1);
+    EXPECT_EQ(again.Frame(), frame);
+}
+
+// ------------------------------------------------------------
+// Fallback to the global heap.
+// ------------------------------------------------------------
+
+TEST(CoroutineFrameTest, WithoutScopeFramesComeFromTheHeap)
+{
+    mcr::SlabManager manager(ArenaConfig());
+
+    SlabTask task = Add(3, 4);
+    EXPECT_FALSE(manager.Owns(task.Frame()));
+    EXPECT_EQ(task.Run(), 7);
+}
+
+TEST(CoroutineFrameTest, ExhaustedManagerFallsBackToTheHeap)
+{
+    mcr::SlabManagerConfig config = ArenaConfig();
+    config.blocks_per_class = 1;
+    mcr::SlabManager manager(config);
+    mcr::CoroutineFrameScope<mcr::SlabManager> scope(manager);
+
+    SlabTask first = Add(1, 2);
+    SlabTask second = Add(3, 4);
+    EXPECT_TRUE(manager.Owns(first.Frame()));
+    EXPECT_FALSE(manager.Owns(second.Frame()));
+    EXPECT_EQ(first.Run() + second.Run(), 10);
+}
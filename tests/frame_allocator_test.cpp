@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "frame_allocator.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+// ------------------------------------------------------------
+// LinearAllocator.
+// ------------------------------------------------------------
+
+TEST(FrameAllocatorTest, LinearAllocationsAreAlignedAndDisjoint)
+{
+    mcr::LinearAllocator allocator(1024);
+
+    char *first = static_cast<char *>(allocator.Allocate(3, 1));
+    ASSERT_NE(first, nullptr);
+    std::memset(first, 0xAB, 3);
+
+    for (std::size_t alignment = 1; alignment <= 256; alignment *= 2)
+    {
+        SCOPED_TRACE(testing::Message() << "alignment = " << alignment);
+        void *ptr = allocator.Allocate(5, alignment);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignment, 0);
+        EXPECT_GE(static_cast<char *>(ptr), first + 3);
+        EXPECT_TRUE(allocator.Owns(ptr));
+    }
+    EXPECT_EQ(first[2], static_cast<char>(0xAB));
+}
+
+TEST(FrameAllocatorTest, ExhaustionReturnsNullptrAndResetRewinds)
+{
+    mcr::LinearAllocator allocator(256);
+
+    void *first = allocator.Allocate(200, 16);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(allocator.Used(), 200);
+    EXPECT_EQ(allocator.Allocate(64, 16), nullptr);
+    EXPECT_NE(allocator.Allocate(48, 8), nullptr); // The rest of the pool still serves smaller requests.
+    EXPECT_EQ(allocator.Allocate(static_cast<std::size_t>(-1), 1), nullptr);
+
+    allocator.Reset();
+    EXPECT_EQ(allocator.Used(), 0);
+    EXPECT_EQ(allocator.Allocate(256, 16), first);
+}
+
+TEST(FrameAllocatorTest, InvalidRequestsThrowInvalidArgument)
+{
+    EXPECT_THROW({ mcr::LinearAllocator allocator(0); }, std::invalid_argument);
+
+    mcr::LinearAllocator allocator(64);
+    EXPECT_THROW({ allocator.Allocate(0); }, std::invalid_argument);
+    EXPECT_THROW({ allocator.Allocate(8, 0); }, std::invalid_argument);
+    EXPECT_THROW({ allocator.Allocate(8, 24); }, std::invalid_argument);
+}
+
+// ------------------------------------------------------------
+// DoubleBufferedFrameAllocator.
+// ------------------------------------------------------------
+
+TEST(FrameAllocatorTest, PreviousFrameSurvivesOneFrame)
+{
+    mcr::DoubleBufferedFrameAllocator frames(256);
+
+    int *frame0 = static_cast<int *>(frames.Allocate(sizeof(int), alignof(int)));
+    ASSERT_NE(frame0, nullptr);
+    *frame0 = 10;
+
+    frames.NextFrame();
+    EXPECT_TRUE(frames.PreviousFrame().Owns(frame0));
+    int *frame1 = static_cast<int *>(frames.Allocate(sizeof(int), alignof(int)));
+    ASSERT_NE(frame1, nullptr);
+    EXPECT_FALSE(frames.CurrentFrame().Owns(frame0));
+    *frame1 = *frame0 + 1; // Frame N + 1 reads frame N's data.
+    EXPECT_EQ(*frame0, 10);
+
+    frames.NextFrame();
+    EXPECT_EQ(frames.CurrentFrame().Used(), 0);
+    EXPECT_EQ(frames.PreviousFrame().Used(), sizeof(int));
+    EXPECT_EQ(frames.Allocate(sizeof(int), alignof(int)), frame0); // Frame N's buffer is reused for frame N + 2.
+    EXPECT_EQ(*frame1, 11);
+}
+
+TEST(FrameAllocatorTest, EachFrameHasItsOwnCapacity)
+{
+    mcr::DoubleBufferedFrameAllocator frames(128);
+
+    EXPECT_NE(frames.Allocate(128, 16), nullptr);
+    EXPECT_EQ(frames.Allocate(1, 1), nullptr);
+
+    frames.NextFrame();
+    EXPECT_NE(frames.Allocate(128, 16), nullptr);
+}
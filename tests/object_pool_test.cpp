@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "object_pool.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Tracked
+    {
+        static int live;
+
+        std::string name;
+        int value;
+
+        Tracked(std::string name_in, int value_in) : name(std::move(name_in)), value(value_in)
+        {
+            live++;
+        }
+
+        ~Tracked()
+        {
+            live--;
+        }
+    };
+    int Tracked::live = 0;
+
+    struct ThrowingCtor
+    {
+        explicit ThrowingCtor(bool fail)
+        {
+            if (fail)
+            {
+                throw std::runtime_error("constructor failed");
+            }
+        }
+    };
+
+    struct alignas(128) Overaligned
+    {
+        char bytes[40];
+    };
+
+    static_assert(mcr::ObjectPool<char>::kBlockSize == sizeof(void *), "Tiny types round up to an embedded free-list node.");
+    static_assert(mcr::ObjectPool<Overaligned>::kBlockSize == 128, "Over-aligned types round up to their alignment.");
+}
+
+// ------------------------------------------------------------
+// Construction and destruction.
+// ------------------------------------------------------------
+
+TEST(ObjectPoolTest, CreateConstructsAndDestroyDestructs)
+{
+    mcr::ObjectPool<Tracked> pool(4);
+
+    Tracked *object = pool.Create("first", 7);
+    ASSERT_NE(object, nullptr);
+    EXPECT_EQ(object->name, "first");
+    EXPECT_EQ(object->value, 7);
+    EXPECT_EQ(Tracked::live, 1);
+
+    pool.Destroy(object);
+    EXPECT_EQ(Tracked::live, 0);
+    pool.Destroy(nullptr);
+
+    EXPECT_EQ(pool.Create("second", 8), object); // LIFO reuse of the freed block.
+    pool.Destroy(object);
+}
+
+TEST(ObjectPoolTest, ThrowingConstructorReturnsTheBlock)
+{
+    mcr::ObjectPool<ThrowingCtor> pool(1);
+
+    EXPECT_THROW({ pool.Create(true); }, std::runtime_error);
+    ThrowingCtor *object = pool.Create(false); // The only block was handed back.
+    EXPECT_NE(object, nullptr);
+    pool.Destroy(object);
+}
+
+TEST(ObjectPoolTest, OveralignedObjectsKeepTheirAlignment)
+{
+    mcr::ObjectPool<Overaligned> pool(8);
+
+    std::vector<Overaligned *> objects;
+    for (int i = 0; i < 8; i++)
+    {
+        Overaligned *object = pool.Create();
+        ASSERT_NE(object, nullptr);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(object) % alignof(Overaligned), 0);
+        objects.push_back(object);
+    }
+    for (Overaligned *object : objects)
+    {
+        pool.Destroy(object);
+    }
+}
+
+// ------------------------------------------------------------
+// Capacity and growth.
+// ------------------------------------------------------------
+
+TEST(ObjectPoolTest, ExhaustionReturnsNullptrAndGrowthRaisesCapacity)
+{
+    mcr::ObjectPool<int> fixed(3);
+    for (int i = 0; i < 3; i++)
+    {
+        ASSERT_NE(fixed.Create(i), nullptr);
+    }
+    EXPECT_EQ(fixed.Create(3), nullptr);
+
+    mcr::ObjectPool<int> growable(3, mcr::SlabGrowth::kGeometric, 20);
+    for (int i = 0; i < 20; i++)
+    {
+        int *object = growable.Create(i);
+        ASSERT_NE(object, nullptr);
+        EXPECT_EQ(*object, i);
+    }
+    EXPECT_EQ(growable.Create(20), nullptr);
+}
+
+TEST(ObjectPoolTest, InvalidCapacityThrowsInvalidArgument)
+{
+    EXPECT_THROW({ mcr::ObjectPool<int> pool(0); }, std::invalid_argument);
+    EXPECT_THROW({ mcr::ObjectPool<int> pool(static_cast<std::size_t>(-1)); }, std::invalid_argument);
+    EXPECT_THROW({ mcr::ObjectPool<int> pool(10, mcr::SlabGrowth::kLinear, 5); }, std::invalid_argument);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "page_heap.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+// ------------------------------------------------------------
+// Span allocation.
+// ------------------------------------------------------------
+
+TEST(PageHeapTest, SpansAreAlignedDistinctAndIndexed)
+{
+    constexpr std::size_t kSpanSize = 16 * 1024;
+    mcr::PageHeap heap(8 * kSpanSize, kSpanSize);
+    ASSERT_EQ(heap.SpanCount(), 8);
+    ASSERT_EQ(heap.SpanSize(), kSpanSize);
+
+    std::set<std::size_t> indices;
+    for (std::size_t i = 0; i < heap.SpanCount(); i++)
+    {
+        void *span = heap.AllocateSpan();
+        ASSERT_NE(span, nullptr);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(span) % kSpanSize, 0);
+        EXPECT_TRUE(heap.Owns(span));
+
+        // Every address inside the span maps back to it.
+        const std::size_t index = heap.SpanIndex(static_cast<char *>(span) + kSpanSize - 1);
+        EXPECT_EQ(heap.SpanAddress(index), span);
+        indices.insert(index);
+    }
+    EXPECT_EQ(indices.size(), 8);
+    EXPECT_EQ(heap.AllocateSpan(), nullptr);
+
+    int outside = 0;
+    EXPECT_FALSE(heap.Owns(&outside));
+}
+
+TEST(PageHeapTest, ReturnedSpanIsReusedFirst)
+{
+    mcr::PageHeap heap(4 * mcr::PageHeap::kDefaultSpanSize);
+    void *first = heap.AllocateSpan();
+    void *second = heap.AllocateSpan();
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+
+    heap.FreeSpan(first);
+    heap.FreeSpan(second);
+    EXPECT_EQ(heap.AllocateSpan(), second);
+    EXPECT_EQ(heap.AllocateSpan(), first);
+
+    const mcr::PageHeapStats stats = heap.GetStats();
+    EXPECT_EQ(stats.spans_in_use, 2);
+    EXPECT_EQ(stats.peak_spans_in_use, 2);
+}
+
+TEST(PageHeapTest, InvalidGeometryThrowsInvalidArgument)
+{
+    EXPECT_THROW(mcr::PageHeap(1 << 20, 3 * 4096), std::invalid_argument);
+    EXPECT_THROW(mcr::PageHeap(1 << 20, mcr::PageHeap::kMinSpanSize / 2), std::invalid_argument);
+    EXPECT_THROW(mcr::PageHeap(mcr::PageHeap::kDefaultSpanSize - 1), std::invalid_argument);
+}
+
+// ------------------------------------------------------------
+// Releasing pages.
+// ------------------------------------------------------------
+
+TEST(PageHeapTest, ReleaseHandsBackReturnedSpansOnce)
+{
+    mcr::PageHeap heap(4 * mcr::PageHeap::kDefaultSpanSize, mcr::PageHeap::kDefaultSpanSize, mcr::PoolBacking::kMmap);
+    void *kept = heap.AllocateSpan();
+    void *returned = heap.AllocateSpan();
+    std::memset(kept, 0xAB, heap.SpanSize());
+    std::memset(returned, 0xCD, heap.SpanSize());
+    heap.FreeSpan(returned);
+
+    EXPECT_EQ(heap.Release(), heap.SpanSize());
+    EXPECT_EQ(heap.Release(), 0); // Already released.
+    EXPECT_EQ(heap.GetStats().released_spans, 1);
+    EXPECT_EQ(static_cast<unsigned char *>(kept)[heap.SpanSize() - 1], 0xAB);
+
+    // Handing the span out again clears its released state; its pages re-fault on touch.
+    EXPECT_EQ(heap.AllocateSpan(), returned);
+    EXPECT_EQ(heap.GetStats().released_spans, 0);
+    std::memset(returned, 0, heap.SpanSize());
+}
@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include "per_cpu_slab_manager.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    mcr::SlabManagerConfig FixedCapacityConfig(std::size_t blocks_per_class)
+    {
+        mcr::SlabManagerConfig config;
+        config.blocks_per_class = blocks_per_class;
+        return config;
+    }
+}
+
+// ------------------------------------------------------------
+// Single-thread behavior.
+// ------------------------------------------------------------
+
+TEST(PerCpuSlabManagerTest, AllocationIsAlignedAndReusedFromCpuCache)
+{
+    mcr::PerCpuSlabManager manager;
+    EXPECT_GE(manager.ShardCount(), 1);
+
+    void *ptr1 = manager.Allocate(16, 64);
+    ASSERT_NE(ptr1, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr1) % 64, 0);
+    manager.Free(ptr1, 16, 64);
+
+    // The CPU cache is LIFO; unless the thread migrated in between, the same block comes back.
+    const std::size_t cpu = mcr::PerCpuSlabManager::CurrentCpu();
+    void *ptr2 = manager.Allocate(16, 64);
+    ASSERT_NE(ptr2, nullptr);
+    if (cpu == mcr::PerCpuSlabManager::CurrentCpu())
+    {
+        EXPECT_EQ(ptr2, ptr1);
+    }
+    manager.Free(ptr2, 16, 64);
+}
+
+TEST(PerCpuSlabManagerTest, CapacityMatchesBlocksPerClassAcrossShards)
+{
+    constexpr std::size_t kBlocksPerClass = 150;
+    mcr::PerCpuSlabManager manager(FixedCapacityConfig(kBlocksPerClass), 4);
+    EXPECT_EQ(manager.ShardCount(), 4);
+
+    std::vector<void *> ptrs;
+    for (std::size_t i = 0; i < kBlocksPerClass; i++)
+    {
+        void *ptr = manager.Allocate(40);
+        ASSERT_NE(ptr, nullptr);
+        ptrs.push_back(ptr);
+    }
+    EXPECT_EQ(manager.Allocate(40), nullptr);
+
+    for (void *ptr : ptrs)
+    {
+        manager.Free(ptr, 40, sizeof(void *));
+    }
+    manager.FlushCpuCaches();
+
+    for (std::size_t i = 0; i < kBlocksPerClass; i++)
+    {
+        ASSERT_NE(manager.Allocate(40), nullptr);
+    }
+    EXPECT_EQ(manager.Allocate(40), nullptr);
+}
+
+TEST(PerCpuSlabManagerTest, InvalidRequestsThrowOrReturnNullptr)
+{
+    mcr::PerCpuSlabManager manager;
+
+    EXPECT_THROW({ manager.Allocate(0); }, std::invalid_argument);
+    EXPECT_THROW({ manager.Allocate(16, 24); }, std::invalid_argument);
+    EXPECT_EQ(manager.Allocate(2048), nullptr);
+    EXPECT_THROW({ mcr::PerCpuSlabManager invalid(FixedCapacityConfig(0)); }, std::invalid_argument);
+
+    manager.Free(nullptr, 16, sizeof(void *)); // No-op.
+}
+
+// ------------------------------------------------------------
+// Multi-thread behavior.
+// ------------------------------------------------------------
+
+TEST(PerCpuSlabManagerTest, OversubscribedThreadsDoNotOverlap)
+{
+    // Far more threads than shards, so threads share and migrate between CPU caches.
+    constexpr int kThreads = 16;
+    constexpr int kRounds = 100;
+    constexpr std::size_t kLive = 24;
+    constexpr std::size_t kSize = 64;
+    mcr::PerCpuSlabManager manager(FixedCapacityConfig(kThreads * kLive * 2), 2);
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(kThreads, 0);
+    for (int t = 0; t < kThreads; t++)
+    {
+        threads.emplace_back([&manager, &failures, t]
+                             {
+            std::vector<unsigned char *> ptrs;
+            for (int round = 0; round < kRounds; round++)
+            {
+                const unsigned char tag = static_cast<unsigned char>(t * kRounds + round);
+                for (std::size_t i = 0; i < kLive; i++)
+                {
+                    unsigned char *ptr = static_cast<unsigned char *>(manager.Allocate(kSize));
+                    if (!ptr)
+                    {
+                        failures[t]++;
+                        continue;
+                    }
+                    std::memset(ptr, tag, kSize);
+                    ptrs.push_back(ptr);
+                }
+
+                // Any block handed to two threads at once would have been overwritten.
+                for (unsigned char *ptr : ptrs)
+                {
+                    for (std::size_t i = 0; i < kSize; i++)
+                    {
+                        if (ptr[i] != tag)
+                        {
+                            failures[t]++;
+                            break;
+                        }
+                    }
+                    manager.Free(ptr, kSize, sizeof(void *));
+                }
+                ptrs.clear();
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int t = 0; t < kThreads; t++)
+    {
+        EXPECT_EQ(failures[t], 0) << "thread " << t;
+    }
+}
+
+TEST(PerCpuSlabManagerTest, CrossThreadSizelessFreeIsAccepted)
+{
+    mcr::SlabManagerConfig config = FixedCapacityConfig(40);
+    config.contiguous_arena = true;
+    mcr::PerCpuSlabManager manager(config);
+
+    std::vector<void *> ptrs;
+    for (std::size_t i = 0; i < config.blocks_per_class; i++)
+    {
+        void *ptr = manager.Allocate(100);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_TRUE(manager.Owns(ptr));
+        ptrs.push_back(ptr);
+    }
+
+    std::thread consumer([&manager, &ptrs]
+                         {
+        for (void *ptr : ptrs)
+        {
+            manager.Free(ptr);
+        } });
+    consumer.join();
+
+    // Cached blocks live with the CPU, not with the exited thread; flushing makes them visible to every shard.
+    manager.FlushCpuCaches();
+    for (std::size_t i = 0; i < config.blocks_per_class; i++)
+    {
+        ASSERT_NE(manager.Allocate(100), nullptr);
+    }
+}
+
+TEST(PerCpuSlabManagerTest, StatsCountCallersAcrossShardsAndSkipCachedBlocks)
+{
+    constexpr std::size_t kBlocksPerClass = 100;
+    mcr::PerCpuSlabManager manager(FixedCapacityConfig(kBlocksPerClass), 4);
+    const std::size_t class_idx = mcr::SizeClassPolicy::ClassIndex(64);
+
+    std::vector<void *> ptrs(8);
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < 2; t++)
+    {
+        threads.emplace_back([&manager, &ptrs, t]
+                             {
+            for (std::size_t i = 0; i < 4; i++)
+            {
+                ptrs[t * 4 + i] = manager.Allocate(64);
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    for (std::size_t i = 0; i < 3; i++)
+    {
+        manager.Free(ptrs[i], 64, sizeof(void *));
+    }
+
+    while (manager.Allocate(1024))
+    {
+    }
+
+    const mcr::SlabManagerStats stats = manager.GetStats();
+    const mcr::SlabStats &cls = stats.classes[class_idx];
+    const mcr::SlabStats &largest = stats.classes[mcr::SizeClassPolicy::kNumClasses - 1];
+    EXPECT_EQ(cls.block_size, 64);
+    EXPECT_EQ(cls.capacity, kBlocksPerClass);
+    if (mcr::kStatsEnabled)
+    {
+        EXPECT_EQ(cls.in_use, 5); // Blocks refilled into CPU caches but never handed out do not count.
+        EXPECT_EQ(cls.total_allocations, 8);
+        EXPECT_GE(cls.peak_in_use, 5);
+        EXPECT_EQ(largest.in_use, kBlocksPerClass);
+        EXPECT_EQ(largest.failed_allocations, 1);
+    }
+    else
+    {
+        EXPECT_EQ(cls.in_use, 0);
+        EXPECT_EQ(cls.total_allocations, 0);
+    }
+}
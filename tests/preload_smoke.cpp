@@ -0,0 +1,340 @@
+// Multithreaded allocation workload run under `LD_PRELOAD=libmcr_malloc.so` by CTest.
+//
+// Usage:
+//   mcr_preload_smoke [--require-preload]
+//
+// Threads mix malloc/calloc/realloc/aligned allocations with operator new and standard containers, and hand
+// half of their blocks to the next thread so they are freed on a different thread than the one that
+// allocated them. Every block is filled with a per-allocation pattern and checked before it is released.
+// Meanwhile the main thread forks repeatedly, and each child must be able to allocate and free on its own.
+// Exits non-zero on a corrupted block, a misaligned result, or (with --require-preload) if the slab
+// allocator is not interposed.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <dlfcn.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace
+{
+    constexpr int kThreads = 4;
+    constexpr int kRounds = 20000;
+    constexpr int kForks = 20;
+
+    /**
+     * @brief Blocks a forked child allocates; far more than one thread cache holds, so it refills from the shared pools.
+     */
+    constexpr std::size_t kChildBlocks = 4096;
+
+    std::atomic<int> g_failures{0};
+
+    void Fail(const char *what)
+    {
+        if (g_failures.fetch_add(1) < 10)
+        {
+            std::fprintf(stderr, "preload smoke: %s\n", what);
+        }
+    }
+
+    struct Block
+    {
+        unsigned char *ptr;
+        std::size_t size;
+        unsigned char pattern;
+    };
+
+    void Fill(const Block &block)
+    {
+        std::memset(block.ptr, block.pattern, block.size);
+    }
+
+    void CheckAndFree(const Block &block)
+    {
+        for (std::size_t i = 0; i < block.size; i++)
+        {
+            if (block.ptr[i] != block.pattern)
+            {
+                Fail("block contents changed while it was allocated");
+                break;
+            }
+        }
+        std::free(block.ptr);
+    }
+
+    /**
+     * @brief Blocks handed from one thread to the next, to be freed there.
+     */
+    struct Mailbox
+    {
+        std::mutex mutex;
+        std::vector<Block> blocks;
+    };
+
+    std::size_t RandomSize(std::mt19937 &rng)
+    {
+        // Mostly small-class requests, with some large ones that the system allocator serves.
+        return (rng() % 8 == 0) ? 2048 + rng() % 8192 : 1 + rng() % 1024;
+    }
+
+    void Worker(int id, std::vector<Mailbox> &mailboxes)
+    {
+        std::mt19937 rng(static_cast<std::uint32_t>(id) * 7919u + 1u);
+        std::vector<Block> live;
+        Mailbox &next = mailboxes[static_cast<std::size_t>((id + 1) % kThreads)];
+        Mailbox &mine = mailboxes[static_cast<std::size_t>(id)];
+
+        for (int round = 0; round < kRounds; round++)
+        {
+            Block block{nullptr, RandomSize(rng), static_cast<unsigned char>(rng())};
+            switch (rng() % 4)
+            {
+            case 0:
+                block.ptr = static_cast<unsigned char *>(std::malloc(block.size));
+                break;
+            case 1:
+                block.ptr = static_cast<unsigned char *>(std::calloc(1, block.size));
+                for (std::size_t i = 0; block.ptr && i < block.size; i++)
+                {
+                    if (block.ptr[i] != 0)
+                    {
+                        Fail("calloc returned non-zero memory");
+                        break;
+                    }
+                }
+                break;
+            case 2:
+            {
+                // Grow through realloc and check that the prefix survives.
+                const std::size_t first = 1 + block.size / 2;
+                auto *ptr = static_cast<unsigned char *>(std::malloc(first));
+                std::memset(ptr, block.pattern, first);
+                block.ptr = static_cast<unsigned char *>(std::realloc(ptr, block.size));
+                for (std::size_t i = 0; block.ptr && i < first; i++)
+                {
+                    if (block.ptr[i] != block.pattern)
+                    {
+                        Fail("realloc lost the block contents");
+                        break;
+                    }
+                }
+                break;
+            }
+            default:
+            {
+                const std::size_t alignment = std::size_t{16} << (rng() % 8);
+                void *ptr = nullptr;
+                if (posix_memalign(&ptr, alignment, block.size) != 0 || reinterpret_cast<std::uintptr_t>(ptr) % alignment != 0)
+                {
+                    Fail("posix_memalign returned a misaligned block");
+                }
+                block.ptr = static_cast<unsigned char *>(ptr);
+                break;
+            }
+            }
+
+            if (!block.ptr)
+            {
+                Fail("allocation failed");
+                continue;
+            }
+            if (reinterpret_cast<std::uintptr_t>(block.ptr) % alignof(std::max_align_t) != 0)
+            {
+                Fail("malloc result is not aligned to max_align_t");
+            }
+            Fill(block);
+            live.push_back(block);
+
+            // C++ allocations in between: strings, node containers and over-aligned objects.
+            if (round % 64 == 0)
+            {
+                std::map<int, std::string> nodes;
+                for (int i = 0; i < 32; i++)
+                {
+                    nodes.emplace(i, std::string(static_cast<std::size_t>(i * 7), 'x'));
+                }
+                struct alignas(256) Wide
+                {
+                    unsigned char bytes[256];
+                };
+                std::unique_ptr<Wide> wide(new Wide());
+                if (reinterpret_cast<std::uintptr_t>(wide.get()) % 256 != 0 || nodes.size() != 32)
+                {
+                    Fail("operator new returned a misaligned object");
+                }
+            }
+
+            if (live.size() >= 64)
+            {
+                // Free half locally, hand the other half to the next thread.
+                std::lock_guard<std::mutex> lock(next.mutex);
+                for (std::size_t i = 0; i < live.size(); i++)
+                {
+                    if (i % 2 == 0)
+                    {
+                        CheckAndFree(live[i]);
+                    }
+                    else
+                    {
+                        next.blocks.push_back(live[i]);
+                    }
+                }
+                live.clear();
+            }
+
+            if (round % 16 == 0)
+            {
+                std::vector<Block> received;
+                {
+                    std::lock_guard<std::mutex> lock(mine.mutex);
+                    received.swap(mine.blocks);
+                }
+                for (const Block &remote : received)
+                {
+                    CheckAndFree(remote);
+                }
+            }
+        }
+
+        for (const Block &remaining : live)
+        {
+            CheckAndFree(remaining);
+        }
+    }
+}
+
+namespace
+{
+    /**
+     * @brief Allocate and free in the child; a lock inherited from another parent thread would hang here.
+     */
+    [[noreturn]] void ChildWorkload()
+    {
+        std::vector<void *> ptrs;
+        ptrs.reserve(kChildBlocks);
+        for (std::size_t i = 0; i < kChildBlocks; i++)
+        {
+            void *ptr = std::malloc(16 + i % 512);
+            if (!ptr)
+            {
+                _exit(2);
+            }
+            std::memset(ptr, 0x5a, 16);
+            ptrs.push_back(ptr);
+        }
+        for (void *ptr : ptrs)
+        {
+            std::free(ptr);
+        }
+        _exit(0);
+    }
+
+    /**
+     * @brief Fork while the workers allocate, and check that every child finishes its workload in time.
+     */
+    void ForkThenAllocate()
+    {
+        for (int i = 0; i < kForks; i++)
+        {
+            const pid_t child = fork();
+            if (child < 0)
+            {
+                Fail("fork failed");
+                return;
+            }
+            if (child == 0)
+            {
+                ChildWorkload();
+            }
+
+            int status = 0;
+            pid_t waited = 0;
+            for (int polls = 0; polls < 1000 && waited == 0; polls++)
+            {
+                waited = waitpid(child, &status, WNOHANG);
+                if (waited == 0)
+                {
+                    usleep(10000);
+                }
+            }
+            if (waited == 0)
+            {
+                kill(child, SIGKILL);
+                waitpid(child, &status, 0);
+                Fail("forked child deadlocked in the allocator");
+            }
+            else if (waited < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            {
+                Fail("forked child failed to allocate");
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const bool require_preload = argc > 1 && std::strcmp(argv[1], "--require-preload") == 0;
+
+    using OwnsFn = int (*)(const void *);
+    const auto owns = reinterpret_cast<OwnsFn>(dlsym(RTLD_DEFAULT, "mcr_malloc_owns"));
+    if (!owns)
+    {
+        std::fprintf(stderr, "preload smoke: mcr_malloc is not preloaded\n");
+        if (require_preload)
+        {
+            return 1;
+        }
+    }
+    else
+    {
+        void *small = std::malloc(64);
+        void *large = std::malloc(std::size_t{1} << 20);
+        if (!owns(small) || owns(large))
+        {
+            Fail("small requests are not served by the slab classes");
+        }
+        std::free(small);
+        std::free(large);
+    }
+
+    std::vector<Mailbox> mailboxes(kThreads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; i++)
+    {
+        threads.emplace_back(Worker, i, std::ref(mailboxes));
+    }
+    ForkThenAllocate();
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    for (Mailbox &mailbox : mailboxes)
+    {
+        for (const Block &block : mailbox.blocks)
+        {
+            CheckAndFree(block);
+        }
+    }
+
+    if (g_failures.load() != 0)
+    {
+        std::fprintf(stderr, "preload smoke: %d failures\n", g_failures.load());
+        return 1;
+    }
+    std::printf("preload smoke: %d threads x %d rounds and %d forks passed\n", kThreads, kRounds, kForks);
+    return 0;
+}
@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+#include "relocatable_slab_manager.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::string TempPath(const char *name)
+    {
+        return testing::TempDir() + name;
+    }
+
+    mcr::RelocatableHeapConfig SmallHeap()
+    {
+        mcr::RelocatableHeapConfig config;
+        config.blocks_per_class = 1024;
+        return config;
+    }
+
+    /**
+     * @brief Node of a singly linked list built inside the heap with raw pointers.
+     */
+    struct Node
+    {
+        Node *next;
+        std::uint64_t value;
+    };
+
+    /**
+     * @brief Node linked by heap offsets, so the list survives relocation.
+     */
+    struct OffsetNode
+    {
+        std::uint64_t next;
+        std::uint64_t value;
+    };
+
+    /**
+     * @brief Build a list holding `values[0..count)` in order and record its head as the root.
+     */
+    std::vector<Node *> BuildList(mcr::RelocatableSlabManager &manager, std::size_t count)
+    {
+        std::vector<Node *> nodes;
+        Node *head = nullptr;
+        for (std::size_t i = count; i-- > 0;)
+        {
+            Node *node = new (manager.Allocate(sizeof(Node))) Node{head, i * 10};
+            nodes.push_back(node);
+            head = node;
+        }
+        manager.SetRoot(head);
+        return nodes;
+    }
+}
+
+// ------------------------------------------------------------
+// Allocation.
+// ------------------------------------------------------------
+
+TEST(RelocatableSlabManagerTest, BlocksAreDistinctAlignedAndAtTheBase)
+{
+    mcr::RelocatableSlabManager manager(SmallHeap());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(manager.Base()), mcr::RelocatableHeapConfig::kDefaultBase);
+
+    std::set<void *> seen;
+    for (std::size_t size : {1, 16, 40, 64, 100, 256, 700, 1024})
+    {
+        for (int i = 0; i < 100; i++)
+        {
+            void *ptr = manager.Allocate(size);
+            ASSERT_NE(ptr, nullptr);
+            const std::size_t class_idx = mcr::SizeClassPolicy::ClassIndex(size);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % mcr::SizeClassPolicy::ClassAlignment(class_idx), 0);
+            EXPECT_TRUE(manager.Owns(ptr));
+            EXPECT_TRUE(seen.insert(ptr).second);
+        }
+    }
+    EXPECT_EQ(manager.Allocate(mcr::SizeClassPolicy::kMaxClassSize + 1), nullptr);
+}
+
+TEST(RelocatableSlabManagerTest, ClassExhaustsAndReusesFreedBlocks)
+{
+    mcr::RelocatableSlabManager manager(SmallHeap());
+    std::vector<void *> ptrs;
+    while (void *ptr = manager.Allocate(64))
+    {
+        ptrs.push_back(ptr);
+    }
+    ASSERT_EQ(ptrs.size(), 1024u);
+
+    manager.Free(ptrs[7], 64, sizeof(void *));
+    manager.Free(ptrs[3]);
+    EXPECT_EQ(manager.Allocate(64), ptrs[3]);
+    EXPECT_EQ(manager.Allocate(64), ptrs[7]);
+    EXPECT_EQ(manager.Allocate(64), nullptr);
+}
+
+TEST(RelocatableSlabManagerTest, SizelessFreeRejectsForeignPointer)
+{
+    mcr::RelocatableSlabManager manager(SmallHeap());
+    int local = 0;
+    EXPECT_FALSE(manager.Owns(&local));
+    EXPECT_FALSE(manager.Owns(manager.Base()));
+    EXPECT_THROW(manager.Free(&local), std::invalid_argument);
+    EXPECT_NO_THROW(manager.Free(nullptr));
+}
+
+TEST(RelocatableSlabManagerTest, InvalidConfigThrows)
+{
+    mcr::RelocatableHeapConfig config = SmallHeap();
+    config.base += 1;
+    EXPECT_THROW(mcr::RelocatableSlabManager{config}, std::invalid_argument);
+
+    config = SmallHeap();
+    config.blocks_per_class = 0;
+    EXPECT_THROW(mcr::RelocatableSlabManager{config}, std::invalid_argument);
+}
+
+TEST(RelocatableSlabManagerTest, OccupiedBaseThrowsBadAlloc)
+{
+    mcr::RelocatableSlabManager manager(SmallHeap());
+    EXPECT_THROW(mcr::RelocatableSlabManager{SmallHeap()}, std::bad_alloc);
+}
+
+// ------------------------------------------------------------
+// Heap images.
+// ------------------------------------------------------------
+
+TEST(RelocatableSlabManagerTest, RestoredHeapKeepsGraphAndContinues)
+{
+    const std::string path = TempPath("mcr_roundtrip.heap");
+    std::set<void *> live;
+    void *freed = nullptr;
+    {
+        mcr::RelocatableSlabManager manager(SmallHeap());
+        for (Node *node : BuildList(manager, 100))
+        {
+            live.insert(node);
+        }
+        freed = manager.Allocate(sizeof(Node));
+        manager.Free(freed, sizeof(Node), sizeof(void *));
+        manager.WriteImage(path);
+    }
+
+    std::unique_ptr<mcr::RelocatableSlabManager> restored = mcr::RelocatableSlabManager::Restore(path);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(restored->Base()), mcr::RelocatableHeapConfig::kDefaultBase);
+
+    std::uint64_t expected = 0;
+    for (const Node *node = static_cast<const Node *>(restored->Root()); node; node = node->next)
+    {
+        EXPECT_EQ(node->value, expected);
+        expected += 10;
+    }
+    EXPECT_EQ(expected, 1000u);
+
+    // The saved free list is served first, then the frontier past every live node.
+    EXPECT_EQ(restored->Allocate(sizeof(Node)), freed);
+    for (int i = 0; i < 50; i++)
+    {
+        void *ptr = restored->Allocate(sizeof(Node));
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(live.count(ptr), 0u);
+    }
+
+    Node *head = static_cast<Node *>(restored->Root());
+    restored->SetRoot(head->next);
+    restored->Free(head);
+    EXPECT_EQ(restored->Allocate(sizeof(Node)), head);
+}
+
+TEST(RelocatableSlabManagerTest, ImageCanBeRewrittenWhileMapped)
+{
+    const std::string path = TempPath("mcr_rewrite.heap");
+    {
+        mcr::RelocatableSlabManager manager(SmallHeap());
+        BuildList(manager, 10);
+        manager.WriteImage(path);
+    }
+
+    std::unique_ptr<mcr::RelocatableSlabManager> restored = mcr::RelocatableSlabManager::Restore(path);
+    static_cast<Node *>(restored->Root())->value = 42;
+    restored->WriteImage(path);
+    restored.reset();
+
+    restored = mcr::RelocatableSlabManager::Restore(path);
+    EXPECT_EQ(static_cast<Node *>(restored->Root())->value, 42u);
+}
+
+TEST(RelocatableSlabManagerTest, TakenBaseNeedsRelocation)
+{
+    const std::string path = TempPath("mcr_relocate.heap");
+    mcr::RelocatableSlabManager manager(SmallHeap());
+    std::uint64_t head = 0;
+    for (std::uint64_t i = 3; i-- > 0;)
+    {
+        void *ptr = manager.Allocate(sizeof(OffsetNode));
+        new (ptr) OffsetNode{head, i};
+        head = manager.ToOffset(ptr);
+    }
+    manager.SetRoot(manager.FromOffset(head));
+    manager.WriteImage(path);
+
+    // `manager` still holds the recorded base.
+    EXPECT_THROW(mcr::RelocatableSlabManager::Restore(path), std::runtime_error);
+
+    std::unique_ptr<mcr::RelocatableSlabManager> restored = mcr::RelocatableSlabManager::Restore(path, true);
+    EXPECT_NE(restored->Base(), manager.Base());
+    std::uint64_t expected = 0;
+    for (const OffsetNode *node = static_cast<const OffsetNode *>(restored->Root()); node;
+         node = node->next ? static_cast<const OffsetNode *>(restored->FromOffset(node->next)) : nullptr)
+    {
+        EXPECT_TRUE(restored->Owns(node));
+        EXPECT_EQ(node->value, expected++);
+    }
+    EXPECT_EQ(expected, 3u);
+    EXPECT_NE(restored->Allocate(sizeof(OffsetNode)), nullptr);
+}
+
+TEST(RelocatableSlabManagerTest, MissingOrInvalidImageThrows)
+{
+    EXPECT_THROW(mcr::RelocatableSlabManager::Restore(TempPath("mcr_missing.heap")), std::runtime_error);
+
+    const std::string path = TempPath("mcr_invalid.heap");
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << "not a heap image";
+    }
+    EXPECT_THROW(mcr::RelocatableSlabManager::Restore(path), std::runtime_error);
+}
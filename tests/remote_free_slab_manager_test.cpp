@@ -0,0 +1,254 @@
+#include <gtest/gtest.h>
+#include "remote_free_slab_manager.h"
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// ------------------------------------------------------------
+// Owner-thread behavior.
+// ------------------------------------------------------------
+
+TEST(RemoteFreeSlabManagerTest, OwnerFreeGoesStraightToManager)
+{
+    mcr::RemoteFreeSlabManager manager;
+    EXPECT_TRUE(manager.IsOwner());
+
+    void *ptr = manager.Allocate(40);
+    ASSERT_NE(ptr, nullptr);
+    manager.Free(ptr, 40, sizeof(void *));
+    EXPECT_EQ(manager.CollectRemoteFrees(), 0);
+
+    // The class free list is LIFO, so the same block comes back.
+    EXPECT_EQ(manager.Allocate(40), ptr);
+    manager.Free(ptr, 40, sizeof(void *));
+    manager.Free(nullptr, 40, sizeof(void *)); // No-op.
+}
+
+TEST(RemoteFreeSlabManagerTest, InvalidRequestsThrowOrReturnNullptr)
+{
+    mcr::RemoteFreeSlabManager manager;
+
+    EXPECT_THROW({ manager.Allocate(0); }, std::invalid_argument);
+    EXPECT_THROW({ manager.Allocate(16, 24); }, std::invalid_argument);
+    EXPECT_EQ(manager.Allocate(2048), nullptr);
+}
+
+// ------------------------------------------------------------
+// Remote frees.
+// ------------------------------------------------------------
+
+TEST(RemoteFreeSlabManagerTest, RemoteFreesReturnOnNextAllocationOfTheirClass)
+{
+    mcr::SlabManagerConfig config;
+    config.blocks_per_class = 16;
+    mcr::RemoteFreeSlabManager manager(config);
+
+    std::vector<void *> ptrs;
+    for (std::size_t i = 0; i < config.blocks_per_class; i++)
+    {
+        void *ptr = manager.Allocate(100);
+        ASSERT_NE(ptr, nullptr);
+        ptrs.push_back(ptr);
+    }
+    ASSERT_EQ(manager.Allocate(100), nullptr);
+
+    std::thread consumer([&manager, &ptrs]
+                         {
+        EXPECT_FALSE(manager.IsOwner());
+        for (void *ptr : ptrs)
+        {
+            manager.Free(ptr, 100, sizeof(void *));
+        } });
+    consumer.join();
+
+    // The next allocation of the class drains the whole stack back into the pool.
+    std::set<void *> again;
+    for (std::size_t i = 0; i < config.blocks_per_class; i++)
+    {
+        void *ptr = manager.Allocate(100);
+        ASSERT_NE(ptr, nullptr);
+        again.insert(ptr);
+    }
+    EXPECT_EQ(again, std::set<void *>(ptrs.begin(), ptrs.end()));
+    EXPECT_EQ(manager.Allocate(100), nullptr);
+}
+
+TEST(RemoteFreeSlabManagerTest, GeometricRemoteFreesReturnToTheirClass)
+{
+    mcr::SlabManagerConfig config;
+    config.blocks_per_class = 8;
+    config.class_spacing = mcr::ClassSpacing::kGeometric;
+    mcr::RemoteFreeSlabManager manager(config);
+
+    // 260 and 300 bytes share the 320-byte class; each must come back to it, not to a power-of-2 neighbour.
+    std::vector<void *> ptrs;
+    for (std::size_t i = 0; i < config.blocks_per_class; i++)
+    {
+        void *ptr = manager.Allocate((i % 2) ? 300 : 260);
+        ASSERT_NE(ptr, nullptr);
+        ptrs.push_back(ptr);
+    }
+    ASSERT_EQ(manager.Allocate(260), nullptr);
+
+    std::thread consumer([&ptrs, &manager]
+                         {
+        for (std::size_t i = 0; i < ptrs.size(); i++)
+        {
+            manager.Free(ptrs[i], (i % 2) ? 300 : 260, sizeof(void *));
+        } });
+    consumer.join();
+
+    std::set<void *> again;
+    for (std::size_t i = 0; i < config.blocks_per_class; i++)
+    {
+        void *ptr = manager.Allocate(300);
+        ASSERT_NE(ptr, nullptr);
+        again.insert(ptr);
+    }
+    EXPECT_EQ(again, std::set<void *>(ptrs.begin(), ptrs.end()));
+    EXPECT_EQ(manager.GetStats().classes.size(), mcr::GeometricClassPolicy::kNumClasses);
+}
+
+TEST(RemoteFreeSlabManagerTest, CollectRemoteFreesDrainsEveryClassAndLargeBlocks)
+{
+    mcr::SlabManagerConfig config;
+    config.large_region_size = std::size_t{1} << 20;
+    mcr::RemoteFreeSlabManager manager(config);
+
+    void *small = manager.Allocate(16);
+    void *medium = manager.Allocate(512, 64);
+    void *large = manager.Allocate(8192);
+    ASSERT_NE(small, nullptr);
+    ASSERT_NE(medium, nullptr);
+    ASSERT_NE(large, nullptr);
+
+    std::thread consumer([&]
+                         {
+        manager.Free(small, 16, sizeof(void *));
+        manager.Free(medium, 512, 64);
+        manager.Free(large, 8192, sizeof(void *)); });
+    consumer.join();
+
+    EXPECT_EQ(manager.GetStats().large.live_allocations, 1);
+    EXPECT_EQ(manager.CollectRemoteFrees(), 3);
+    EXPECT_EQ(manager.GetStats().large.live_allocations, 0);
+    EXPECT_EQ(manager.CollectRemoteFrees(), 0);
+}
+
+TEST(RemoteFreeSlabManagerTest, TakeOwnershipMovesTheOwnerThread)
+{
+    mcr::RemoteFreeSlabManager manager;
+    void *ptr = manager.Allocate(32);
+    ASSERT_NE(ptr, nullptr);
+
+    std::thread producer([&manager, ptr]
+                         {
+        manager.TakeOwnership();
+        EXPECT_TRUE(manager.IsOwner());
+        manager.Free(ptr, 32, sizeof(void *)); // Now a local free.
+        EXPECT_EQ(manager.CollectRemoteFrees(), 0); });
+    producer.join();
+    EXPECT_FALSE(manager.IsOwner());
+}
+
+TEST(RemoteFreeSlabManagerTest, ConcurrentConsumersNeverLoseOrDuplicateBlocks)
+{
+    constexpr int kConsumers = 3;
+    constexpr std::size_t kMessages = 20000;
+    constexpr std::size_t kSize = 48;
+    mcr::SlabManagerConfig config;
+    config.blocks_per_class = 256;
+    mcr::RemoteFreeSlabManager manager(config);
+
+    // Each consumer takes messages from its own mailbox slot; the producer reuses a slot once it is empty again.
+    std::vector<std::atomic<void *>> mailboxes(kConsumers);
+    std::atomic<bool> done{false};
+    std::atomic<int> corrupted{0};
+
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < kConsumers; c++)
+    {
+        consumers.emplace_back([&, c]
+                               {
+            for (;;)
+            {
+                void *message = mailboxes[c].exchange(nullptr, std::memory_order_acquire);
+                if (!message)
+                {
+                    if (done.load(std::memory_order_acquire) && !mailboxes[c].load(std::memory_order_acquire))
+                    {
+                        return;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+                const unsigned char *bytes = static_cast<const unsigned char *>(message);
+                for (std::size_t i = 1; i < kSize; i++)
+                {
+                    if (bytes[i] != bytes[0])
+                    {
+                        corrupted.fetch_add(1);
+                        break;
+                    }
+                }
+                manager.Free(message, kSize, sizeof(void *));
+            } });
+    }
+
+    for (std::size_t m = 0; m < kMessages; m++)
+    {
+        void *message = manager.Allocate(kSize);
+        while (!message)
+        {
+            std::this_thread::yield();
+            message = manager.Allocate(kSize);
+        }
+        std::memset(message, static_cast<int>(m & 0xff), kSize);
+
+        std::atomic<void *> &slot = mailboxes[m % kConsumers];
+        void *empty = nullptr;
+        while (!slot.compare_exchange_weak(empty, message, std::memory_order_release, std::memory_order_relaxed))
+        {
+            empty = nullptr;
+            std::this_thread::yield();
+        }
+    }
+    done.store(true, std::memory_order_release);
+    for (std::thread &consumer : consumers)
+    {
+        consumer.join();
+    }
+    EXPECT_EQ(corrupted.load(), 0);
+
+    // Every block came back: the full class is allocatable again.
+    manager.CollectRemoteFrees();
+    std::set<void *> blocks;
+    for (std::size_t i = 0; i < config.blocks_per_class; i++)
+    {
+        void *ptr = manager.Allocate(kSize);
+        ASSERT_NE(ptr, nullptr);
+        blocks.insert(ptr);
+    }
+    EXPECT_EQ(blocks.size(), config.blocks_per_class);
+    EXPECT_EQ(manager.Allocate(kSize), nullptr);
+}
+
+TEST(RemoteFreeSlabManagerTest, OverAlignedRemoteFreesReturnToTheirTier)
+{
+    mcr::SlabManagerConfig config;
+    config.over_aligned_blocks_per_class = 64;
+    mcr::RemoteFreeSlabManager manager(config);
+
+    void *ptr = manager.Allocate(64, 1024);
+    ASSERT_NE(ptr, nullptr);
+    std::thread consumer([&manager, ptr]
+                         { manager.Free(ptr, 64, 1024); });
+    consumer.join();
+
+    // The next over-aligned allocation drains the sizeless queue and gets the block back.
+    EXPECT_EQ(manager.Allocate(64, 1024), ptr);
+}
@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "scavenger.h"
+#include "thread_cached_slab_manager.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Poll until `done()` holds or a generous deadline passes; keeps the tests robust on loaded machines.
+    template <typename Predicate>
+    bool WaitFor(Predicate done)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!done())
+        {
+            if (std::chrono::steady_clock::now() > deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+}
+
+// ------------------------------------------------------------
+// Background passes.
+// ------------------------------------------------------------
+
+TEST(ScavengerTest, BackgroundPassReleasesIdleManagerPages)
+{
+    mcr::SlabManagerConfig config;
+    config.blocks_per_class = 1024;
+    config.backing = mcr::PoolBacking::kMmap;
+    mcr::ThreadCachedSlabManager manager(config);
+
+    // Simulate a burst that touches the whole 64-byte class, then goes idle.
+    std::vector<void *> ptrs;
+    for (std::size_t i = 0; i < config.blocks_per_class; i++)
+    {
+        void *ptr = manager.Allocate(64);
+        ASSERT_NE(ptr, nullptr);
+        ptrs.push_back(ptr);
+    }
+    for (void *ptr : ptrs)
+    {
+        manager.Free(ptr, 64, sizeof(void *));
+    }
+    manager.FlushThreadCache();
+
+    mcr::Scavenger scavenger([&manager]
+                             { return manager.Scavenge(); },
+                             std::chrono::milliseconds(1));
+    ASSERT_TRUE(WaitFor([&scavenger]
+                        { return scavenger.ReleasedBytes() > 0; }));
+
+    // Released pages are handed out again transparently.
+    for (std::size_t i = 0; i < config.blocks_per_class; i++)
+    {
+        ptrs[i] = manager.Allocate(64);
+        ASSERT_NE(ptrs[i], nullptr);
+        *static_cast<std::size_t *>(ptrs[i]) = i;
+    }
+    for (void *ptr : ptrs)
+    {
+        manager.Free(ptr, 64, sizeof(void *));
+    }
+}
+
+TEST(ScavengerTest, DestructionStopsWaitingThread)
+{
+    std::atomic<int> passes{0};
+    const auto start = std::chrono::steady_clock::now();
+    {
+        mcr::Scavenger scavenger([&passes]
+                                 { passes++; return std::size_t{0}; },
+                                 std::chrono::hours(1));
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+    EXPECT_EQ(passes.load(), 0);
+}
+
+// ------------------------------------------------------------
+// Invalid input.
+// ------------------------------------------------------------
+
+TEST(ScavengerTest, InvalidArgumentsThrow)
+{
+    EXPECT_THROW({ mcr::Scavenger scavenger(nullptr, std::chrono::milliseconds(1)); }, std::invalid_argument);
+    EXPECT_THROW({ mcr::Scavenger scavenger([]
+                                            { return std::size_t{0}; },
+                                            std::chrono::milliseconds(0)); },
+                 std::invalid_argument);
+}
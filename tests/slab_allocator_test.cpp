@@ -1,11 +1,16 @@
 #include <gtest/gtest.h>
 #include "slab_allocator.h"
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 #include <cstdint>
 #include <stdexcept>
 #include <limits>
 
+#if defined(__linux__)
+#include <sys/mman.h> // for mincore, mmap and mlock
+#endif
+
 // Test object used for block-size and alignment-related allocator tests.
 struct TestObj
 {
@@ -229,6 +234,25 @@ TEST(SlabAllocatorTest, FreeReusesMostRecentlyFreedBlock)
     EXPECT_EQ(ptr_new, ptr2); // Due to LIFO feature, it should reuse ptr2.
 }
 
+TEST(SlabAllocatorTest, RecycledBlocksArePreferredOverNeverUsedBlocks)
+{
+    const std::size_t block_size = EffectiveBlockSize(sizeof(TestObj));
+    const int block_count = 4;
+    mcr::SlabAllocator allocator(sizeof(TestObj), block_size * block_count);
+
+    void *ptr1 = allocator.Allocate();
+    void *ptr2 = allocator.Allocate();
+    ASSERT_NE(ptr1, nullptr);
+    ASSERT_NE(ptr2, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr2) - reinterpret_cast<std::uintptr_t>(ptr1), block_size); // Frontier hands out blocks in address order.
+
+    allocator.Free(ptr1);
+    EXPECT_EQ(allocator.Allocate(), ptr1); // The recycled block comes before the untouched rest of the pool.
+
+    void *ptr3 = allocator.Allocate();
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr3), reinterpret_cast<std::uintptr_t>(ptr1) + 2 * block_size);
+}
+
 // ------------------------------------------------------------
 // Alignment and block-sizing behavior.
 // ------------------------------------------------------------
@@ -304,6 +328,280 @@ TEST(SlabAllocatorTest, BlockSizeRoundsUpToEffectiveAlignment)
     EXPECT_EQ(allocator.Allocate(), nullptr);
 }
 
+// ------------------------------------------------------------
+// Growth behavior.
+// ------------------------------------------------------------
+
+TEST(SlabAllocatorTest, LinearGrowthChainsSlabsUpToMaxPoolSize)
+{
+    const std::size_t block_size = EffectiveBlockSize(sizeof(TestObj));
+    const int initial_blocks = 4;
+    const int max_blocks = 10; // Not a multiple of the initial slab, so the last slab is trimmed.
+
+    mcr::SlabGrowthPolicy growth;
+    growth.growth = mcr::SlabGrowth::kLinear;
+    growth.max_pool_size = block_size * max_blocks;
+    mcr::SlabAllocator allocator(sizeof(TestObj), block_size * initial_blocks, sizeof(void *), growth);
+
+    std::vector<void *> ptrs;
+    for (int i = 0; i < max_blocks; i++)
+    {
+        void *ptr = allocator.Allocate();
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % sizeof(void *), 0);
+        ptrs.push_back(ptr);
+    }
+
+    EXPECT_EQ(allocator.Allocate(), nullptr); // The upper bound is reached.
+
+    // Blocks of grown slabs are freed through the same free list.
+    for (void *ptr : ptrs)
+    {
+        allocator.Free(ptr);
+    }
+    for (int i = 0; i < max_blocks; i++)
+    {
+        ASSERT_NE(allocator.Allocate(), nullptr);
+    }
+    EXPECT_EQ(allocator.Allocate(), nullptr);
+}
+
+TEST(SlabAllocatorTest, GeometricGrowthPreservesAlignment)
+{
+    const std::size_t alignment = 64;
+    const std::size_t block_size = EffectiveBlockSize(sizeof(TestObj), alignment);
+    const int initial_blocks = 2;
+    const int max_blocks = initial_blocks + 4 + 8; // Two doublings.
+
+    mcr::SlabGrowthPolicy growth;
+    growth.growth = mcr::SlabGrowth::kGeometric;
+    growth.max_pool_size = block_size * max_blocks;
+    mcr::SlabAllocator allocator(sizeof(TestObj), block_size * initial_blocks, alignment, growth);
+
+    for (int i = 0; i < max_blocks; i++)
+    {
+        void *ptr = allocator.Allocate();
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignment, 0);
+    }
+    EXPECT_EQ(allocator.Allocate(), nullptr);
+}
+
+TEST(SlabAllocatorTest, GrowthBoundBelowInitialPoolKeepsInitialCapacity)
+{
+    const std::size_t block_size = EffectiveBlockSize(sizeof(TestObj));
+    const int initial_blocks = 3;
+
+    mcr::SlabGrowthPolicy growth;
+    growth.growth = mcr::SlabGrowth::kLinear;
+    growth.max_pool_size = block_size; // Below the initial pool.
+    mcr::SlabAllocator allocator(sizeof(TestObj), block_size * initial_blocks, sizeof(void *), growth);
+
+    for (int i = 0; i < initial_blocks; i++)
+    {
+        ASSERT_NE(allocator.Allocate(), nullptr);
+    }
+    EXPECT_EQ(allocator.Allocate(), nullptr);
+}
+
+// ------------------------------------------------------------
+// Batch allocation and deallocation.
+// ------------------------------------------------------------
+
+TEST(SlabAllocatorTest, AllocateBatchReturnsDistinctBlocksUpToCapacity)
+{
+    const std::size_t block_size = EffectiveBlockSize(sizeof(TestObj));
+    const std::size_t total_blocks = 10;
+    mcr::SlabAllocator allocator(sizeof(TestObj), block_size * total_blocks);
+
+    std::vector<void *> ptrs(total_blocks + 5, nullptr);
+    EXPECT_EQ(allocator.AllocateBatch(4, ptrs.data()), 4u);
+    EXPECT_EQ(allocator.AllocateBatch(ptrs.size() - 4, ptrs.data() + 4), total_blocks - 4); // Stops at exhaustion.
+    EXPECT_EQ(allocator.Allocate(), nullptr);
+
+    std::vector<std::uintptr_t> addresses;
+    for (std::size_t i = 0; i < total_blocks; i++)
+    {
+        addresses.push_back(reinterpret_cast<std::uintptr_t>(ptrs[i]));
+    }
+    std::sort(addresses.begin(), addresses.end());
+    EXPECT_EQ(std::adjacent_find(addresses.begin(), addresses.end()), addresses.end());
+    EXPECT_EQ(addresses.back() - addresses.front(), block_size * (total_blocks - 1));
+}
+
+TEST(SlabAllocatorTest, FreeBatchRestoresCapacityAndSkipsNullptr)
+{
+    const std::size_t block_size = EffectiveBlockSize(sizeof(TestObj));
+    const std::size_t total_blocks = 6;
+    mcr::SlabAllocator allocator(sizeof(TestObj), block_size * total_blocks);
+
+    std::vector<void *> ptrs(total_blocks);
+    ASSERT_EQ(allocator.AllocateBatch(total_blocks, ptrs.data()), total_blocks);
+    ptrs.insert(ptrs.begin() + 2, nullptr);
+    allocator.FreeBatch(ptrs.data(), ptrs.size());
+
+    // The first entry of the batch is handed out next, then the rest in batch order.
+    EXPECT_EQ(allocator.Allocate(), ptrs[0]);
+    EXPECT_EQ(allocator.Allocate(), ptrs[1]);
+    EXPECT_EQ(allocator.Allocate(), ptrs[3]);
+
+    std::vector<void *> rest(total_blocks);
+    EXPECT_EQ(allocator.AllocateBatch(rest.size(), rest.data()), total_blocks - 3);
+}
+
+TEST(SlabAllocatorTest, AllocateBatchGrowsAcrossSlabs)
+{
+    const std::size_t block_size = EffectiveBlockSize(sizeof(TestObj));
+    const std::size_t initial_blocks = 3;
+    const std::size_t max_blocks = 10;
+
+    mcr::SlabGrowthPolicy growth;
+    growth.growth = mcr::SlabGrowth::kLinear;
+    growth.max_pool_size = block_size * max_blocks;
+    mcr::SlabAllocator allocator(sizeof(TestObj), block_size * initial_blocks, sizeof(void *), growth);
+
+    std::vector<void *> ptrs(max_blocks + 1);
+    EXPECT_EQ(allocator.AllocateBatch(ptrs.size(), ptrs.data()), max_blocks);
+    allocator.FreeBatch(ptrs.data(), max_blocks);
+    EXPECT_EQ(allocator.AllocateBatch(ptrs.size(), ptrs.data()), max_blocks);
+}
+
+// ------------------------------------------------------------
+// Backing stores.
+// ------------------------------------------------------------
+
+TEST(SlabAllocatorTest, EveryBackingServesAlignedBlocksAcrossGrownSlabs)
+{
+    const std::size_t alignment = 64;
+    const std::size_t block_size = EffectiveBlockSize(sizeof(TestObj), alignment);
+    const std::size_t initial_blocks = 64;
+    const std::size_t max_blocks = 3 * initial_blocks;
+
+    const mcr::PoolBacking backings[] = {mcr::PoolBacking::kHeap, mcr::PoolBacking::kMmap, mcr::PoolBacking::kTransparentHugePages, mcr::PoolBacking::kExplicitHugePages};
+    for (mcr::PoolBacking backing : backings)
+    {
+        SCOPED_TRACE(testing::Message() << "backing = " << static_cast<int>(backing));
+
+        mcr::SlabGrowthPolicy growth;
+        growth.growth = mcr::SlabGrowth::kLinear;
+        growth.max_pool_size = block_size * max_blocks;
+        mcr::SlabAllocator allocator(sizeof(TestObj), block_size * initial_blocks, alignment, growth, backing);
+
+        // Unavailable backings fall back towards the heap, never to a "stronger" one.
+        EXPECT_LE(static_cast<int>(allocator.Backing()), static_cast<int>(backing));
+
+        std::vector<void *> ptrs(max_blocks);
+        ASSERT_EQ(allocator.AllocateBatch(max_blocks, ptrs.data()), max_blocks);
+        for (void *ptr : ptrs)
+        {
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignment, 0);
+            static_cast<TestObj *>(ptr)->id = 1; // Mapped pages must be writable.
+        }
+        allocator.FreeBatch(ptrs.data(), max_blocks);
+    }
+}
+
+// ------------------------------------------------------------
+// Scavenging.
+// ------------------------------------------------------------
+
+TEST(SlabAllocatorTest, ScavengeReleasesOnlyFullyFreePagesAndReusesThem)
+{
+    const std::size_t page_size = mcr::SystemPageSize();
+    const std::size_t block_size = 64;
+    const std::size_t blocks_per_page = page_size / block_size;
+    const std::size_t total_blocks = 16 * blocks_per_page;
+    mcr::SlabAllocator allocator(block_size, block_size * total_blocks, block_size, mcr::SlabGrowthPolicy{}, mcr::PoolBacking::kMmap);
+
+    std::vector<void *> ptrs(total_blocks);
+    ASSERT_EQ(allocator.AllocateBatch(total_blocks, ptrs.data()), total_blocks);
+    for (void *ptr : ptrs)
+    {
+        static_cast<TestObj *>(ptr)->id = 7; // Commit every page.
+    }
+
+    // Pages 0 and 2 become fully free; page 1 keeps one live block.
+    allocator.FreeBatch(ptrs.data(), 2 * blocks_per_page - 1);
+    allocator.FreeBatch(ptrs.data() + 2 * blocks_per_page, blocks_per_page);
+    const std::size_t free_blocks = 3 * blocks_per_page - 1;
+
+    EXPECT_EQ(allocator.Scavenge(), 2 * page_size);
+    EXPECT_EQ(allocator.ReleasedBytes(), 2 * page_size);
+    EXPECT_EQ(allocator.Scavenge(), 0u); // Released pages are no longer on the free list.
+
+#if defined(__linux__)
+    unsigned char residency[3] = {};
+    ASSERT_EQ(mincore(ptrs[0], 3 * page_size, residency), 0);
+    EXPECT_EQ(residency[0] & 1, 0);
+    EXPECT_EQ(residency[1] & 1, 1);
+    EXPECT_EQ(residency[2] & 1, 0);
+#endif
+
+    // Every free block is handed out again, including the released pages, which re-fault on touch.
+    std::vector<void *> reused(free_blocks + 1);
+    EXPECT_EQ(allocator.AllocateBatch(reused.size(), reused.data()), free_blocks);
+    for (std::size_t i = 0; i < free_blocks; i++)
+    {
+        EXPECT_LT(reinterpret_cast<std::uintptr_t>(reused[i]) - reinterpret_cast<std::uintptr_t>(ptrs[0]), 3 * page_size);
+        static_cast<TestObj *>(reused[i])->id = 8;
+    }
+    EXPECT_EQ(allocator.ReleasedBytes(), 0u);
+}
+
+#if defined(__linux__)
+TEST(SlabAllocatorTest, ScavengeCountsOnlyUnitsTheOsReleased)
+{
+    // Locked pages reject MADV_DONTNEED, so the units stay committed and must not count as released.
+    const std::size_t page_size = mcr::SystemPageSize();
+    const std::size_t pool_size = 4 * page_size;
+    void *pool = mmap(nullptr, pool_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(pool, MAP_FAILED);
+    if (mlock(pool, pool_size) != 0)
+    {
+        munmap(pool, pool_size);
+        GTEST_SKIP() << "mlock is not permitted here.";
+    }
+
+    {
+        const std::size_t block_size = 64;
+        const std::size_t total_blocks = pool_size / block_size;
+        mcr::SlabAllocator allocator(block_size, pool, pool_size, block_size);
+        std::vector<void *> ptrs(total_blocks);
+        ASSERT_EQ(allocator.AllocateBatch(total_blocks, ptrs.data()), total_blocks);
+        allocator.FreeBatch(ptrs.data(), total_blocks);
+
+        EXPECT_EQ(allocator.Scavenge(), 0u);
+        EXPECT_EQ(allocator.ReleasedBytes(), 0u);
+
+        // The retained units are still handed out again.
+        EXPECT_EQ(allocator.AllocateBatch(total_blocks, ptrs.data()), total_blocks);
+        EXPECT_EQ(allocator.Allocate(), nullptr);
+    }
+    munlock(pool, pool_size);
+    munmap(pool, pool_size);
+}
+#endif
+
+TEST(SlabAllocatorTest, ScavengeHandlesBlocksStraddlingPages)
+{
+    // 24-byte blocks straddle page boundaries; units span lcm(24, page) bytes.
+    const std::size_t page_size = mcr::SystemPageSize();
+    const std::size_t block_size = 24;
+    const std::size_t unit_blocks = 3 * page_size / block_size;
+    const std::size_t total_blocks = 4 * unit_blocks;
+    mcr::SlabAllocator allocator(block_size, block_size * total_blocks, sizeof(void *), mcr::SlabGrowthPolicy{}, mcr::PoolBacking::kMmap);
+
+    std::vector<void *> ptrs(total_blocks);
+    ASSERT_EQ(allocator.AllocateBatch(total_blocks, ptrs.data()), total_blocks);
+    EXPECT_EQ(allocator.Scavenge(), 0u);
+
+    allocator.FreeBatch(ptrs.data(), total_blocks);
+    EXPECT_EQ(allocator.Scavenge(), 4 * 3 * page_size);
+
+    EXPECT_EQ(allocator.AllocateBatch(total_blocks, ptrs.data()), total_blocks);
+    EXPECT_EQ(allocator.Allocate(), nullptr);
+}
+
 // ------------------------------------------------------------
 // Constructor failure paths.
 // ------------------------------------------------------------
@@ -4,6 +4,7 @@
 #include <array>
 #include <cstdint>
 #include <stdexcept>
+#include <vector>
 
 // ------------------------------------------------------------
 // Allocation and routing success path.
@@ -91,6 +92,130 @@ TEST(SlabManagerTest, RequestExhaustsOnlyRoutedSizeClass)
     }
 }
 
+TEST(SlabManagerTest, GeometricSpacingRoutesToTighterClassesSymmetrically)
+{
+    mcr::SlabManagerConfig config;
+    config.blocks_per_class = 4;
+    config.class_spacing = mcr::ClassSpacing::kGeometric;
+    mcr::SlabManager manager(config);
+    ASSERT_EQ(manager.ClassCount(), mcr::GeometricClassPolicy::kNumClasses);
+
+    // 260 and 300 bytes share the 320-byte class; 400 bytes takes the 448-byte one.
+    const std::size_t class_idx = manager.ClassIndex(260, sizeof(void *));
+    EXPECT_EQ(manager.ClassSize(class_idx), 320);
+    EXPECT_EQ(manager.ClassIndex(300, sizeof(void *)), class_idx);
+    EXPECT_EQ(manager.ClassSize(manager.ClassIndex(400, sizeof(void *))), 448);
+    EXPECT_EQ(manager.ClassSize(manager.ClassIndex(65, 64)), 128); // Rounded up to an aligned class.
+
+    std::vector<void *> ptrs;
+    for (std::size_t i = 0; i < config.blocks_per_class; i++)
+    {
+        void *ptr = manager.Allocate(260);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64, 0);
+        ptrs.push_back(ptr);
+    }
+    EXPECT_EQ(manager.Allocate(300), nullptr);
+    void *other = manager.Allocate(400);
+    ASSERT_NE(other, nullptr);
+
+    // Within the class the block is kept; past it the data moves to the next class.
+    EXPECT_EQ(manager.Reallocate(ptrs[0], 260, 320), ptrs[0]);
+    void *moved = manager.Reallocate(ptrs[0], 320, 321);
+    ASSERT_NE(moved, nullptr);
+    EXPECT_NE(moved, ptrs[0]);
+    EXPECT_EQ(manager.Allocate(300), ptrs[0]);
+
+    const mcr::SlabManagerStats stats = manager.GetStats();
+    ASSERT_EQ(stats.classes.size(), mcr::GeometricClassPolicy::kNumClasses);
+    EXPECT_EQ(stats.classes[class_idx].block_size, 320);
+    EXPECT_EQ(stats.classes[class_idx].capacity, config.blocks_per_class);
+
+    manager.Free(moved, 321, sizeof(void *));
+    manager.Free(other, 400, sizeof(void *));
+    for (void *ptr : ptrs)
+    {
+        manager.Free(ptr, 260, sizeof(void *));
+    }
+}
+
+TEST(SlabManagerTest, GrowableClassAllocatesPastInitialBlocksUpToBound)
+{
+    mcr::SlabManagerConfig config;
+    config.blocks_per_class = 10;
+    config.growth = mcr::SlabGrowth::kGeometric;
+    config.max_blocks_per_class = 250;
+    mcr::SlabManager manager(config);
+
+    std::vector<void *> ptrs;
+    for (std::size_t i = 0; i < config.max_blocks_per_class; i++)
+    {
+        void *ptr = manager.Allocate(40);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64, 0); // Grown slabs keep the class alignment.
+        ptrs.push_back(ptr);
+    }
+    EXPECT_EQ(manager.Allocate(40), nullptr);
+
+    // Other size classes have not grown and still start from their initial blocks.
+    void *small_ptr = manager.Allocate(16);
+    ASSERT_NE(small_ptr, nullptr);
+    manager.Free(small_ptr, 16, sizeof(void *));
+
+    for (void *ptr : ptrs)
+    {
+        manager.Free(ptr, 40, sizeof(void *));
+    }
+    EXPECT_NE(manager.Allocate(40), nullptr);
+}
+
+TEST(SlabManagerTest, LargeObjectRegionServesRequestsAboveMaxClassSize)
+{
+    mcr::SlabManagerConfig config;
+    config.large_region_size = 1 << 20;
+    config.max_large_block_size = 1 << 18;
+    mcr::SlabManager manager(config);
+
+    // 1025 bytes is the first request past the slab classes; it takes a 2 KiB buddy block.
+    void *small_large = manager.Allocate(1025);
+    void *aligned_large = manager.Allocate(3000, 4096);
+    ASSERT_NE(small_large, nullptr);
+    ASSERT_NE(aligned_large, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned_large) % 4096, 0);
+    EXPECT_EQ(manager.GetLargeObjectStats().bytes_in_use, 2048 + 4096);
+
+    // Requests above `max_large_block_size` still exceed every tier.
+    EXPECT_EQ(manager.Allocate((1 << 18) + 1), nullptr);
+
+    manager.Free(small_large, 1025, sizeof(void *));
+    manager.Free(aligned_large, 3000, 4096);
+    EXPECT_EQ(manager.GetLargeObjectStats().bytes_in_use, 0);
+    EXPECT_EQ(manager.GetLargeObjectStats().total_allocations, 2);
+}
+
+TEST(SlabManagerTest, InvalidConfigThrowsInvalidArgument)
+{
+    mcr::SlabManagerConfig zero_blocks;
+    zero_blocks.blocks_per_class = 0;
+    EXPECT_THROW({ mcr::SlabManager manager(zero_blocks); }, std::invalid_argument);
+
+    mcr::SlabManagerConfig bound_below_initial;
+    bound_below_initial.blocks_per_class = 10;
+    bound_below_initial.growth = mcr::SlabGrowth::kLinear;
+    bound_below_initial.max_blocks_per_class = 5;
+    EXPECT_THROW({ mcr::SlabManager manager(bound_below_initial); }, std::invalid_argument);
+
+    mcr::SlabManagerConfig large_block_within_classes;
+    large_block_within_classes.large_region_size = 1 << 20;
+    large_block_within_classes.max_large_block_size = 1024;
+    EXPECT_THROW({ mcr::SlabManager manager(large_block_within_classes); }, std::invalid_argument);
+
+    mcr::SlabManagerConfig geometric_over_aligned;
+    geometric_over_aligned.class_spacing = mcr::ClassSpacing::kGeometric;
+    geometric_over_aligned.over_aligned_blocks_per_class = 4;
+    EXPECT_THROW({ mcr::SlabManager manager(geometric_over_aligned); }, std::invalid_argument);
+}
+
 // ------------------------------------------------------------
 // Deallocation and reuse behavior.
 // ------------------------------------------------------------
@@ -126,6 +251,34 @@ TEST(SlabManagerTest, OverAlignedFreeRoutingIsSymmetric)
     EXPECT_EQ(addr3 % 64, 0);
 }
 
+TEST(SlabManagerTest, BatchRoutesOnceAndMatchesSingleCalls)
+{
+    mcr::SlabManagerConfig config;
+    config.blocks_per_class = 8;
+    config.large_region_size = 1 << 16;
+    config.max_large_block_size = 1 << 12;
+    mcr::SlabManager manager(config);
+
+    std::array<void *, 10> ptrs{};
+    EXPECT_EQ(manager.AllocateBatch(ptrs.size(), ptrs.data(), 40, 64), config.blocks_per_class);
+    EXPECT_EQ(manager.Allocate(40, 64), nullptr);
+    for (std::size_t i = 0; i < config.blocks_per_class; i++)
+    {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptrs[i]) % 64, 0);
+    }
+    manager.FreeBatch(ptrs.data(), config.blocks_per_class, 40, 64);
+    EXPECT_EQ(manager.Allocate(64), ptrs[0]); // Same class, so the batch is reused.
+    manager.Free(ptrs[0], 64, sizeof(void *));
+
+    // Large requests go through the buddy region one block at a time.
+    EXPECT_EQ(manager.AllocateBatch(4, ptrs.data(), 3000), 4u);
+    EXPECT_EQ(manager.GetLargeObjectStats().live_allocations, 4u);
+    manager.FreeBatch(ptrs.data(), 4, 3000, sizeof(void *));
+    EXPECT_EQ(manager.GetLargeObjectStats().live_allocations, 0u);
+
+    EXPECT_EQ(manager.AllocateBatch(4, ptrs.data(), 1 << 13), 0u);
+}
+
 TEST(SlabManagerTest, DefaultAlignedDeallocationReuseProxy)
 {
     mcr::SlabManager manager;
@@ -145,6 +298,206 @@ TEST(SlabManagerTest, DefaultAlignedDeallocationReuseProxy)
     EXPECT_EQ(ptr1, ptr2);
 }
 
+TEST(SlabManagerTest, ReallocateKeepsPointerWithinClassAndMovesAcrossClasses)
+{
+    mcr::SlabManagerConfig config;
+    config.large_region_size = 1 << 20;
+    mcr::SlabManager manager(config);
+
+    // 40 and 64 bytes both route to the 64-byte class.
+    char *ptr = static_cast<char *>(manager.Allocate(40));
+    ASSERT_NE(ptr, nullptr);
+    for (int i = 0; i < 40; i++)
+    {
+        ptr[i] = static_cast<char>(i);
+    }
+    EXPECT_EQ(manager.Reallocate(ptr, 40, 64), ptr);
+    EXPECT_EQ(manager.Reallocate(ptr, 64, 33), ptr);
+
+    // 200 bytes needs the 256-byte class; the contents move with the block.
+    char *moved = static_cast<char *>(manager.Reallocate(ptr, 33, 200));
+    ASSERT_NE(moved, nullptr);
+    EXPECT_NE(moved, ptr);
+    for (int i = 0; i < 33; i++)
+    {
+        EXPECT_EQ(moved[i], static_cast<char>(i));
+    }
+    EXPECT_EQ(manager.Allocate(40), ptr); // The old block went back to its class.
+    manager.Free(ptr, 40, sizeof(void *));
+
+    // Into the large-object region, then growing there in place while the buddy is free.
+    char *large = static_cast<char *>(manager.Reallocate(moved, 200, 3000));
+    ASSERT_NE(large, nullptr);
+    EXPECT_EQ(large[32], static_cast<char>(32));
+    EXPECT_EQ(manager.Reallocate(large, 3000, 8000), large);
+    EXPECT_EQ(manager.GetLargeObjectStats().bytes_in_use, 8192);
+
+    // And back down into a size class.
+    void *small = manager.Reallocate(large, 8000, 16);
+    ASSERT_NE(small, nullptr);
+    EXPECT_EQ(static_cast<char *>(small)[15], static_cast<char>(15));
+    EXPECT_EQ(manager.GetLargeObjectStats().bytes_in_use, 0);
+    manager.Free(small, 16, sizeof(void *));
+}
+
+TEST(SlabManagerTest, ReallocateFailureKeepsTheOldBlock)
+{
+    mcr::SlabManagerConfig config;
+    config.blocks_per_class = 1;
+    mcr::SlabManager manager(config);
+
+    void *ptr = manager.Reallocate(nullptr, 0, 100); // Behaves like Allocate().
+    void *blocker = manager.Allocate(500);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_NE(blocker, nullptr);
+
+    // The 512-byte class is exhausted, and there is no large-object region.
+    EXPECT_EQ(manager.Reallocate(ptr, 100, 400), nullptr);
+    EXPECT_EQ(manager.Reallocate(ptr, 100, 4096), nullptr);
+    EXPECT_THROW({ manager.Reallocate(ptr, 100, 0); }, std::invalid_argument);
+
+    manager.Free(ptr, 100, sizeof(void *));
+    manager.Free(blocker, 500, sizeof(void *));
+}
+
+TEST(SlabManagerTest, ArenaFreeRoutesByAddressAlone)
+{
+    mcr::SlabManagerConfig config;
+    config.blocks_per_class = 4;
+    config.contiguous_arena = true;
+    config.large_region_size = 1 << 16;
+    config.max_large_block_size = 1 << 12;
+    mcr::SlabManager manager(config);
+
+    constexpr std::array<std::size_t, 7> kClasses{16, 32, 64, 128, 256, 512, 1024};
+    std::vector<void *> ptrs;
+    for (std::size_t cls : kClasses)
+    {
+        for (std::size_t i = 0; i < config.blocks_per_class; i++)
+        {
+            void *ptr = manager.Allocate(cls, cls);
+            ASSERT_NE(ptr, nullptr);
+            EXPECT_TRUE(manager.Owns(ptr));
+            ptrs.push_back(ptr);
+        }
+        EXPECT_EQ(manager.Allocate(cls, cls), nullptr);
+    }
+    void *large = manager.Allocate(3000);
+    ASSERT_NE(large, nullptr);
+    EXPECT_TRUE(manager.Owns(large));
+
+    // Size-less frees return every block to its own class; nothing leaks into a neighbour.
+    for (void *ptr : ptrs)
+    {
+        manager.Free(ptr);
+    }
+    manager.Free(large);
+    manager.Free(nullptr);
+    EXPECT_EQ(manager.GetLargeObjectStats().live_allocations, 0u);
+
+    for (std::size_t cls : kClasses)
+    {
+        for (std::size_t i = 0; i < config.blocks_per_class; i++)
+        {
+            ASSERT_NE(manager.Allocate(cls, cls), nullptr);
+        }
+        EXPECT_EQ(manager.Allocate(cls, cls), nullptr);
+    }
+}
+
+TEST(SlabManagerTest, ArenaCapacityFollowsGrowthBound)
+{
+    mcr::SlabManagerConfig config;
+    config.blocks_per_class = 2;
+    config.growth = mcr::SlabGrowth::kLinear;
+    config.max_blocks_per_class = 50;
+    config.contiguous_arena = true;
+    mcr::SlabManager manager(config);
+
+    for (std::size_t i = 0; i < config.max_blocks_per_class; i++)
+    {
+        void *ptr = manager.Allocate(40);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64, 0);
+    }
+    EXPECT_EQ(manager.Allocate(40), nullptr);
+}
+
+TEST(SlabManagerTest, OverAlignedRequestsTakeBlocksOfTheirOwnSizeClass)
+{
+    mcr::SlabManagerConfig config;
+    config.over_aligned_blocks_per_class = 256;
+    mcr::SlabManager manager(config);
+
+    EXPECT_TRUE(mcr::SlabManager::IsOverAligned(64, 512));
+    EXPECT_TRUE(mcr::SlabManager::IsOverAligned(512, 4096));
+    EXPECT_FALSE(mcr::SlabManager::IsOverAligned(40, 64)); // The 64-byte class is already 64-aligned.
+    EXPECT_FALSE(mcr::SlabManager::IsOverAligned(64, 8192));
+
+    // Page-aligned I/O buffers no longer exceed the largest class.
+    std::vector<void *> pages;
+    for (int i = 0; i < 4; i++)
+    {
+        void *page = manager.Allocate(512, 4096);
+        ASSERT_NE(page, nullptr);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(page) % 4096, 0);
+        pages.push_back(page);
+    }
+
+    // A 512-aligned 64-byte request leaves the 512-byte class untouched.
+    void *ptr = manager.Allocate(64, 512);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 512, 0);
+    EXPECT_TRUE(manager.Owns(ptr));
+    for (std::size_t i = 0; i < config.blocks_per_class; i++)
+    {
+        ASSERT_NE(manager.Allocate(512), nullptr);
+    }
+    EXPECT_EQ(manager.Allocate(512), nullptr);
+
+    // Freeing with the allocation-site pair and sizeless both find the tier.
+    manager.Free(ptr, 64, 512);
+    EXPECT_EQ(manager.Allocate(64, 512), ptr);
+    manager.Free(ptr);
+    for (void *page : pages)
+    {
+        manager.Free(page, 512, 4096);
+    }
+    EXPECT_EQ(manager.Allocate(512, 4096), pages[0]);
+}
+
+TEST(SlabManagerTest, OverAlignedTierDisabledKeepsRoutingByAlignment)
+{
+    mcr::SlabManager manager;
+
+    void *ptr = manager.Allocate(64, 512);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_FALSE(manager.Owns(ptr));
+    EXPECT_EQ(manager.Allocate(512, 4096), nullptr);
+    manager.Free(ptr, 64, 512);
+
+    // The freed block went back to the 512-byte class.
+    EXPECT_EQ(manager.Allocate(500), ptr);
+}
+
+TEST(SlabManagerTest, OverAlignedReallocateMovesOnlyAcrossTiers)
+{
+    mcr::SlabManagerConfig config;
+    config.over_aligned_blocks_per_class = 64;
+    mcr::SlabManager manager(config);
+
+    void *ptr = manager.Allocate(40, 256);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(manager.Reallocate(ptr, 40, 64, 256), ptr); // Same over-aligned class.
+
+    // 300 bytes with 256 alignment is no longer over-aligned: it moves to the 512-byte class.
+    void *moved = manager.Reallocate(ptr, 64, 300, 256);
+    ASSERT_NE(moved, nullptr);
+    EXPECT_NE(moved, ptr);
+    EXPECT_FALSE(manager.Owns(moved));
+    manager.Free(moved, 300, 256);
+}
+
 // ------------------------------------------------------------
 // Allocation failure and invalid input.
 // ------------------------------------------------------------
@@ -165,6 +518,25 @@ TEST(SlabManagerTest, AllocationWhoseAlignmentExceedsMaxClassSizeReturnsNullptr)
     EXPECT_EQ(manager.Allocate(16, 2048), nullptr);
 }
 
+TEST(SlabManagerTest, SizelessFreeOfForeignPointerThrowsInvalidArgument)
+{
+    mcr::SlabManagerConfig config;
+    config.contiguous_arena = true;
+    mcr::SlabManager arena_manager(config);
+    mcr::SlabManager plain_manager;
+
+    int local = 0;
+    EXPECT_FALSE(arena_manager.Owns(&local));
+    EXPECT_THROW({ arena_manager.Free(&local); }, std::invalid_argument);
+
+    // Without the arena, small blocks cannot be routed from their address.
+    void *ptr = plain_manager.Allocate(64);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_FALSE(plain_manager.Owns(ptr));
+    EXPECT_THROW({ plain_manager.Free(ptr); }, std::invalid_argument);
+    plain_manager.Free(ptr, 64, sizeof(void *));
+}
+
 TEST(SlabManagerTest, ZeroSizeThrowsInvalidArgument)
 {
     mcr::SlabManager manager;
@@ -239,3 +611,76 @@ TEST(SlabManagerTest, DefaultAlignedFreeNullptrIsNoOp)
     EXPECT_EQ(ptr3, ptr1);
     EXPECT_EQ(ptr4, ptr2);
 }
+
+// ------------------------------------------------------------
+// Statistics.
+// ------------------------------------------------------------
+
+TEST(SlabManagerTest, StatsTrackInUsePeakAndFailuresPerClass)
+{
+    mcr::SlabManagerConfig config;
+    config.blocks_per_class = 4;
+    mcr::SlabManager manager(config);
+
+    std::vector<void *> ptrs;
+    for (int i = 0; i < 5; i++)
+    {
+        ptrs.push_back(manager.Allocate(40)); // The fifth request exhausts the 64-byte class.
+    }
+    EXPECT_EQ(ptrs.back(), nullptr);
+    manager.Free(ptrs[0], 40, sizeof(void *));
+    manager.FreeBatch(ptrs.data() + 1, 2, 40, sizeof(void *));
+
+    const mcr::SlabManagerStats stats = manager.GetStats();
+    const mcr::SlabStats &cls = stats.classes[mcr::SizeClassPolicy::ClassIndex(64)];
+    EXPECT_EQ(cls.block_size, 64);
+    EXPECT_EQ(cls.capacity, config.blocks_per_class);
+    EXPECT_EQ(stats.classes[0].block_size, 16);
+
+    if (mcr::kStatsEnabled)
+    {
+        EXPECT_EQ(cls.in_use, 1);
+        EXPECT_EQ(cls.peak_in_use, 4);
+        EXPECT_EQ(cls.total_allocations, 4);
+        EXPECT_EQ(cls.failed_allocations, 1);
+        EXPECT_EQ(stats.classes[0].total_allocations, 0);
+    }
+    else
+    {
+        EXPECT_EQ(cls.in_use, 0);
+        EXPECT_EQ(cls.failed_allocations, 0);
+    }
+    EXPECT_TRUE(stats.over_aligned.empty());
+    manager.Free(ptrs[3], 40, sizeof(void *));
+}
+
+TEST(SlabManagerTest, StatsReportOverAlignedTierCapacityAndInUse)
+{
+    mcr::SlabManagerConfig config;
+    config.over_aligned_blocks_per_class = 16;
+    mcr::SlabManager manager(config);
+
+    void *first = manager.Allocate(64, 512);
+    void *second = manager.Allocate(64, 512);
+    void *page = manager.Allocate(512, 4096);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    ASSERT_NE(page, nullptr);
+    manager.Free(second, 64, 512);
+
+    const mcr::SlabManagerStats stats = manager.GetStats();
+    ASSERT_EQ(stats.over_aligned.size(), mcr::SizeClassPolicy::kNumClasses);
+    const mcr::SlabStats &small = stats.over_aligned[mcr::SizeClassPolicy::ClassIndex(64)];
+    const mcr::SlabStats &large = stats.over_aligned[mcr::SizeClassPolicy::ClassIndex(512)];
+    EXPECT_EQ(small.block_size, 64);
+    EXPECT_EQ(small.capacity, config.over_aligned_blocks_per_class);
+    EXPECT_EQ(small.in_use, 1);
+    EXPECT_EQ(large.in_use, 1);
+    EXPECT_EQ(stats.over_aligned[0].in_use, 0);
+
+    // The tier is reported on its own; the regular classes stay untouched.
+    EXPECT_EQ(stats.classes[mcr::SizeClassPolicy::ClassIndex(512)].in_use, 0);
+
+    manager.Free(first, 64, 512);
+    manager.Free(page, 512, 4096);
+}
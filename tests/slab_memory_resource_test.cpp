@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "slab_memory_resource.h"
+#include "thread_cached_slab_manager.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace
+{
+    mcr::SlabManagerConfig GrowableConfig()
+    {
+        mcr::SlabManagerConfig config;
+        config.blocks_per_class = 64;
+        config.growth = mcr::SlabGrowth::kGeometric;
+        config.max_blocks_per_class = 1 << 16;
+        config.large_region_size = 1 << 20;
+        return config;
+    }
+}
+
+// ------------------------------------------------------------
+// Container integration.
+// ------------------------------------------------------------
+
+TEST(SlabMemoryResourceTest, PmrContainersRoundTripThroughManager)
+{
+    mcr::SlabManager manager(GrowableConfig());
+    mcr::SlabMemoryResource resource(manager);
+
+    {
+        std::pmr::map<int, std::pmr::string> map(&resource);
+        std::pmr::list<int> list(&resource);
+        std::pmr::vector<std::uint64_t> vector(&resource);
+        for (int i = 0; i < 5000; i++)
+        {
+            map.emplace(i, std::string(40, 'x')); // Long enough to leave the small-string buffer.
+            list.push_back(i);
+            vector.push_back(static_cast<std::uint64_t>(i)); // Grows past 1 KiB into the large-object region.
+        }
+        EXPECT_EQ(map.at(4999).size(), 40u);
+        EXPECT_EQ(list.back(), 4999);
+        EXPECT_GT(manager.GetLargeObjectStats().live_allocations, 0u);
+    }
+
+    // Every block went back through the sized Free path.
+    EXPECT_EQ(manager.GetLargeObjectStats().live_allocations, 0u);
+}
+
+TEST(SlabMemoryResourceTest, EqualityFollowsManager)
+{
+    mcr::SlabManager manager;
+    mcr::SlabManager other_manager;
+    mcr::SlabMemoryResource resource1(manager);
+    mcr::SlabMemoryResource resource2(manager);
+    mcr::SlabMemoryResource resource3(other_manager);
+
+    EXPECT_TRUE(resource1.is_equal(resource2));
+    EXPECT_FALSE(resource1.is_equal(resource3));
+    EXPECT_FALSE(resource1.is_equal(*std::pmr::new_delete_resource()));
+}
+
+TEST(SlabMemoryResourceTest, WorksOverThreadCachedManager)
+{
+    mcr::ThreadCachedSlabManager manager(GrowableConfig());
+    mcr::SlabMemoryResource resource(manager);
+
+    void *ptr = resource.allocate(48, 16);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 16, 0);
+    resource.deallocate(ptr, 48, 16);
+
+    void *empty = resource.allocate(0, 8); // Zero-byte requests still yield a unique block.
+    EXPECT_NE(empty, nullptr);
+    resource.deallocate(empty, 0, 8);
+}
+
+// ------------------------------------------------------------
+// Allocation failure.
+// ------------------------------------------------------------
+
+TEST(SlabMemoryResourceTest, ExhaustedManagerThrowsBadAlloc)
+{
+    mcr::SlabManagerConfig config;
+    config.blocks_per_class = 2;
+    mcr::SlabManager manager(config);
+    mcr::SlabMemoryResource resource(manager);
+
+    void *ptr1 = resource.allocate(64);
+    void *ptr2 = resource.allocate(64);
+    EXPECT_THROW({ (void)resource.allocate(64); }, std::bad_alloc);
+    EXPECT_THROW({ (void)resource.allocate(4096); }, std::bad_alloc); // No large-object region configured.
+    resource.deallocate(ptr1, 64);
+    resource.deallocate(ptr2, 64);
+}
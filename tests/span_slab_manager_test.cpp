@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "span_slab_manager.h"
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t kSpanSize = mcr::PageHeap::kDefaultSpanSize;
+
+    mcr::SpanSlabManagerConfig HeapOfSpans(std::size_t spans)
+    {
+        mcr::SpanSlabManagerConfig config;
+        config.heap_size = spans * kSpanSize;
+        return config;
+    }
+
+    /**
+     * @brief Allocate `size`-byte blocks until the manager returns nullptr.
+     */
+    std::vector<void *> Fill(mcr::SpanSlabManager &manager, std::size_t size)
+    {
+        std::vector<void *> ptrs;
+        while (void *ptr = manager.Allocate(size))
+        {
+            ptrs.push_back(ptr);
+        }
+        return ptrs;
+    }
+}
+
+// ------------------------------------------------------------
+// Routing and block allocation.
+// ------------------------------------------------------------
+
+TEST(SpanSlabManagerTest, BlocksAreDistinctAndAlignedToTheirClass)
+{
+    mcr::SpanSlabManager manager(HeapOfSpans(32));
+    std::set<void *> seen;
+    for (std::size_t size : {1, 16, 40, 64, 100, 256, 700, 1024})
+    {
+        for (int i = 0; i < 300; i++)
+        {
+            void *ptr = manager.Allocate(size);
+            ASSERT_NE(ptr, nullptr);
+            const std::size_t class_size = mcr::SizeClassPolicy::ClassSize(mcr::SizeClassPolicy::ClassIndex(size));
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % class_size, 0);
+            EXPECT_TRUE(seen.insert(ptr).second);
+        }
+    }
+}
+
+TEST(SpanSlabManagerTest, FreedBlockOfFullSpanIsReused)
+{
+    mcr::SpanSlabManager manager(HeapOfSpans(1));
+    std::vector<void *> ptrs = Fill(manager, 256);
+    ASSERT_EQ(ptrs.size(), kSpanSize / 256);
+
+    manager.Free(ptrs[7], 256, sizeof(void *));
+    EXPECT_EQ(manager.Allocate(256), ptrs[7]);
+    EXPECT_EQ(manager.Allocate(256), nullptr);
+}
+
+TEST(SpanSlabManagerTest, InvalidRequestsThrowOrReturnNullptr)
+{
+    mcr::SpanSlabManager manager(HeapOfSpans(1));
+    EXPECT_THROW(manager.Allocate(0), std::invalid_argument);
+    EXPECT_THROW(manager.Allocate(64, 3), std::invalid_argument);
+    EXPECT_EQ(manager.Allocate(mcr::SizeClassPolicy::kMaxClassSize + 1), nullptr);
+    EXPECT_THROW(manager.SetSpanLimit(0, 1), std::invalid_argument);
+    EXPECT_THROW(manager.SetSpanLimit(mcr::SizeClassPolicy::kMaxClassSize + 1, 1), std::invalid_argument);
+}
+
+// ------------------------------------------------------------
+// Memory moving between classes.
+// ------------------------------------------------------------
+
+TEST(SpanSlabManagerTest, EmptySpansMigrateToAnotherClass)
+{
+    constexpr std::size_t kSpans = 4;
+    mcr::SpanSlabManager manager(HeapOfSpans(kSpans));
+
+    // The 64-byte class takes the whole budget; the 512-byte class gets nothing.
+    std::vector<void *> small = Fill(manager, 64);
+    EXPECT_EQ(small.size(), kSpans * (kSpanSize / 64));
+    EXPECT_EQ(manager.Allocate(512), nullptr);
+
+    // Freeing returns every span but the one the class keeps.
+    for (void *ptr : small)
+    {
+        manager.Free(ptr, 64, sizeof(void *));
+    }
+    EXPECT_EQ(manager.GetStats().heap.spans_in_use, 1);
+    std::vector<void *> large = Fill(manager, 512);
+    EXPECT_EQ(large.size(), (kSpans - 1) * (kSpanSize / 512));
+    for (void *ptr : large)
+    {
+        manager.Free(ptr);
+    }
+
+    // Scavenging returns the kept spans too, so the full budget is available to one class again.
+    manager.Scavenge();
+    EXPECT_EQ(manager.GetStats().heap.spans_in_use, 0);
+    EXPECT_EQ(Fill(manager, 512).size(), kSpans * (kSpanSize / 512));
+}
+
+TEST(SpanSlabManagerTest, SpanLimitsCapOneClass)
+{
+    mcr::SpanSlabManagerConfig config = HeapOfSpans(8);
+    config.max_spans_per_class = 2;
+    mcr::SpanSlabManager manager(config);
+
+    EXPECT_EQ(Fill(manager, 128).size(), 2 * (kSpanSize / 128));
+    manager.SetSpanLimit(1024, 1);
+    EXPECT_EQ(Fill(manager, 1024).size(), kSpanSize / 1024);
+
+    // Raising the limit lets the class grow again; the heap still has five spans.
+    manager.SetSpanLimit(128, 0);
+    EXPECT_EQ(Fill(manager, 128).size(), 5 * (kSpanSize / 128));
+
+    const mcr::SpanSlabManagerStats stats = manager.GetStats();
+    EXPECT_EQ(stats.classes[mcr::SizeClassPolicy::ClassIndex(128)].capacity, 7 * (kSpanSize / 128));
+    EXPECT_EQ(stats.heap.spans_in_use, 8);
+}
+
+// ------------------------------------------------------------
+// Ownership.
+// ------------------------------------------------------------
+
+TEST(SpanSlabManagerTest, SizelessFreeAndOwnsFollowTheSpanTable)
+{
+    mcr::SpanSlabManager manager(HeapOfSpans(2));
+    void *small = manager.Allocate(24);
+    void *large = manager.Allocate(1000);
+    ASSERT_NE(small, nullptr);
+    ASSERT_NE(large, nullptr);
+    EXPECT_TRUE(manager.Owns(small));
+    EXPECT_TRUE(manager.Owns(large));
+
+    int outside = 0;
+    EXPECT_FALSE(manager.Owns(&outside));
+    EXPECT_THROW(manager.Free(&outside), std::invalid_argument);
+
+    manager.Free(small);
+    manager.Free(large);
+    manager.Free(nullptr);
+    manager.Scavenge();
+
+    // Back in the heap, the spans no longer belong to any class.
+    EXPECT_FALSE(manager.Owns(small));
+    EXPECT_FALSE(manager.Owns(large));
+}
+
+// ------------------------------------------------------------
+// Statistics.
+// ------------------------------------------------------------
+
+TEST(SpanSlabManagerTest, StatsReportSpansAndClassCounters)
+{
+    mcr::SpanSlabManager manager(HeapOfSpans(1));
+    std::vector<void *> ptrs = Fill(manager, 1024); // One span, then one failed allocation.
+    for (std::size_t i = 1; i < ptrs.size(); i++)
+    {
+        manager.Free(ptrs[i]);
+    }
+
+    const mcr::SpanSlabManagerStats stats = manager.GetStats();
+    const mcr::SlabStats &cls = stats.classes[mcr::SizeClassPolicy::ClassIndex(1024)];
+    EXPECT_EQ(cls.block_size, 1024);
+    EXPECT_EQ(cls.capacity, kSpanSize / 1024);
+    EXPECT_EQ(stats.heap.span_count, 1);
+    EXPECT_EQ(stats.heap.spans_in_use, 1);
+
+    if (mcr::kStatsEnabled)
+    {
+        EXPECT_EQ(cls.in_use, 1);
+        EXPECT_EQ(cls.peak_in_use, kSpanSize / 1024);
+        EXPECT_EQ(cls.total_allocations, kSpanSize / 1024);
+        EXPECT_EQ(cls.failed_allocations, 1);
+    }
+    else
+    {
+        EXPECT_EQ(cls.in_use, 0);
+        EXPECT_EQ(cls.failed_allocations, 0);
+    }
+}
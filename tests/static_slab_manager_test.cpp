@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "static_slab_manager.h"
+#include <cstddef>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+
+namespace
+{
+    using DefaultTable = mcr::PowerOfTwoClasses<16, 1024>;
+    using SmallTable = mcr::PowerOfTwoClasses<32, 256>;
+    using GeometricTable = mcr::GeometricClasses<16, 1024, 4>;
+
+    // Routing is constexpr, so the class table can be checked at compile time.
+    static_assert(DefaultTable::kNumClasses == 7, "16..1024 has 7 classes.");
+    static_assert(SmallTable::kNumClasses == 4, "32..256 has 4 classes.");
+    static_assert(DefaultTable::ClassIndex(1) == 0 && DefaultTable::ClassIndex(16) == 0, "Keys up to the minimum map to class 0.");
+    static_assert(DefaultTable::ClassIndex(17) == 1 && DefaultTable::ClassIndex(32) == 1, "(16, 32] maps to class 1.");
+    static_assert(DefaultTable::ClassIndex(1024) == 6, "The maximum maps to the last class.");
+    static_assert(SmallTable::ClassIndex(33) == 1 && SmallTable::ClassSize(3) == 256, "Custom tables route the same way.");
+    static_assert(mcr::DefaultStaticSlabManager::ClassIndexFor(16, 64) == 2, "Alignment participates in the routing key.");
+
+    // 16 | 32 | 48 64 | 80 96 112 128 | 160 192 224 256 | 320 384 448 512 | 640 768 896 1024
+    static_assert(GeometricTable::kNumClasses == 20, "Four classes per doubling with a 16-byte floor.");
+    static_assert(GeometricTable::ClassSize(GeometricTable::ClassIndex(260)) == 320, "A 260-byte request takes a 320-byte block.");
+    static_assert(GeometricTable::ClassSize(GeometricTable::ClassIndex(1)) == 16, "The smallest keys map to the first class.");
+    static_assert(GeometricTable::ClassSize(GeometricTable::ClassIndex(1024)) == 1024, "The maximum maps to the last class.");
+    static_assert(GeometricTable::ClassAlignment(GeometricTable::ClassIndex(96)) == 32, "Classes are naturally aligned.");
+    static_assert(GeometricTable::ClassSize(mcr::GeometricStaticSlabManager::ClassIndexFor(65, 64)) == 128, "Over-aligned requests round up to an aligned class.");
+}
+
+// ------------------------------------------------------------
+// Allocation and routing success path.
+// ------------------------------------------------------------
+
+TEST(StaticSlabManagerTest, PerClassAlignmentMatrix)
+{
+    constexpr std::array<std::size_t, 7> kClasses{16, 32, 64, 128, 256, 512, 1024};
+
+    mcr::DefaultStaticSlabManager manager;
+    for (std::size_t cls : kClasses)
+    {
+        const std::size_t prev = cls / 2;
+        const std::size_t requests[2] = {(cls == 16 ? 1 : (prev + 1)), cls};
+
+        for (std::size_t request : requests)
+        {
+            SCOPED_TRACE(testing::Message() << "class = " << cls << ", request size = " << request);
+
+            void *ptr = manager.Allocate(request);
+            ASSERT_NE(ptr, nullptr);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % cls, 0);
+            manager.Free(ptr, request, sizeof(void *));
+        }
+    }
+}
+
+TEST(StaticSlabManagerTest, CompileTimeRoutingMatchesRuntimeRouting)
+{
+    mcr::DefaultStaticSlabManager manager;
+
+    // Both overloads route to the same class, so a block freed through one is reused through the other.
+    void *ptr1 = manager.Allocate<16, 64>();
+    ASSERT_NE(ptr1, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr1) % 64, 0);
+    manager.Free(ptr1, 16, 64);
+
+    void *ptr2 = manager.Allocate<40>();
+    EXPECT_EQ(ptr2, ptr1);
+    manager.Free<40>(ptr2);
+
+    void *ptr3 = manager.Allocate(64);
+    EXPECT_EQ(ptr3, ptr1);
+    manager.Free(ptr3, 64, sizeof(void *));
+}
+
+TEST(StaticSlabManagerTest, CustomTableExhaustsOnlyRoutedClass)
+{
+    constexpr std::size_t kBlocks = 8;
+    mcr::StaticSlabManager<SmallTable, kBlocks> manager;
+
+    std::array<void *, kBlocks> ptrs{};
+    for (std::size_t i = 0; i < kBlocks; i++)
+    {
+        ptrs[i] = manager.Allocate(100); // Routes to the 128-byte class.
+        ASSERT_NE(ptrs[i], nullptr);
+    }
+    EXPECT_EQ(manager.Allocate(100), nullptr);
+
+    void *small_ptr = manager.Allocate(8);
+    ASSERT_NE(small_ptr, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(small_ptr) % 32, 0);
+    manager.Free(small_ptr, 8, sizeof(void *));
+
+    for (void *ptr : ptrs)
+    {
+        manager.Free(ptr, 100, sizeof(void *));
+    }
+}
+
+TEST(StaticSlabManagerTest, GeometricTableRoutesToSmallestFittingClass)
+{
+    // Brute-force the whole key range against a linear scan of the class table.
+    for (std::size_t key = 1; key <= GeometricTable::kMaxClassSize; key++)
+    {
+        std::size_t expected = 0;
+        while (GeometricTable::ClassSize(expected) < key)
+        {
+            expected++;
+        }
+        ASSERT_EQ(GeometricTable::ClassIndex(key), expected) << "key = " << key;
+    }
+}
+
+TEST(StaticSlabManagerTest, GeometricClassesSatisfyEveryAlignment)
+{
+    mcr::GeometricStaticSlabManager manager;
+
+    for (std::size_t alignment = 1; alignment <= 1024; alignment *= 2)
+    {
+        for (std::size_t size = 1; size <= 1024; size += 7)
+        {
+            if (GeometricTable::RoutingKey(size, alignment) > GeometricTable::kMaxClassSize)
+            {
+                EXPECT_EQ(manager.Allocate(size, alignment), nullptr);
+                continue;
+            }
+
+            SCOPED_TRACE(testing::Message() << "size = " << size << ", alignment = " << alignment);
+            void *ptr = manager.Allocate(size, alignment);
+            ASSERT_NE(ptr, nullptr);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % alignment, 0);
+            EXPECT_GE(GeometricTable::ClassSize(manager.ClassIndexFor(size, alignment)), size);
+
+            // Free routes back symmetrically, so the LIFO class hands the same block out again.
+            manager.Free(ptr, size, alignment);
+            EXPECT_EQ(manager.Allocate(size, alignment), ptr);
+            manager.Free(ptr, size, alignment);
+        }
+    }
+}
+
+// ------------------------------------------------------------
+// Allocation failure and invalid input.
+// ------------------------------------------------------------
+
+TEST(StaticSlabManagerTest, RequestAboveTableReturnsNullptr)
+{
+    mcr::StaticSlabManager<SmallTable, 4> manager;
+
+    EXPECT_EQ(manager.Allocate(257), nullptr);
+    EXPECT_EQ(manager.Allocate(16, 512), nullptr);
+}
+
+TEST(StaticSlabManagerTest, InvalidRequestsThrowInvalidArgument)
+{
+    mcr::DefaultStaticSlabManager manager;
+
+    EXPECT_THROW({ manager.Allocate(0); }, std::invalid_argument);
+    EXPECT_THROW({ manager.Allocate(16, 0); }, std::invalid_argument);
+    EXPECT_THROW({ manager.Allocate(16, 24); }, std::invalid_argument);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "stl_allocator.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <list>
+#include <map>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    mcr::SlabManagerConfig GrowableConfig()
+    {
+        mcr::SlabManagerConfig config;
+        config.blocks_per_class = 64;
+        config.growth = mcr::SlabGrowth::kGeometric;
+        config.max_blocks_per_class = 1 << 16;
+        config.large_region_size = 1 << 20;
+        return config;
+    }
+
+    struct alignas(64) CacheLine
+    {
+        unsigned char bytes[64];
+    };
+}
+
+// ------------------------------------------------------------
+// Container integration.
+// ------------------------------------------------------------
+
+TEST(StlAllocatorTest, NodeContainersRoundTripThroughManager)
+{
+    mcr::SlabManager manager(GrowableConfig());
+
+    {
+        using MapAllocator = mcr::StlAllocator<std::pair<const int, int>>;
+        std::map<int, int, std::less<int>, MapAllocator> map{MapAllocator(manager)};
+        std::list<int, mcr::StlAllocator<int>> list{mcr::StlAllocator<int>(manager)};
+        std::unordered_map<int, int, std::hash<int>, std::equal_to<int>, MapAllocator> hash_map{0, std::hash<int>(), std::equal_to<int>(), MapAllocator(manager)};
+
+        for (int i = 0; i < 5000; i++)
+        {
+            map.emplace(i, i);
+            list.push_back(i);
+            hash_map.emplace(i, i); // The bucket array grows into the large-object region.
+        }
+        for (int i = 0; i < 5000; i += 2)
+        {
+            map.erase(i);
+            hash_map.erase(i);
+        }
+        EXPECT_EQ(map.size(), 2500u);
+        EXPECT_EQ(hash_map.at(4999), 4999);
+        EXPECT_EQ(list.size(), 5000u);
+    }
+    EXPECT_EQ(manager.GetLargeObjectStats().live_allocations, 0u);
+}
+
+TEST(StlAllocatorTest, OverAlignedTypesKeepTheirAlignment)
+{
+    mcr::SlabManager manager(GrowableConfig());
+    std::vector<CacheLine, mcr::StlAllocator<CacheLine>> lines{mcr::StlAllocator<CacheLine>(manager)};
+
+    for (int i = 0; i < 100; i++)
+    {
+        lines.emplace_back();
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(lines.data()) % alignof(CacheLine), 0);
+    }
+}
+
+TEST(StlAllocatorTest, RebindAndEqualityFollowManager)
+{
+    mcr::SlabManager manager;
+    mcr::SlabManager other_manager;
+    mcr::StlAllocator<int> ints(manager);
+    mcr::StlAllocator<double> doubles(ints);
+
+    EXPECT_TRUE(ints == doubles);
+    EXPECT_TRUE(ints != mcr::StlAllocator<int>(other_manager));
+
+    // A rebound copy frees blocks of the original.
+    mcr::StlAllocator<int> back(doubles);
+    int *ptr = ints.allocate(4);
+    back.deallocate(ptr, 4);
+}
+
+// ------------------------------------------------------------
+// Allocation failure.
+// ------------------------------------------------------------
+
+TEST(StlAllocatorTest, FailuresThrow)
+{
+    mcr::SlabManager manager;
+    mcr::StlAllocator<std::uint64_t> allocator(manager);
+
+    EXPECT_THROW({ allocator.allocate(std::numeric_limits<std::size_t>::max()); }, std::bad_array_new_length);
+    EXPECT_THROW({ allocator.allocate(1000); }, std::bad_alloc); // 8000 bytes, no large-object region.
+}
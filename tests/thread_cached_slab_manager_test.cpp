@@ -0,0 +1,386 @@
+#include <gtest/gtest.h>
+#include "thread_cached_slab_manager.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// ------------------------------------------------------------
+// Single-thread behavior.
+// ------------------------------------------------------------
+
+TEST(ThreadCachedSlabManagerTest, AllocationIsAlignedToRoutedClass)
+{
+    mcr::ThreadCachedSlabManager manager;
+
+    void *ptr1 = manager.Allocate(16, 64);
+    void *ptr2 = manager.Allocate(40);
+    ASSERT_NE(ptr1, nullptr);
+    ASSERT_NE(ptr2, nullptr);
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr1) % 64, 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr2) % 64, 0);
+
+    manager.Free(ptr1, 16, 64);
+    manager.Free(ptr2, 40, sizeof(void *));
+}
+
+TEST(ThreadCachedSlabManagerTest, FreedBlockIsReusedFromThreadCache)
+{
+    mcr::ThreadCachedSlabManager manager;
+
+    void *ptr1 = manager.Allocate(40);
+    ASSERT_NE(ptr1, nullptr);
+
+    // The thread cache is LIFO, so the same block comes back immediately.
+    manager.Free(ptr1, 40, sizeof(void *));
+    void *ptr2 = manager.Allocate(40);
+    EXPECT_EQ(ptr2, ptr1);
+
+    manager.Free(ptr2, 40, sizeof(void *));
+}
+
+TEST(ThreadCachedSlabManagerTest, CapacityMatchesBlocksPerClass)
+{
+    constexpr std::size_t kBlocksPerClass = 150; // Not a multiple of the transfer batch.
+    mcr::ThreadCachedSlabManager manager(kBlocksPerClass);
+
+    std::vector<void *> ptrs;
+    for (std::size_t i = 0; i < kBlocksPerClass; i++)
+    {
+        void *ptr = manager.Allocate(40);
+        ASSERT_NE(ptr, nullptr);
+        ptrs.push_back(ptr);
+    }
+    EXPECT_EQ(manager.Allocate(40), nullptr);
+
+    // Other size classes still have capacity.
+    void *other = manager.Allocate(128);
+    ASSERT_NE(other, nullptr);
+    manager.Free(other, 128, sizeof(void *));
+
+    // Freeing everything, including past the cache capacity, restores the full class.
+    for (void *ptr : ptrs)
+    {
+        manager.Free(ptr, 40, sizeof(void *));
+    }
+    manager.FlushThreadCache();
+
+    for (std::size_t i = 0; i < kBlocksPerClass; i++)
+    {
+        ASSERT_NE(manager.Allocate(40), nullptr);
+    }
+    EXPECT_EQ(manager.Allocate(40), nullptr);
+}
+
+TEST(ThreadCachedSlabManagerTest, InvalidRequestsThrowOrReturnNullptr)
+{
+    mcr::ThreadCachedSlabManager manager;
+
+    EXPECT_THROW({ manager.Allocate(0); }, std::invalid_argument);
+    EXPECT_THROW({ manager.Allocate(16, 0); }, std::invalid_argument);
+    EXPECT_THROW({ manager.Allocate(16, 24); }, std::invalid_argument);
+    EXPECT_EQ(manager.Allocate(2048), nullptr);
+
+    manager.Free(nullptr, 16, sizeof(void *)); // No-op.
+}
+
+TEST(ThreadCachedSlabManagerTest, ZeroBlocksPerClassThrowsInvalidArgument)
+{
+    EXPECT_THROW({ mcr::ThreadCachedSlabManager manager(0); }, std::invalid_argument);
+}
+
+// ------------------------------------------------------------
+// Multi-thread behavior.
+// ------------------------------------------------------------
+
+TEST(ThreadCachedSlabManagerTest, ThreadExitReturnsCachedBlocksToSharedPool)
+{
+    constexpr std::size_t kBlocksPerClass = 100;
+    mcr::ThreadCachedSlabManager manager(kBlocksPerClass);
+
+    // The worker drains the whole class into its cache, then frees everything back into it.
+    std::thread worker([&manager]
+                       {
+        std::vector<void *> ptrs;
+        for (std::size_t i = 0; i < kBlocksPerClass; i++)
+        {
+            ptrs.push_back(manager.Allocate(40));
+        }
+        for (void *ptr : ptrs)
+        {
+            manager.Free(ptr, 40, sizeof(void *));
+        } });
+    worker.join();
+
+    // Thread exit flushed the worker cache, so the whole class is available here.
+    for (std::size_t i = 0; i < kBlocksPerClass; i++)
+    {
+        ASSERT_NE(manager.Allocate(40), nullptr);
+    }
+    EXPECT_EQ(manager.Allocate(40), nullptr);
+}
+
+namespace
+{
+    /**
+     * @brief Frees its blocks from a thread_local destructor.
+     */
+    struct LateReleaser
+    {
+        mcr::ThreadCachedSlabManager *manager = nullptr;
+        std::vector<void *> ptrs;
+
+        ~LateReleaser()
+        {
+            for (void *ptr : ptrs)
+            {
+                manager->Free(ptr, 40, sizeof(void *));
+            }
+        }
+    };
+}
+
+TEST(ThreadCachedSlabManagerTest, FreeAfterThreadCacheReleaseGoesToSharedPool)
+{
+    constexpr std::size_t kBlocksPerClass = 100;
+    mcr::ThreadCachedSlabManager manager(kBlocksPerClass);
+
+    std::thread worker([&manager]
+                       {
+        // Constructed before the manager's cache list, so it is destroyed after the caches were released.
+        static thread_local LateReleaser releaser;
+        releaser.manager = &manager;
+        for (std::size_t i = 0; i < kBlocksPerClass; i++)
+        {
+            releaser.ptrs.push_back(manager.Allocate(40));
+        } });
+    worker.join();
+
+    for (std::size_t i = 0; i < kBlocksPerClass; i++)
+    {
+        ASSERT_NE(manager.Allocate(40), nullptr);
+    }
+    EXPECT_EQ(manager.Allocate(40), nullptr);
+}
+
+TEST(ThreadCachedSlabManagerTest, ConcurrentAllocationsDoNotOverlap)
+{
+    constexpr int kThreads = 4;
+    constexpr int kRounds = 200;
+    constexpr std::size_t kLive = 48;
+    constexpr std::size_t kSize = 64;
+    mcr::ThreadCachedSlabManager manager(kThreads * kLive * 4);
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(kThreads, 0);
+    for (int t = 0; t < kThreads; t++)
+    {
+        threads.emplace_back([&manager, &failures, t]
+                             {
+            std::vector<unsigned char *> ptrs;
+            for (int round = 0; round < kRounds; round++)
+            {
+                const unsigned char tag = static_cast<unsigned char>(t * kRounds + round);
+                for (std::size_t i = 0; i < kLive; i++)
+                {
+                    unsigned char *ptr = static_cast<unsigned char *>(manager.Allocate(kSize));
+                    if (!ptr)
+                    {
+                        failures[t]++;
+                        continue;
+                    }
+                    std::memset(ptr, tag, kSize);
+                    ptrs.push_back(ptr);
+                }
+
+                // Any block handed to two threads at once would have been overwritten.
+                for (unsigned char *ptr : ptrs)
+                {
+                    for (std::size_t i = 0; i < kSize; i++)
+                    {
+                        if (ptr[i] != tag)
+                        {
+                            failures[t]++;
+                            break;
+                        }
+                    }
+                    manager.Free(ptr, kSize, sizeof(void *));
+                }
+                ptrs.clear();
+            } });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int t = 0; t < kThreads; t++)
+    {
+        EXPECT_EQ(failures[t], 0) << "thread " << t;
+    }
+}
+
+TEST(ThreadCachedSlabManagerTest, ArenaSizelessFreeFromAnotherThread)
+{
+    mcr::SlabManagerConfig config;
+    config.blocks_per_class = 40;
+    config.contiguous_arena = true;
+    mcr::ThreadCachedSlabManager manager(config);
+
+    std::vector<void *> ptrs;
+    for (std::size_t i = 0; i < config.blocks_per_class; i++)
+    {
+        void *ptr = manager.Allocate(i % 2 ? 100 : 20);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_TRUE(manager.Owns(ptr));
+        ptrs.push_back(ptr);
+    }
+
+    std::thread consumer([&manager, &ptrs]
+                         {
+        for (void *ptr : ptrs)
+        {
+            manager.Free(ptr);
+        } });
+    consumer.join();
+
+    // Both classes got their own blocks back.
+    for (std::size_t i = 0; i < config.blocks_per_class; i++)
+    {
+        ASSERT_NE(manager.Allocate(100), nullptr);
+        ASSERT_NE(manager.Allocate(20), nullptr);
+    }
+}
+
+TEST(ThreadCachedSlabManagerTest, CrossThreadFreeIsAccepted)
+{
+    mcr::ThreadCachedSlabManager manager;
+
+    std::vector<void *> ptrs;
+    for (int i = 0; i < 10; i++)
+    {
+        void *ptr = manager.Allocate(100);
+        ASSERT_NE(ptr, nullptr);
+        ptrs.push_back(ptr);
+    }
+
+    // Another thread frees the blocks; its exit hands them back to the shared pool.
+    std::thread consumer([&manager, &ptrs]
+                         {
+        for (void *ptr : ptrs)
+        {
+            manager.Free(ptr, 100, sizeof(void *));
+        } });
+    consumer.join();
+
+    manager.FlushThreadCache();
+    std::vector<void *> again;
+    for (std::size_t i = 0; i < mcr::ThreadCachedSlabManager::kDefaultBlocksPerClass; i++)
+    {
+        void *ptr = manager.Allocate(100);
+        ASSERT_NE(ptr, nullptr);
+        again.push_back(ptr);
+    }
+    EXPECT_EQ(manager.Allocate(100), nullptr);
+}
+
+TEST(ThreadCachedSlabManagerTest, ManagerDestroyedBeforeThreadExit)
+{
+    auto manager = std::make_unique<mcr::ThreadCachedSlabManager>();
+    std::mutex step_mutex;
+    std::condition_variable step_cv;
+    int step = 0;
+
+    std::thread worker([&]
+                       {
+        void *ptr = manager->Allocate(32);
+        manager->Free(ptr, 32, sizeof(void *)); // Leaves a block in the worker cache.
+        {
+            std::lock_guard<std::mutex> lock(step_mutex);
+            step = 1;
+        }
+        step_cv.notify_all();
+
+        std::unique_lock<std::mutex> lock(step_mutex);
+        step_cv.wait(lock, [&]
+                     { return step == 2; }); });
+
+    {
+        std::unique_lock<std::mutex> lock(step_mutex);
+        step_cv.wait(lock, [&]
+                     { return step == 1; });
+    }
+    manager.reset(); // The worker still holds a cache for this manager.
+    {
+        std::lock_guard<std::mutex> lock(step_mutex);
+        step = 2;
+    }
+    step_cv.notify_all();
+
+    // The worker exits after the manager is gone; its cache must not flush into freed pools.
+    worker.join();
+
+    // A new manager may reuse the old address; it must get a fresh cache.
+    mcr::ThreadCachedSlabManager next;
+    void *ptr = next.Allocate(32);
+    ASSERT_NE(ptr, nullptr);
+    next.Free(ptr, 32, sizeof(void *));
+}
+
+TEST(ThreadCachedSlabManagerTest, StatsCountCallersAcrossThreadsAndSkipCachedBlocks)
+{
+    constexpr std::size_t kBlocksPerClass = 100;
+    mcr::ThreadCachedSlabManager manager(kBlocksPerClass);
+    const std::size_t class_idx = mcr::SizeClassPolicy::ClassIndex(64);
+
+    std::vector<void *> mine;
+    for (int i = 0; i < 3; i++)
+    {
+        mine.push_back(manager.Allocate(64));
+    }
+
+    // The exiting worker's counts are folded into the shared class; one of its blocks is freed here.
+    void *handed_over = nullptr;
+    std::thread worker([&manager, &handed_over]
+                       {
+        std::vector<void *> ptrs;
+        for (int i = 0; i < 5; i++)
+        {
+            ptrs.push_back(manager.Allocate(64));
+        }
+        manager.Free(ptrs[0], 64, sizeof(void *));
+        manager.Free(ptrs[1], 64, sizeof(void *));
+        handed_over = ptrs[2]; });
+    worker.join();
+    manager.Free(handed_over, 64, sizeof(void *));
+
+    while (manager.Allocate(1024))
+    {
+    }
+
+    const mcr::SlabManagerStats stats = manager.GetStats();
+    const mcr::SlabStats &cls = stats.classes[class_idx];
+    const mcr::SlabStats &largest = stats.classes[mcr::SizeClassPolicy::kNumClasses - 1];
+    EXPECT_EQ(cls.block_size, 64);
+    EXPECT_EQ(cls.capacity, kBlocksPerClass);
+    if (mcr::kStatsEnabled)
+    {
+        EXPECT_EQ(cls.in_use, 5); // Blocks refilled into both caches but never handed out do not count.
+        EXPECT_EQ(cls.total_allocations, 8);
+        EXPECT_GE(cls.peak_in_use, 5);
+        EXPECT_LE(cls.peak_in_use, kBlocksPerClass);
+        EXPECT_EQ(largest.in_use, kBlocksPerClass);
+        EXPECT_EQ(largest.failed_allocations, 1);
+    }
+    else
+    {
+        EXPECT_EQ(cls.in_use, 0);
+        EXPECT_EQ(cls.total_allocations, 0);
+    }
+}
@@ -0,0 +1,288 @@
+// Replays an allocation trace against several allocator configurations and reports throughput and peak memory.
+//
+// Usage:
+//   mcr_trace_replay <trace-file> [iterations]
+//   mcr_trace_replay --synthesize <trace-file> [events]
+//
+// Each configuration runs in a forked child so its peak RSS (`ru_maxrss`) is measured in isolation;
+// the reported value is the child's peak minus that of a child that replays nothing.
+
+#include <allocation_trace.h>
+#include <per_cpu_slab_manager.h>
+#include <slab_manager.h>
+#include <thread_cached_slab_manager.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    struct ReplayResult
+    {
+        double seconds = 0.0;
+        std::size_t failures = 0;
+    };
+
+    /**
+     * @brief Replay `iterations` times through one configuration built inside the measured process.
+     */
+    using Runner = std::function<ReplayResult(const mcr::ReplayPlan &, int)>;
+
+    template <typename Manager>
+    ReplayResult ReplayThrough(Manager &manager, const mcr::ReplayPlan &plan, int iterations)
+    {
+        std::vector<void *> table;
+        ReplayResult result;
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            result.failures += mcr::ReplayTrace(
+                plan, table,
+                [&manager](std::size_t size, std::size_t alignment)
+                {
+                    // Write each object once, as the traced program would, so peak RSS counts the pages it commits.
+                    void *ptr = manager.Allocate(size, alignment);
+                    if (ptr)
+                    {
+                        std::memset(ptr, 0, size);
+                    }
+                    return ptr;
+                },
+                [&manager](void *ptr, std::size_t size, std::size_t alignment)
+                { manager.Free(ptr, size, alignment); });
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    /**
+     * @brief Slab configuration that can hold realistic traces: geometric growth and a large-object region.
+     */
+    mcr::SlabManagerConfig GrowingConfig()
+    {
+        mcr::SlabManagerConfig config;
+        config.growth = mcr::SlabGrowth::kGeometric;
+        config.max_blocks_per_class = std::size_t{1} << 20;
+        config.large_region_size = std::size_t{256} << 20;
+        config.max_large_block_size = std::size_t{64} << 20;
+        return config;
+    }
+
+    struct Configuration
+    {
+        const char *name;
+        Runner run;
+    };
+
+    std::vector<Configuration> Configurations()
+    {
+        return {
+            {"baseline", [](const mcr::ReplayPlan &, int)
+             { return ReplayResult{}; }},
+            {"malloc", [](const mcr::ReplayPlan &plan, int iterations)
+             {
+                 struct Malloc
+                 {
+                     void *Allocate(std::size_t size, std::size_t alignment)
+                     {
+                         return (alignment <= alignof(std::max_align_t)) ? std::malloc(size) : std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+                     }
+                     void Free(void *ptr, std::size_t, std::size_t) { std::free(ptr); }
+                 } manager;
+                 return ReplayThrough(manager, plan, iterations);
+             }},
+            {"slab-default", [](const mcr::ReplayPlan &plan, int iterations)
+             {
+                 mcr::SlabManager manager;
+                 return ReplayThrough(manager, plan, iterations);
+             }},
+            {"slab-growing", [](const mcr::ReplayPlan &plan, int iterations)
+             {
+                 mcr::SlabManager manager(GrowingConfig());
+                 return ReplayThrough(manager, plan, iterations);
+             }},
+            {"slab-arena", [](const mcr::ReplayPlan &plan, int iterations)
+             {
+                 mcr::SlabManagerConfig config = GrowingConfig();
+                 config.max_blocks_per_class = std::size_t{1} << 16; // Arena spans reserve the full bound up front.
+                 config.contiguous_arena = true;
+                 mcr::SlabManager manager(config);
+                 return ReplayThrough(manager, plan, iterations);
+             }},
+            {"thread-cached", [](const mcr::ReplayPlan &plan, int iterations)
+             {
+                 mcr::ThreadCachedSlabManager manager(GrowingConfig());
+                 return ReplayThrough(manager, plan, iterations);
+             }},
+            {"per-cpu", [](const mcr::ReplayPlan &plan, int iterations)
+             {
+                 mcr::PerCpuSlabManager manager(GrowingConfig());
+                 return ReplayThrough(manager, plan, iterations);
+             }},
+        };
+    }
+
+    struct Measurement
+    {
+        ReplayResult result;
+        long peak_rss_kib = 0;
+        bool ok = false;
+    };
+
+    Measurement Measure(const Configuration &configuration, const mcr::ReplayPlan &plan, int iterations)
+    {
+        Measurement measurement;
+#if !defined(_WIN32) && !defined(_WIN64)
+        int fds[2];
+        if (pipe(fds) != 0)
+        {
+            return measurement;
+        }
+        const pid_t child = fork();
+        if (child == 0)
+        {
+            close(fds[0]);
+            ReplayResult result{};
+            try
+            {
+                result = configuration.run(plan, iterations);
+            }
+            catch (const std::exception &error)
+            {
+                std::fprintf(stderr, "%s: %s\n", configuration.name, error.what());
+                _exit(1);
+            }
+            const ssize_t written = write(fds[1], &result, sizeof(result));
+            _exit(written == static_cast<ssize_t>(sizeof(result)) ? 0 : 1);
+        }
+        close(fds[1]);
+        if (child < 0)
+        {
+            close(fds[0]);
+            return measurement;
+        }
+
+        const ssize_t received = read(fds[0], &measurement.result, sizeof(measurement.result));
+        close(fds[0]);
+        int status = 0;
+        rusage usage{};
+        wait4(child, &status, 0, &usage);
+        measurement.peak_rss_kib = usage.ru_maxrss;
+        measurement.ok = received == static_cast<ssize_t>(sizeof(measurement.result)) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#else
+        // No fork: run in-process; peak memory is not reported.
+        measurement.result = configuration.run(plan, iterations);
+        measurement.ok = true;
+#endif
+        return measurement;
+    }
+
+    /**
+     * @brief Game-like synthetic trace: mostly small short-lived objects, some long-lived ones, rare large buffers.
+     */
+    std::vector<mcr::TraceEvent> Synthesize(std::size_t event_count)
+    {
+        std::mt19937_64 rng(42);
+        std::uniform_int_distribution<int> percent(0, 99);
+        std::uniform_int_distribution<std::uint32_t> small(8, 256);
+        std::uniform_int_distribution<std::uint32_t> medium(257, 1024);
+        std::uniform_int_distribution<std::uint32_t> large(4096, 256 << 10);
+
+        std::vector<mcr::TraceEvent> events;
+        std::vector<mcr::TraceEvent> live;
+        std::uint64_t next_address = 0x1000;
+        while (events.size() < event_count)
+        {
+            const bool allocate = live.empty() || (live.size() < 4096 && percent(rng) < 55);
+            if (allocate)
+            {
+                const int kind = percent(rng);
+                mcr::TraceEvent event{};
+                event.address = next_address;
+                event.size = (kind < 80) ? small(rng) : (kind < 98) ? medium(rng) : large(rng);
+                event.alignment_log2 = 3;
+                event.op = mcr::TraceOp::kAllocate;
+                next_address += 0x10000;
+                events.push_back(event);
+                live.push_back(event);
+                continue;
+            }
+
+            // Free the newest object most of the time (LIFO-ish), otherwise a random one.
+            std::size_t index = live.size() - 1;
+            if (percent(rng) < 30)
+            {
+                index = std::uniform_int_distribution<std::size_t>(0, live.size() - 1)(rng);
+            }
+            mcr::TraceEvent event = live[index];
+            event.op = mcr::TraceOp::kFree;
+            events.push_back(event);
+            live[index] = live.back();
+            live.pop_back();
+        }
+        return events;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        if (argc >= 3 && std::string(argv[1]) == "--synthesize")
+        {
+            const std::size_t event_count = (argc >= 4) ? std::strtoull(argv[3], nullptr, 10) : 1000000;
+            mcr::WriteTraceFile(argv[2], Synthesize(event_count));
+            std::printf("wrote %zu events to %s\n", event_count, argv[2]);
+            return 0;
+        }
+        if (argc < 2)
+        {
+            std::fprintf(stderr, "usage: %s <trace-file> [iterations]\n       %s --synthesize <trace-file> [events]\n", argv[0], argv[0]);
+            return 2;
+        }
+
+        const int iterations = (argc >= 3) ? std::max(1, std::atoi(argv[2])) : 5;
+        const mcr::ReplayPlan plan = mcr::BuildReplayPlan(mcr::ReadTraceFile(argv[1]));
+        std::printf("%zu ops, peak %zu live objects, peak %zu live KiB, %d iterations\n\n", plan.ops.size(), plan.slot_count, plan.peak_live_bytes >> 10, iterations);
+        std::printf("%-14s %14s %16s %10s\n", "config", "Mops/s", "peak RSS KiB", "failures");
+
+        long baseline_rss = 0;
+        for (const Configuration &configuration : Configurations())
+        {
+            const Measurement measurement = Measure(configuration, plan, iterations);
+            if (!measurement.ok)
+            {
+                std::printf("%-14s %14s\n", configuration.name, "failed");
+                continue;
+            }
+            if (std::string(configuration.name) == "baseline")
+            {
+                baseline_rss = measurement.peak_rss_kib;
+                continue;
+            }
+            const double ops = static_cast<double>(plan.ops.size()) * iterations;
+            std::printf("%-14s %14.1f %16ld %10zu\n", configuration.name, ops / measurement.result.seconds / 1e6,
+                        measurement.peak_rss_kib - baseline_rss, measurement.result.failures / static_cast<std::size_t>(iterations));
+        }
+        return 0;
+    }
+    catch (const std::exception &error)
+    {
+        std::fprintf(stderr, "error: %s\n", error.what());
+        return 1;
+    }
+}